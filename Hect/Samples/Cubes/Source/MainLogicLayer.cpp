@@ -39,8 +39,8 @@ MainLogicLayer::MainLogicLayer(AssetCache& assetCache, InputSystem& inputSystem,
     _scene.addSystem(_physicsSystem);
     _scene.addSystem(_playerCameraSystem);
 
-    DataValue& sceneDataValue = assetCache.get<DataValue>("Scene.scene");
-    _scene.load(sceneDataValue, assetCache);
+    DataDocument& sceneDocument = assetCache.get<DataDocument>("Scene.scene");
+    _scene.load(sceneDocument.root(), assetCache);
 
     Dispatcher<KeyboardEvent>& keyboardDispatcher = _input->keyboard().dispatcher();
     keyboardDispatcher.addListener(*this);
@@ -25,17 +25,604 @@
 
 using namespace hect;
 
+AssetCache::Statistics::Statistics() :
+    memoryUsage(0),
+    evictionCount(0),
+    reloadCount(0)
+{
+}
+
+AssetCache::ProfileFrame::ProfileFrame() :
+    childBytesRead(0)
+{
+}
+
 AssetCache::AssetCache(FileSystem& fileSystem) :
-    _fileSystem(fileSystem)
+    _fileSystem(fileSystem),
+    _taskPool(nullptr),
+    _memoryBudget(0),
+    _nextAccessTime(0),
+    _recording(false),
+    _hotReloadEnabled(false),
+    _profiling(false)
+{
+}
+
+AssetCache::AssetCache(FileSystem& fileSystem, TaskPool& taskPool) :
+    _fileSystem(fileSystem),
+    _taskPool(&taskPool),
+    _memoryBudget(0),
+    _nextAccessTime(0),
+    _recording(false),
+    _hotReloadEnabled(false),
+    _profiling(false)
+{
+}
+
+void AssetCache::enqueueFinalization(TaskFunction action)
+{
+    // Attribute the action to the asset being loaded on this thread
+    Path path;
+    if (_profiling.load(std::memory_order_relaxed))
+    {
+        std::unique_lock<std::mutex> lock(_profilingMutex);
+        auto it = _profileFrames.find(std::this_thread::get_id());
+        if (it != _profileFrames.end() && !it->second.empty())
+        {
+            path = it->second.back().path;
+        }
+    }
+
+    _enqueueFinalization(std::move(action), path);
+}
+
+size_t AssetCache::finalizeLoads(TimeSpan budget)
+{
+    size_t executedCount = 0;
+    try
+    {
+        executedCount = _finalizationQueue.execute(budget);
+    }
+    catch (...)
+    {
+        // Enforce the memory budget even if an action fails
+        trim();
+        throw;
+    }
+
+    trim();
+    return executedCount;
+}
+
+void AssetCache::setMemoryBudget(size_t memoryBudget)
+{
+    _memoryBudget = memoryBudget;
+}
+
+size_t AssetCache::memoryBudget() const
+{
+    return _memoryBudget;
+}
+
+size_t AssetCache::trim()
+{
+    size_t memoryBudget = _memoryBudget;
+    if (memoryBudget == 0 || statistics().memoryUsage <= memoryBudget)
+    {
+        return 0;
+    }
+
+    // Find the entries which are only referenced by the cache
+    struct Candidate
+    {
+        uint64_t lastAccessTime;
+        Shard* shard;
+        Path path;
+    };
+
+    std::vector<Candidate> candidates;
+    for (Shard& shard : _shards)
+    {
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        for (auto& pair : shard.entries)
+        {
+            if (pair.second.use_count() == 1)
+            {
+                Candidate candidate;
+                candidate.lastAccessTime = pair.second->lastAccessTime();
+                candidate.shard = &shard;
+                candidate.path = pair.first;
+                candidates.push_back(candidate);
+            }
+        }
+    }
+
+    // Evict the least recently used first
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+    {
+        return a.lastAccessTime < b.lastAccessTime;
+    });
+
+    size_t freedMemory = 0;
+    for (const Candidate& candidate : candidates)
+    {
+        if (statistics().memoryUsage <= memoryBudget)
+        {
+            break;
+        }
+
+        // The entry may have been requested since it was found
+        std::unique_lock<std::mutex> lock(candidate.shard->mutex);
+        auto it = candidate.shard->entries.find(candidate.path);
+        if (it != candidate.shard->entries.end() && it->second.use_count() == 1)
+        {
+            size_t memorySize = it->second->evict();
+            if (memorySize > 0)
+            {
+                freedMemory += memorySize;
+
+                std::unique_lock<std::mutex> statisticsLock(_statisticsMutex);
+                ++_statistics.evictionCount;
+            }
+        }
+    }
+
+    return freedMemory;
+}
+
+AssetCache::Statistics AssetCache::statistics() const
 {
+    std::unique_lock<std::mutex> lock(_statisticsMutex);
+    return _statistics;
+}
+
+void AssetCache::startRecording()
+{
+    std::unique_lock<std::mutex> lock(_recordingMutex);
+    _manifest = AssetManifest();
+    _recording = true;
+}
+
+AssetManifest AssetCache::stopRecording()
+{
+    std::unique_lock<std::mutex> lock(_recordingMutex);
+    _recording = false;
+
+    AssetManifest manifest;
+    std::swap(manifest, _manifest);
+    return manifest;
+}
+
+size_t AssetCache::prefetch(const AssetManifest& manifest)
+{
+    // Find the prefetch function for each asset
+    std::vector<std::pair<Path, PrefetchFunction>> prefetches;
+    {
+        std::unique_lock<std::mutex> lock(_recordingMutex);
+        for (const AssetManifest::Entry* entry : manifest.loadOrder())
+        {
+            auto it = _prefetchFunctions.find(entry->typeName);
+            if (it != _prefetchFunctions.end())
+            {
+                prefetches.push_back(std::make_pair(entry->path, it->second));
+            }
+            else
+            {
+                LOG_WARNING(format("Cannot prefetch asset '%s' of unregistered type '%s'", entry->path.toString().c_str(), entry->typeName.c_str()));
+            }
+        }
+    }
+
+    for (auto& prefetch : prefetches)
+    {
+        prefetch.second(*this, prefetch.first);
+    }
+
+    return prefetches.size();
+}
+
+void AssetCache::startProfiling()
+{
+    std::unique_lock<std::mutex> lock(_profilingMutex);
+    _profile = AssetLoadProfile();
+    _profileFrames.clear();
+    _profiling = true;
+
+    _fileSystem.setReadTimingEnabled(true);
+}
+
+AssetLoadProfile AssetCache::stopProfiling()
+{
+    std::unique_lock<std::mutex> lock(_profilingMutex);
+    _profiling = false;
+    _profileFrames.clear();
+
+    _fileSystem.setReadTimingEnabled(false);
+
+    AssetLoadProfile profile;
+    std::swap(profile, _profile);
+    return profile;
+}
+
+void AssetCache::setHotReloadEnabled(bool enabled)
+{
+    std::unique_lock<std::mutex> lock(_recordingMutex);
+    _hotReloadEnabled = enabled;
+
+    if (!enabled)
+    {
+        _modifiedTimes.clear();
+        _dependents.clear();
+    }
+}
+
+size_t AssetCache::reloadChanged()
+{
+    std::unordered_map<Path, int64_t> modifiedTimes;
+    {
+        std::unique_lock<std::mutex> lock(_recordingMutex);
+        modifiedTimes = _modifiedTimes;
+    }
+
+    // Query the file system without holding the lock
+    std::vector<std::pair<Path, int64_t>> changes;
+    for (auto& pair : modifiedTimes)
+    {
+        int64_t modifiedTime = _fileSystem.lastModifiedTime(pair.first);
+        if (modifiedTime != pair.second)
+        {
+            changes.push_back(std::make_pair(pair.first, modifiedTime));
+        }
+    }
+
+    if (changes.empty())
+    {
+        return 0;
+    }
+
+    std::vector<Path> changedPaths;
+    {
+        std::unique_lock<std::mutex> lock(_recordingMutex);
+        for (auto& change : changes)
+        {
+            // The asset may have been reloaded since the time was queried
+            auto it = _modifiedTimes.find(change.first);
+            if (it != _modifiedTimes.end() && it->second != change.second)
+            {
+                it->second = change.second;
+                changedPaths.push_back(change.first);
+            }
+        }
+    }
+
+    return _reload(changedPaths);
+}
+
+size_t AssetCache::reload(const Path& path)
+{
+    return _reload(std::vector<Path>(1, path));
 }
 
 void AssetCache::clear()
 {
-    _entries.clear();
+    for (Shard& shard : _shards)
+    {
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
 }
 
 FileSystem& AssetCache::fileSystem()
 {
     return _fileSystem;
 }
+
+TaskPool* AssetCache::taskPool()
+{
+    return _taskPool;
+}
+
+void AssetCache::_addMemoryUsage(const char* typeName, size_t memorySize, bool reload)
+{
+    std::unique_lock<std::mutex> lock(_statisticsMutex);
+    _statistics.memoryUsage += memorySize;
+    _statistics.memoryUsageByType[typeName] += memorySize;
+
+    if (reload)
+    {
+        ++_statistics.reloadCount;
+    }
+}
+
+void AssetCache::_removeMemoryUsage(const char* typeName, size_t memorySize)
+{
+    std::unique_lock<std::mutex> lock(_statisticsMutex);
+    _statistics.memoryUsage -= memorySize;
+    _statistics.memoryUsageByType[typeName] -= memorySize;
+}
+
+void AssetCache::_registerAssetType(const char* typeId, const std::string& typeName, PrefetchFunction prefetchFunction)
+{
+    std::unique_lock<std::mutex> lock(_recordingMutex);
+
+    if (_prefetchFunctions.find(typeName) != _prefetchFunctions.end())
+    {
+        throw Error(format("Asset type '%s' is already registered", typeName.c_str()));
+    }
+
+    _assetTypeNames[typeId] = typeName;
+    _prefetchFunctions[typeName] = prefetchFunction;
+}
+
+void AssetCache::_recordRequest(const Path& path, const char* typeId)
+{
+    std::unique_lock<std::mutex> lock(_recordingMutex);
+
+    // The asset is a dependency of the asset being loaded on this thread
+    const Path* requestingPath = nullptr;
+    auto loadingPaths = _loadingPaths.find(std::this_thread::get_id());
+    if (loadingPaths != _loadingPaths.end() && !loadingPaths->second.empty() && loadingPaths->second.back() != path)
+    {
+        requestingPath = &loadingPaths->second.back();
+    }
+
+    if (_recording)
+    {
+        // Record the asset by its registered type name if it has one
+        auto it = _assetTypeNames.find(typeId);
+        _manifest.addAsset(path, it != _assetTypeNames.end() ? it->second : std::string(typeId));
+
+        if (requestingPath)
+        {
+            _manifest.addDependency(*requestingPath, path);
+        }
+    }
+
+    if (_hotReloadEnabled && requestingPath)
+    {
+        std::vector<Path>& dependents = _dependents[path];
+        if (std::find(dependents.begin(), dependents.end(), *requestingPath) == dependents.end())
+        {
+            dependents.push_back(*requestingPath);
+        }
+    }
+}
+
+Path AssetCache::_profiledLoadingPath(const Path& path)
+{
+    std::unique_lock<std::mutex> lock(_profilingMutex);
+
+    // The asset being loaded on this thread is requesting the asset
+    auto it = _profileFrames.find(std::this_thread::get_id());
+    if (it != _profileFrames.end() && !it->second.empty() && it->second.back().path != path)
+    {
+        return it->second.back().path;
+    }
+
+    return Path();
+}
+
+void AssetCache::_beginLoad(const Path& path, const Path& parentPath)
+{
+    bool hotReloadEnabled = _hotReloadEnabled.load(std::memory_order_relaxed);
+    if (_recording.load(std::memory_order_relaxed) || hotReloadEnabled)
+    {
+        // Query the file system without holding the lock
+        int64_t modifiedTime = hotReloadEnabled ? _fileSystem.lastModifiedTime(path) : -1;
+
+        std::unique_lock<std::mutex> lock(_recordingMutex);
+        if (_recording || _hotReloadEnabled)
+        {
+            _loadingPaths[std::this_thread::get_id()].push_back(path);
+        }
+
+        // Only assets loaded from a file are reloaded when changed
+        if (_hotReloadEnabled && modifiedTime >= 0)
+        {
+            _modifiedTimes[path] = modifiedTime;
+        }
+    }
+
+    if (_profiling.load(std::memory_order_relaxed))
+    {
+        std::unique_lock<std::mutex> lock(_profilingMutex);
+        if (_profiling)
+        {
+            ProfileFrame frame;
+            frame.path = path;
+            frame.parentPath = parentPath;
+            frame.readStatistics = _fileSystem.threadReadStatistics();
+
+            std::vector<ProfileFrame>& frames = _profileFrames[std::this_thread::get_id()];
+            frames.push_back(frame);
+            frames.back().timer.reset();
+        }
+    }
+}
+
+void AssetCache::_endLoad(const Path& path, const char* typeId, size_t memorySize, bool failed)
+{
+    if (_recording.load(std::memory_order_relaxed) || _hotReloadEnabled.load(std::memory_order_relaxed))
+    {
+        std::unique_lock<std::mutex> lock(_recordingMutex);
+
+        // The load may have begun before recording started
+        auto it = _loadingPaths.find(std::this_thread::get_id());
+        if (it != _loadingPaths.end() && !it->second.empty() && it->second.back() == path)
+        {
+            it->second.pop_back();
+        }
+    }
+
+    if (_profiling.load(std::memory_order_relaxed))
+    {
+        std::unique_lock<std::mutex> lock(_profilingMutex);
+
+        // The load may have begun before profiling started
+        auto it = _profileFrames.find(std::this_thread::get_id());
+        if (it == _profileFrames.end() || it->second.empty() || it->second.back().path != path)
+        {
+            return;
+        }
+
+        ProfileFrame frame = it->second.back();
+        it->second.pop_back();
+
+        TimeSpan totalTime = frame.timer.elapsed();
+        FileSystem::ReadStatistics readStatistics = _fileSystem.threadReadStatistics();
+        TimeSpan readTime = readStatistics.readTime - frame.readStatistics.readTime;
+        size_t bytesRead = readStatistics.bytesRead - frame.readStatistics.bytesRead;
+
+        AssetLoadProfile::Load load;
+        load.path = path;
+        load.parentPath = frame.parentPath;
+        load.typeName = _typeName(typeId);
+        load.totalTime = totalTime;
+        load.readTime = readTime - frame.childReadTime;
+        load.decodeTime = totalTime - frame.childTime - load.readTime;
+        load.bytesRead = bytesRead - frame.childBytesRead;
+        load.memorySize = memorySize;
+        load.failed = failed;
+
+        // The time of a load excludes the loads nested within it on the
+        // same thread (its dependencies or unrelated loads executed while
+        // waiting for them), whichever asset requested them
+        if (!it->second.empty())
+        {
+            ProfileFrame& enclosing = it->second.back();
+            enclosing.childTime += totalTime;
+            enclosing.childReadTime += readTime;
+            enclosing.childBytesRead += bytesRead;
+        }
+
+        _profile.addLoad(load);
+    }
+}
+
+void AssetCache::_enqueueFinalization(TaskFunction action, const Path& path)
+{
+    if (_profiling.load(std::memory_order_relaxed) && path != Path())
+    {
+        // Measure the action for the profile
+        std::shared_ptr<TaskFunction> sharedAction = std::make_shared<TaskFunction>(std::move(action));
+        _finalizationQueue.enqueue([this, sharedAction, path]
+        {
+            Timer timer;
+            (*sharedAction)();
+            _addFinalizeTime(path, timer.elapsed());
+        });
+    }
+    else
+    {
+        _finalizationQueue.enqueue(std::move(action));
+    }
+}
+
+void AssetCache::_addFinalizeTime(const Path& path, TimeSpan time)
+{
+    std::unique_lock<std::mutex> lock(_profilingMutex);
+    if (_profiling)
+    {
+        _profile.addFinalizeTime(path, time);
+    }
+}
+
+std::string AssetCache::_typeName(const char* typeId)
+{
+    std::unique_lock<std::mutex> lock(_recordingMutex);
+
+    // Use the registered name of the type if it has one
+    auto it = _assetTypeNames.find(typeId);
+    return it != _assetTypeNames.end() ? it->second : std::string(typeId);
+}
+
+size_t AssetCache::_reload(const std::vector<Path>& paths)
+{
+    // Order the assets so each comes after the assets it depends on
+    std::vector<Path> reloadOrder;
+    {
+        std::unique_lock<std::mutex> lock(_recordingMutex);
+
+        std::set<Path> visited;
+        for (const Path& path : paths)
+        {
+            _addDependents(path, visited, reloadOrder);
+        }
+    }
+    std::reverse(reloadOrder.begin(), reloadOrder.end());
+
+    std::vector<std::shared_ptr<AssetEntryBase>> entries;
+    for (const Path& path : reloadOrder)
+    {
+        Shard& shard = _shardFor(path);
+        std::unique_lock<std::mutex> lock(shard.mutex);
+
+        auto it = shard.entries.find(path);
+        if (it != shard.entries.end())
+        {
+            entries.push_back(it->second);
+        }
+    }
+
+    if (entries.empty())
+    {
+        return 0;
+    }
+
+    // The entries are kept alive (and cannot be evicted) until reloaded
+    TaskFunction reloadEntries([this, entries]
+    {
+        std::shared_ptr<std::vector<std::shared_ptr<void>>> previousAssets(new std::vector<std::shared_ptr<void>>());
+        for (const std::shared_ptr<AssetEntryBase>& entry : entries)
+        {
+            std::shared_ptr<void> previousAsset;
+            if (entry->reload(previousAsset))
+            {
+                previousAssets->push_back(previousAsset);
+            }
+        }
+
+        // Release the previous versions on the thread finalizing loads
+        enqueueFinalization([previousAssets]
+        {
+            previousAssets->clear();
+        });
+    });
+
+    if (_taskPool)
+    {
+        _taskPool->enqueue(std::move(reloadEntries), TaskPriority::Low);
+    }
+    else
+    {
+        reloadEntries();
+    }
+
+    return entries.size();
+}
+
+void AssetCache::_addDependents(const Path& path, std::set<Path>& visited, std::vector<Path>& reloadOrder)
+{
+    if (!visited.insert(path).second)
+    {
+        return;
+    }
+
+    // Add the dependents before the asset so the reversed order has each
+    // asset before its dependents
+    auto it = _dependents.find(path);
+    if (it != _dependents.end())
+    {
+        for (const Path& dependent : it->second)
+        {
+            _addDependents(dependent, visited, reloadOrder);
+        }
+    }
+    reloadOrder.push_back(path);
+}
+
+AssetCache::Shard& AssetCache::_shardFor(const Path& path)
+{
+    // Use the high bits so the shards are independent of the buckets
+    return _shards[(path.hash() >> 32) % _shardCount];
+}
@@ -28,17 +28,68 @@ namespace hect
 
 ///
 /// Provides cached access to assets loaded from the file system.
+///
+/// \remarks An asset cache may be used from any number of threads.  The
+/// entries are split into shards by the hash of their path, each with its
+/// own lock, and concurrent requests for the same asset share one load.
+///
+/// If a memory budget is set then the least recently requested assets
+/// which are not pinned or referenced outside of the cache are unloaded
+/// whenever the cache is trimmed until the memory used is within the budget.
+/// Evicted assets are loaded again when requested.
+///
+/// While recording, the cache records the assets requested and the assets
+/// requested while loading each asset in an asset manifest.  Prefetching the
+/// assets in a recorded manifest on a later run loads them in parallel before
+/// they are requested.
 class AssetCache :
     public Uncopyable
 {
+    template <typename T>
+    friend class AssetEntry;
 public:
 
+    ///
+    /// Statistics of an asset cache.
+    struct Statistics
+    {
+        Statistics();
+
+        ///
+        /// The approximate number of bytes of memory used by loaded assets.
+        size_t memoryUsage;
+
+        ///
+        /// The approximate number of bytes of memory used by loaded assets
+        /// of each type (by type name).
+        std::map<std::string, size_t> memoryUsageByType;
+
+        ///
+        /// The number of assets evicted.
+        uint64_t evictionCount;
+
+        ///
+        /// The number of assets loaded again after being evicted.
+        uint64_t reloadCount;
+    };
+
     ///
     /// Constructs an asset cache given a file system.
     ///
+    /// \remarks Assets loaded asynchronously are loaded on the calling
+    /// thread.
+    ///
     /// \param fileSystem The file system.
     AssetCache(FileSystem& fileSystem);
 
+    ///
+    /// Constructs an asset cache given a file system and a task pool to load
+    /// assets asynchronously in.
+    ///
+    /// \param fileSystem The file system.
+    /// \param taskPool The task pool.
+    AssetCache(FileSystem& fileSystem, TaskPool& taskPool);
+
     ///
     /// Returns a reference to the asset at the given path.
     ///
@@ -61,6 +112,152 @@ public:
     template <typename T>
     AssetHandle<T> getHandle(const Path& path);
 
+    ///
+    /// Returns a handle for the asset at the given path and starts loading
+    /// the asset asynchronously if it is not loaded or loading.
+    ///
+    /// \param path The case-sensitive path to the asset.
+    ///
+    /// \throws Error If the asset at the given path is of a different type.
+    template <typename T>
+    AssetHandle<T> loadAsync(const Path& path);
+
+    ///
+    /// Enqueues an action which must be executed on the thread finalizing
+    /// loads (e.g. uploading an asset to the GPU).
+    ///
+    /// \remarks May be called from any thread, including from an asset
+    /// loader.
+    ///
+    /// \param action The action to execute.
+    void enqueueFinalization(TaskFunction action);
+
+    ///
+    /// Executes the enqueued finalization actions (including the actions
+    /// waiting for assets to load) until a time budget is spent.
+    ///
+    /// \remarks Intended to be called once per frame on the main thread.
+    /// The cache is trimmed afterwards.
+    ///
+    /// \param budget The maximum time to spend finalizing.
+    ///
+    /// \returns The number of actions executed.
+    ///
+    /// \throws Error If an error occurs in an action (the cache is still
+    /// trimmed and the remaining actions are executed on the next call).
+    size_t finalizeLoads(TimeSpan budget);
+
+    ///
+    /// Sets the number of bytes of memory loaded assets may use before
+    /// they are evicted.
+    ///
+    /// \param memoryBudget The memory budget in bytes (zero for no budget).
+    void setMemoryBudget(size_t memoryBudget);
+
+    ///
+    /// Returns the memory budget in bytes (zero if there is no budget).
+    size_t memoryBudget() const;
+
+    ///
+    /// Evicts the least recently requested assets which can be evicted
+    /// until the memory used is within the budget.
+    ///
+    /// \warning References returned from get() for an evicted asset are no
+    /// longer valid; hold an asset handle or shared pointer to keep an asset
+    /// from being evicted.
+    ///
+    /// \returns The number of bytes of memory freed.
+    size_t trim();
+
+    ///
+    /// Returns the statistics of the cache.
+    Statistics statistics() const;
+
+    ///
+    /// Registers an asset type so assets of the type can be recorded by name
+    /// and prefetched.
+    ///
+    /// \param typeName The name of the type.
+    ///
+    /// \throws Error If a type is already registered with the name.
+    template <typename T>
+    void registerAssetType(const std::string& typeName);
+
+    ///
+    /// Starts recording the requested assets and their dependencies.
+    ///
+    /// \remarks Any previously recorded manifest is discarded.
+    void startRecording();
+
+    ///
+    /// Stops recording and returns the recorded manifest.
+    AssetManifest stopRecording();
+
+    ///
+    /// Starts loading the assets in a manifest asynchronously, each after
+    /// the assets it depends on.
+    ///
+    /// \remarks Assets of types which are not registered are skipped.
+    /// Unless referenced, prefetched assets may be evicted when the cache
+    /// is trimmed.
+    ///
+    /// \param manifest The manifest.
+    ///
+    /// \returns The number of assets prefetched.
+    size_t prefetch(const AssetManifest& manifest);
+
+    ///
+    /// Starts profiling the loads of assets.
+    ///
+    /// \remarks Any previously recorded profile is discarded.  The files
+    /// read through the file system are measured while profiling (see
+    /// FileSystem::setReadTimingEnabled()).
+    void startProfiling();
+
+    ///
+    /// Stops profiling and returns the recorded profile.
+    AssetLoadProfile stopProfiling();
+
+    ///
+    /// Sets whether assets are tracked so they can be reloaded when their
+    /// files change.
+    ///
+    /// \remarks While enabled the modification time of the file of each
+    /// asset loaded and the assets requested while loading each asset are
+    /// recorded.  Only the assets loaded while enabled are reloaded when
+    /// changed.
+    ///
+    /// \param enabled Whether assets are tracked for hot reloading.
+    void setHotReloadEnabled(bool enabled);
+
+    ///
+    /// Reloads the assets whose files were modified since they were loaded
+    /// along with the assets which depend on them.
+    ///
+    /// \remarks Intended to be polled periodically while hot reloading is
+    /// enabled.  See reload().
+    ///
+    /// \returns The number of assets being reloaded (including the
+    /// dependents).
+    size_t reloadChanged();
+
+    ///
+    /// Reloads an asset along with the assets which depend on it.
+    ///
+    /// \remarks The assets are reloaded in the task pool if there is one
+    /// (otherwise on the calling thread), each after the assets it depends
+    /// on.  Each new version is swapped in place of the previous version so
+    /// existing handles see the new version.  The previous versions are
+    /// released on the thread finalizing loads once all of the assets are
+    /// reloaded.  An asset which fails to reload keeps its previous version.
+    /// Assets which are not loaded are skipped.
+    ///
+    /// \param path The path to the asset.
+    ///
+    /// \returns The number of assets being reloaded (including the
+    /// dependents).
+    size_t reload(const Path& path);
+
     ///
     /// Clears all cached resources.
     void clear();
@@ -69,10 +266,83 @@ public:
     /// Returns the file system.
     FileSystem& fileSystem();
 
+    ///
+    /// Returns the task pool assets are loaded asynchronously in (null if
+    /// there is none).
+    TaskPool* taskPool();
+
 private:
+    void _addMemoryUsage(const char* typeName, size_t memorySize, bool reload);
+    void _removeMemoryUsage(const char* typeName, size_t memorySize);
+
+    typedef std::function<void(AssetCache&, const Path&)> PrefetchFunction;
+
+    void _registerAssetType(const char* typeId, const std::string& typeName, PrefetchFunction prefetchFunction);
+    void _recordRequest(const Path& path, const char* typeId);
+    Path _profiledLoadingPath(const Path& path);
+    void _beginLoad(const Path& path, const Path& parentPath);
+    void _endLoad(const Path& path, const char* typeId, size_t memorySize, bool failed);
+    void _enqueueFinalization(TaskFunction action, const Path& path);
+    void _addFinalizeTime(const Path& path, TimeSpan time);
+    std::string _typeName(const char* typeId);
+    size_t _reload(const std::vector<Path>& paths);
+    void _addDependents(const Path& path, std::set<Path>& visited, std::vector<Path>& reloadOrder);
+
     FileSystem& _fileSystem;
+    TaskPool* _taskPool;
+
+    // Declared before the entries so they outlive them
+    mutable std::mutex _statisticsMutex;
+    Statistics _statistics;
+    std::atomic<size_t> _memoryBudget;
+    std::atomic<uint64_t> _nextAccessTime;
+
+    std::mutex _recordingMutex;
+    std::atomic<bool> _recording;
+    AssetManifest _manifest;
+    std::map<std::thread::id, std::vector<Path>> _loadingPaths;
+
+    // The modification time of the file of each asset and the assets
+    // which requested each asset while loading (while hot reloading)
+    std::atomic<bool> _hotReloadEnabled;
+    std::unordered_map<Path, int64_t> _modifiedTimes;
+    std::unordered_map<Path, std::vector<Path>> _dependents;
+
+    std::map<std::string, std::string> _assetTypeNames;
+    std::map<std::string, PrefetchFunction> _prefetchFunctions;
+
+    // A load in progress on a thread while profiling
+    struct ProfileFrame
+    {
+        ProfileFrame();
+
+        Path path;
+        Path parentPath;
+        Timer timer;
+        FileSystem::ReadStatistics readStatistics;
+        TimeSpan childTime;
+        TimeSpan childReadTime;
+        size_t childBytesRead;
+    };
+
+    std::mutex _profilingMutex;
+    std::atomic<bool> _profiling;
+    AssetLoadProfile _profile;
+    std::map<std::thread::id, std::vector<ProfileFrame>> _profileFrames;
+
+    static const size_t _shardCount = 16;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<Path, std::shared_ptr<AssetEntryBase>> entries;
+    };
+
+    Shard& _shardFor(const Path& path);
+
+    Shard _shards[_shardCount];
 
-    std::map<Path, std::shared_ptr<AssetEntryBase>> _entries;
+    ActionQueue _finalizationQueue;
 };
 
 }
@@ -35,14 +35,17 @@ AssetHandle<T> AssetCache::getHandle(const Path& path)
 {
     std::shared_ptr<AssetEntry<T>> entry;
 
-    auto it = _entries.find(path);
-    if (it == _entries.end())
+    Shard& shard = _shardFor(path);
+    std::unique_lock<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(path);
+    if (it == shard.entries.end())
     {
         // First time this asset was requested so create a new entry
         entry.reset(new AssetEntry<T>(*this, path));
 
         // Add the new entry to the entry map
-        _entries[path] = entry;
+        shard.entries[path] = entry;
     }
     else
     {
@@ -57,7 +60,39 @@ AssetHandle<T> AssetCache::getHandle(const Path& path)
         }
     }
 
+    entry->touch(_nextAccessTime++);
+    lock.unlock();
+
+    if (_recording.load(std::memory_order_relaxed) || _hotReloadEnabled.load(std::memory_order_relaxed))
+    {
+        _recordRequest(path, typeid(T).name());
+    }
+
+    if (_profiling.load(std::memory_order_relaxed))
+    {
+        // Record the requesting asset now since the asset may be loaded on
+        // a thread which is in the middle of loading an unrelated asset
+        entry->setRequestingPath(_profiledLoadingPath(path));
+    }
+
     return AssetHandle<T>(entry);
 }
 
+template <typename T>
+void AssetCache::registerAssetType(const std::string& typeName)
+{
+    _registerAssetType(typeid(T).name(), typeName, [](AssetCache& assetCache, const Path& path)
+    {
+        assetCache.loadAsync<T>(path);
+    });
+}
+
+template <typename T>
+AssetHandle<T> AssetCache::loadAsync(const Path& path)
+{
+    AssetHandle<T> handle = getHandle<T>(path);
+    handle._entry->loadAsync();
+    return handle;
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,352 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+namespace
+{
+
+void collectStrings(const DataValue& dataValue, std::vector<std::string>& strings)
+{
+    if (dataValue.isString())
+    {
+        strings.push_back(dataValue.asString());
+    }
+    else if (dataValue.isArray())
+    {
+        for (const DataValue& element : dataValue)
+        {
+            collectStrings(element, strings);
+        }
+    }
+    else if (dataValue.isObject())
+    {
+        for (const std::string& name : dataValue.memberNames())
+        {
+            collectStrings(dataValue[name], strings);
+        }
+    }
+}
+
+void loadDataValue(DataValue& dataValue, const std::vector<uint8_t>& source)
+{
+    if (source.size() >= sizeof(uint32_t))
+    {
+        MemoryReadStream stream(source);
+        if (stream.readUnsignedInt() == DataValueBinaryFormat::Signature)
+        {
+            DataValueBinaryFormat::load(dataValue, &source[0], source.size());
+            return;
+        }
+    }
+
+    std::string json(source.begin(), source.end());
+    DataValueJsonFormat::load(dataValue, json);
+}
+
+void cookDataValue(const Path& path, const std::vector<uint8_t>& source, std::vector<uint8_t>& cooked, std::vector<std::string>& references)
+{
+    path;
+
+    DataValue dataValue;
+    loadDataValue(dataValue, source);
+    collectStrings(dataValue, references);
+
+    MemoryWriteStream stream(cooked);
+    DataValueBinaryFormat::save(dataValue, stream);
+}
+
+void cookDataDocument(const Path& path, const std::vector<uint8_t>& source, std::vector<uint8_t>& cooked, std::vector<std::string>& references)
+{
+    path;
+
+    DataValue dataValue;
+    loadDataValue(dataValue, source);
+    collectStrings(dataValue, references);
+
+    DataDocument document(dataValue);
+    MemoryWriteStream stream(cooked);
+    document.save(stream);
+}
+
+void cookMesh(const Path& path, const std::vector<uint8_t>& source, std::vector<uint8_t>& cooked, std::vector<std::string>& references)
+{
+    references;
+
+    // Meshes already in the binary format are left as is
+    if (source.size() >= sizeof(uint32_t))
+    {
+        MemoryReadStream stream(source);
+        if (stream.readUnsignedInt() == MeshBinaryFormat::Signature)
+        {
+            cooked = source;
+            return;
+        }
+    }
+
+    DataValue dataValue;
+    loadDataValue(dataValue, source);
+
+    Mesh mesh;
+    MeshDataValueFormat::load(mesh, path.toString(), dataValue);
+
+    MemoryWriteStream stream(cooked);
+    MeshBinaryFormat::save(mesh, stream);
+}
+
+std::string formatHash(uint64_t hash)
+{
+    std::stringstream ss;
+    ss << std::hex << hash;
+    return ss.str();
+}
+
+uint64_t parseHash(const std::string& string)
+{
+    uint64_t hash = 0;
+    std::stringstream ss(string);
+    ss >> std::hex >> hash;
+    return hash;
+}
+
+}
+
+const char* const AssetCooker::ManifestPath = "Cook.manifest";
+
+AssetCooker::Result::Result() :
+    cookedCount(0),
+    copiedCount(0),
+    reusedCount(0)
+{
+}
+
+AssetCooker::AssetCooker(FileSystem& fileSystem, TaskPool& taskPool) :
+    _fileSystem(fileSystem),
+    _taskPool(taskPool)
+{
+    setCookFunction("mesh", cookMesh);
+    setCookFunction("entity", cookDataDocument);
+    setCookFunction("material", cookDataValue);
+    setCookFunction("shader", cookDataValue);
+    setCookFunction("texture", cookDataValue);
+    setCookFunction("scene", cookDataValue);
+}
+
+void AssetCooker::setCookFunction(const std::string& extension, CookFunction cookFunction)
+{
+    _cookFunctions[extension] = cookFunction;
+}
+
+AssetCooker::Result AssetCooker::cook(const Path& directory, PackFileWriter& writer, const PackFile* previousPack, bool compress)
+{
+    std::vector<File> files;
+    _findFiles(directory, files);
+
+    // Read the manifest of the previous cook
+    std::map<Path, PreviousFile> previousFiles;
+    if (previousPack && previousPack->contains(ManifestPath))
+    {
+        std::vector<uint8_t> buffer;
+        size_t size = 0;
+        const uint8_t* contents = previousPack->fileContents(ManifestPath, buffer, size);
+
+        DataValue manifest;
+        DataValueJsonFormat::load(manifest, std::string(contents, contents + size));
+
+        for (const DataValue& fileValue : manifest["files"])
+        {
+            PreviousFile previousFile;
+            previousFile.sourceHash = parseHash(fileValue["sourceHash"].asString());
+            for (const DataValue& reference : fileValue["references"])
+            {
+                previousFile.references.push_back(reference.asString());
+            }
+
+            previousFiles[fileValue["path"].asString()] = previousFile;
+        }
+    }
+
+    // Cook each file in its own task; each task only writes to its own file
+    std::vector<Task> tasks;
+    tasks.reserve(files.size());
+    for (File& file : files)
+    {
+        File* filePointer = &file;
+        tasks.push_back(_taskPool.enqueue([this, filePointer, &previousFiles, previousPack]
+        {
+            _cookFile(*filePointer, previousFiles, previousPack);
+        }));
+    }
+
+    for (Task& task : tasks)
+    {
+        task.wait();
+    }
+
+    // Validate the references against the extensions of the files cooked
+    std::set<std::string> extensions;
+    std::set<Path> paths;
+    for (const File& file : files)
+    {
+        extensions.insert(file.path.extension());
+        paths.insert(file.path);
+    }
+
+    Result result;
+    DataValue fileValues(DataValueType::Array);
+    for (File& file : files)
+    {
+        if (!file.error.empty())
+        {
+            result.errors.push_back(format("Failed to cook '%s': %s", file.path.toString().c_str(), file.error.c_str()));
+            continue;
+        }
+
+        DataValue references(DataValueType::Array);
+        for (const std::string& reference : file.references)
+        {
+            Path referencePath(reference);
+            if (extensions.find(referencePath.extension()) == extensions.end())
+            {
+                continue;
+            }
+
+            if (paths.find(referencePath) == paths.end() && !_fileSystem.exists(referencePath))
+            {
+                result.errors.push_back(format("'%s' references missing asset '%s'", file.path.toString().c_str(), reference.c_str()));
+            }
+
+            references.addElement(reference);
+        }
+
+        writer.addFile(file.path, file.data, compress);
+
+        DataValue fileValue(DataValueType::Object);
+        fileValue.addMember("path", file.path.toString());
+        fileValue.addMember("sourceHash", formatHash(file.sourceHash));
+        fileValue.addMember("references", references);
+        fileValues.addElement(fileValue);
+
+        if (file.reused)
+        {
+            ++result.reusedCount;
+        }
+        else if (file.cooked)
+        {
+            ++result.cookedCount;
+        }
+        else
+        {
+            ++result.copiedCount;
+        }
+    }
+
+    // Record the manifest for the next cook
+    DataValue manifest(DataValueType::Object);
+    manifest.addMember("files", fileValues);
+
+    std::string json;
+    DataValueJsonFormat::save(manifest, json);
+    writer.addFile(ManifestPath, std::vector<uint8_t>(json.begin(), json.end()), compress);
+
+    return result;
+}
+
+AssetCooker::File::File() :
+    sourceHash(0),
+    cooked(false),
+    reused(false)
+{
+}
+
+void AssetCooker::_findFiles(const Path& directory, std::vector<File>& files) const
+{
+    for (const Path& path : _fileSystem.directoryContents(directory))
+    {
+        if (_fileSystem.isDirectory(path))
+        {
+            _findFiles(path, files);
+        }
+        else if (path != ManifestPath)
+        {
+            File file;
+            file.path = path;
+            files.push_back(file);
+        }
+    }
+}
+
+void AssetCooker::_cookFile(File& file, const std::map<Path, PreviousFile>& previousFiles, const PackFile* previousPack) const
+{
+    try
+    {
+        std::vector<uint8_t> source;
+        {
+            FileReadStream stream = _fileSystem.openFileForRead(file.path);
+            source.resize(stream.length());
+            if (!source.empty())
+            {
+                stream.readBytes(&source[0], source.size());
+            }
+        }
+
+        // Include the cooker version so a new cooker invalidates old results
+        uint32_t version = _version;
+        file.sourceHash = hashBytes(reinterpret_cast<const uint8_t*>(&version), sizeof(version));
+        if (!source.empty())
+        {
+            file.sourceHash = hashBytes(&source[0], source.size(), file.sourceHash);
+        }
+
+        auto cookFunction = _cookFunctions.find(file.path.extension());
+        file.cooked = cookFunction != _cookFunctions.end();
+
+        // Reuse the cooked contents from the previous cook if the source has
+        // not changed since
+        auto previousFile = previousFiles.find(file.path);
+        if (previousFile != previousFiles.end() && previousFile->second.sourceHash == file.sourceHash && previousPack->contains(file.path))
+        {
+            std::vector<uint8_t> buffer;
+            size_t size = 0;
+            const uint8_t* contents = previousPack->fileContents(file.path, buffer, size);
+
+            file.data.assign(contents, contents + size);
+            file.references = previousFile->second.references;
+            file.reused = true;
+        }
+        else if (file.cooked)
+        {
+            cookFunction->second(file.path, source, file.data, file.references);
+        }
+        else
+        {
+            file.data.swap(source);
+        }
+    }
+    catch (Error& error)
+    {
+        file.error = error.what();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// Converts authored assets to the formats which load the fastest and
+/// writes them to a pack.
+///
+/// \remarks Each file with an extension which has a cook function is
+/// cooked and every other file is copied as is.  Cooked files keep their
+/// paths since the asset loaders detect the format of a file from its
+/// contents.  By default meshes are cooked to the binary mesh format,
+/// entities to data documents, and materials, shaders, textures, and scenes
+/// to the binary data value format.
+///
+/// Files are cooked in parallel.  The hash of the contents of each file is
+/// recorded in the pack so a later cook can reuse the cooked contents of
+/// the files which have not changed.
+class AssetCooker :
+    public Uncopyable
+{
+public:
+
+    ///
+    /// A function which cooks the contents of a file.
+    ///
+    /// \param path The path to the file.
+    /// \param source The contents of the file.
+    /// \param cooked The cooked contents to write to.
+    /// \param references The strings in the file which may be paths to other
+    /// assets.
+    typedef std::function<void(const Path& path, const std::vector<uint8_t>& source, std::vector<uint8_t>& cooked, std::vector<std::string>& references)> CookFunction;
+
+    ///
+    /// The path in a cooked pack of the manifest of the cooked files.
+    static const char* const ManifestPath;
+
+    ///
+    /// The result of a cook.
+    struct Result
+    {
+        Result();
+
+        ///
+        /// The number of files cooked.
+        size_t cookedCount;
+
+        ///
+        /// The number of files copied as is.
+        size_t copiedCount;
+
+        ///
+        /// The number of files reused from the previous cook.
+        size_t reusedCount;
+
+        ///
+        /// The errors which occurred (a file which failed to cook is left
+        /// out of the pack).
+        std::vector<std::string> errors;
+    };
+
+    ///
+    /// Constructs an asset cooker.
+    ///
+    /// \param fileSystem The file system to read the files to cook from.
+    /// \param taskPool The task pool to cook the files in.
+    AssetCooker(FileSystem& fileSystem, TaskPool& taskPool);
+
+    ///
+    /// Sets the function which cooks the files with an extension.
+    ///
+    /// \param extension The extension (without the '.').
+    /// \param cookFunction The cook function.
+    void setCookFunction(const std::string& extension, CookFunction cookFunction);
+
+    ///
+    /// Cooks every file in a directory and adds them to a pack.
+    ///
+    /// \remarks A reference in a file to an asset which does not exist is
+    /// an error.  A string in a file is considered to be a reference if it
+    /// ends with the extension of one of the files being cooked.
+    ///
+    /// \param directory The directory to cook.
+    /// \param writer The writer of the pack to add the cooked files to.
+    /// \param previousPack The pack written by a previous cook (null if
+    /// there is none).
+    /// \param compress Whether to compress the files in the pack.
+    ///
+    /// \returns The result.
+    Result cook(const Path& directory, PackFileWriter& writer, const PackFile* previousPack = nullptr, bool compress = false);
+
+private:
+    struct File
+    {
+        File();
+
+        Path path;
+        uint64_t sourceHash;
+        std::vector<uint8_t> data;
+        std::vector<std::string> references;
+        bool cooked;
+        bool reused;
+        std::string error;
+    };
+
+    struct PreviousFile
+    {
+        uint64_t sourceHash;
+        std::vector<std::string> references;
+    };
+
+    void _findFiles(const Path& directory, std::vector<File>& files) const;
+    void _cookFile(File& file, const std::map<Path, PreviousFile>& previousFiles, const PackFile* previousPack) const;
+
+    static const uint32_t _version = 1;
+
+    FileSystem& _fileSystem;
+    TaskPool& _taskPool;
+    std::map<std::string, CookFunction> _cookFunctions;
+};
+
+}
\ No newline at end of file
@@ -34,13 +34,53 @@ class AssetEntryBase
 {
 public:
     virtual ~AssetEntryBase() { }
+
+    ///
+    /// Marks the entry as accessed at a point in time.
+    ///
+    /// \param accessTime The access time (an increasing counter).
+    virtual void touch(uint64_t accessTime) = 0;
+
+    ///
+    /// Returns the time the entry was last accessed.
+    virtual uint64_t lastAccessTime() const = 0;
+
+    ///
+    /// Sets whether the asset is pinned (a pinned asset is never evicted).
+    ///
+    /// \param pinned Whether the asset is pinned.
+    virtual void setPinned(bool pinned) = 0;
+
+    ///
+    /// Unloads the asset if it is loaded, not pinned and not referenced
+    /// outside of the entry.
+    ///
+    /// \returns The number of bytes of memory freed (zero if the asset was
+    /// not evicted).
+    virtual size_t evict() = 0;
+
+    ///
+    /// Loads a new version of the asset and swaps it in place of the
+    /// current version if the asset is loaded.
+    ///
+    /// \remarks If the new version fails to load then the current version
+    /// is kept.
+    ///
+    /// \param previousAsset Set to the replaced version of the asset.
+    ///
+    /// \returns Whether the asset was reloaded.
+    virtual bool reload(std::shared_ptr<void>& previousAsset) = 0;
 };
 
 ///
 /// Refers to the asset at a path.
+///
+/// \remarks The asset is loaded on first access or asynchronously in the
+/// asset cache's task pool.
 template <typename T>
 class AssetEntry :
-    public AssetEntryBase
+    public AssetEntryBase,
+    public std::enable_shared_from_this<AssetEntry<T>>
 {
 public:
 
@@ -52,24 +92,93 @@ public:
     /// \param path The path to the asset.
     AssetEntry(AssetCache& assetCache, const Path& path);
 
+    ///
+    /// Removes the asset's memory from the asset cache's accounting.
+    ~AssetEntry();
+
     ///
     /// Returns a shared pointer to the asset.
+    ///
+    /// \remarks Loads the asset on the calling thread if it is not loaded or
+    /// waits for it to load if it is loading asynchronously.
+    ///
+    /// \throws Error If the asset failed to load.
     std::shared_ptr<T> get();
 
+    ///
+    /// Starts loading the asset asynchronously if it is not loaded or
+    /// loading.
+    void loadAsync();
+
+    ///
+    /// Returns whether the asset is done loading (whether or not it loaded
+    /// successfully).
+    bool isReady() const;
+
+    ///
+    /// Enqueues an action to the asset cache's finalization queue once the
+    /// asset is done loading.
+    ///
+    /// \param action The action.
+    void onReady(TaskFunction action);
+
     ///
     /// Returns the path of the asset.
     const Path& path() const;
 
+    ///
+    /// Sets the path to the asset which requested the asset while loading
+    /// (the parent of the load when profiling).
+    ///
+    /// \remarks Has no effect once the asset is loading or loaded.
+    ///
+    /// \param requestingPath The path to the requesting asset.
+    void setRequestingPath(const Path& requestingPath);
+
+    void touch(uint64_t accessTime);
+    uint64_t lastAccessTime() const;
+    void setPinned(bool pinned);
+    size_t evict();
+    bool reload(std::shared_ptr<void>& previousAsset);
+
 private:
-    void _load();
+    void _load(std::unique_lock<std::mutex>& lock);
 
     AssetCache* _assetCache;
     Path _path;
 
+    mutable std::mutex _mutex;
+    std::condition_variable _loadedCondition;
+
+    // Set once the asset is done loading, after which the error is no
+    // longer modified and can be read without locking
+    std::atomic<bool> _done;
+
+    // Once done loading the asset is only replaced by a reload, so it is
+    // read and swapped atomically
     std::shared_ptr<T> _asset;
 
     bool _errorOccurred;
     std::string _errorMessage;
+
+    // The memory the asset was accounted as using and the number of times
+    // it was loaded
+    size_t _memorySize;
+    unsigned _loadCount;
+
+    std::atomic<uint64_t> _lastAccessTime;
+    std::atomic<bool> _pinned;
+
+    // Whether the asset is loading and the task loading it asynchronously
+    // (if any)
+    bool _loading;
+    Task _loadTask;
+
+    // Actions to enqueue for finalization once the asset is loaded
+    std::vector<TaskFunction> _readyActions;
+
+    // The asset which requested the asset while loading (while profiling)
+    Path _requestingPath;
 };
 
 }
@@ -28,17 +28,60 @@ template <typename T>
 AssetEntry<T>::AssetEntry(AssetCache& assetCache, const Path& path) :
     _assetCache(&assetCache),
     _path(path),
-    _errorOccurred(false)
+    _done(false),
+    _errorOccurred(false),
+    _memorySize(0),
+    _loadCount(0),
+    _lastAccessTime(0),
+    _pinned(false),
+    _loading(false)
 {
 }
 
+template <typename T>
+AssetEntry<T>::~AssetEntry()
+{
+    if (_memorySize > 0)
+    {
+        _assetCache->_removeMemoryUsage(typeid(T).name(), _memorySize);
+    }
+}
+
 template <typename T>
 std::shared_ptr<T> AssetEntry<T>::get()
 {
-    // Load the asset if needed
-    if (!_errorOccurred && !_asset)
+    // Take the fast path if the asset is resident
+    if (_done.load(std::memory_order_acquire) && !_errorOccurred)
     {
-        _load();
+        return std::atomic_load(&_asset);
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_done)
+    {
+        if (_loading)
+        {
+            if (!_loadTask.isDone())
+            {
+                // Wait for the asset to finish loading in the task pool
+                // (helping with other tasks if on a worker thread)
+                Task loadTask = _loadTask;
+                lock.unlock();
+                loadTask.wait();
+                lock.lock();
+            }
+            else
+            {
+                // Wait for the asset to finish loading on another thread
+                _loadedCondition.wait(lock);
+            }
+        }
+        else
+        {
+            // Load the asset on this thread
+            _load(lock);
+        }
     }
 
     // Thow an error if the asset failed to load
@@ -50,6 +93,62 @@ std::shared_ptr<T> AssetEntry<T>::get()
     return _asset;
 }
 
+template <typename T>
+void AssetEntry<T>::loadAsync()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (_done || _loading)
+    {
+        return;
+    }
+
+    TaskPool* taskPool = _assetCache->taskPool();
+    if (!taskPool || taskPool->threadCount() == 0)
+    {
+        // Without a task pool (or with one which executes tasks
+        // synchronously) the asset is loaded on the calling thread since
+        // the load task would otherwise lock the mutex held here
+        _load(lock);
+        return;
+    }
+
+    // The load task is published under the same lock as the loading flag
+    // so a thread waiting for the load always finds the task to help with
+    // (the task cannot begin loading until the lock is released)
+    _loading = true;
+
+    // The task keeps the entry alive until the asset is loaded
+    std::shared_ptr<AssetEntry<T>> entry = this->shared_from_this();
+    _loadTask = taskPool->enqueue([entry]
+    {
+        std::unique_lock<std::mutex> lock(entry->_mutex);
+        entry->_load(lock);
+    }, TaskPriority::Low);
+}
+
+template <typename T>
+bool AssetEntry<T>::isReady() const
+{
+    return _done.load(std::memory_order_acquire);
+}
+
+template <typename T>
+void AssetEntry<T>::onReady(TaskFunction action)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (_done)
+    {
+        lock.unlock();
+        _assetCache->_enqueueFinalization(std::move(action), _path);
+    }
+    else
+    {
+        _readyActions.push_back(std::move(action));
+    }
+}
+
 template <typename T>
 const Path& AssetEntry<T>::path() const
 {
@@ -57,22 +156,160 @@ const Path& AssetEntry<T>::path() const
 }
 
 template <typename T>
-void AssetEntry<T>::_load()
+void AssetEntry<T>::setRequestingPath(const Path& requestingPath)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (!_done && !_loading)
+    {
+        _requestingPath = requestingPath;
+    }
+}
+
+template <typename T>
+void AssetEntry<T>::touch(uint64_t accessTime)
 {
-    _asset = std::make_shared<T>();
-    _errorOccurred = false;
+    _lastAccessTime.store(accessTime, std::memory_order_relaxed);
+}
+
+template <typename T>
+uint64_t AssetEntry<T>::lastAccessTime() const
+{
+    return _lastAccessTime.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void AssetEntry<T>::setPinned(bool pinned)
+{
+    _pinned = pinned;
+}
+
+template <typename T>
+size_t AssetEntry<T>::evict()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Only evict a loaded asset which is referenced by the entry alone
+    if (!_done || _errorOccurred || _pinned || _asset.use_count() != 1)
+    {
+        return 0;
+    }
+
+    size_t memorySize = _memorySize;
+    _done = false;
+    std::atomic_store(&_asset, std::shared_ptr<T>());
+    _memorySize = 0;
+    _assetCache->_removeMemoryUsage(typeid(T).name(), memorySize);
+
+    return memorySize;
+}
+
+template <typename T>
+bool AssetEntry<T>::reload(std::shared_ptr<void>& previousAsset)
+{
+    // Only reload an asset which is loaded
+    Path requestingPath;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_done || _errorOccurred)
+        {
+            return false;
+        }
+        requestingPath = _requestingPath;
+    }
+
+    // Load the new version while the current version remains available
+    std::shared_ptr<T> asset = std::make_shared<T>();
+    try
+    {
+        LOG_INFO(format("Reloading '%s'...", _path.toString().c_str()));
+        _assetCache->_beginLoad(_path, requestingPath);
+        AssetLoader<T>::load(*asset, _path, *_assetCache);
+    }
+    catch (Error& error)
+    {
+        _assetCache->_endLoad(_path, typeid(T).name(), 0, true);
+        LOG_ERROR(format("Failed to reload '%s': %s", _path.toString().c_str(), error.what()));
+        return false;
+    }
+
+    size_t memorySize = assetMemorySize(*asset);
+    _assetCache->_endLoad(_path, typeid(T).name(), memorySize, false);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // The asset may have been evicted while reloading
+    if (!_done || _errorOccurred)
+    {
+        return false;
+    }
+
+    previousAsset = _asset;
+    std::atomic_store(&_asset, asset);
+
+    _assetCache->_removeMemoryUsage(typeid(T).name(), _memorySize);
+    _memorySize = memorySize;
+    _assetCache->_addMemoryUsage(typeid(T).name(), _memorySize, true);
+    ++_loadCount;
+
+    return true;
+}
+
+template <typename T>
+void AssetEntry<T>::_load(std::unique_lock<std::mutex>& lock)
+{
+    _loading = true;
+    Path requestingPath = _requestingPath;
+
+    // Load the asset without holding the lock so other threads can check
+    // whether it is ready
+    lock.unlock();
+
+    std::shared_ptr<T> asset = std::make_shared<T>();
+    bool errorOccurred = false;
+    std::string errorMessage;
 
     // Load the asset and save the error message
     try
     {
         LOG_INFO(format("Loading '%s'...", _path.toString().c_str()));
-        AssetLoader<T>::load(*_asset, _path, *_assetCache);
+        _assetCache->_beginLoad(_path, requestingPath);
+        AssetLoader<T>::load(*asset, _path, *_assetCache);
     }
     catch (Error& error)
     {
         // Save the error message
+        errorOccurred = true;
+        errorMessage = error.what();
+    }
+
+    size_t memorySize = errorOccurred ? 0 : assetMemorySize(*asset);
+    _assetCache->_endLoad(_path, typeid(T).name(), memorySize, errorOccurred);
+
+    lock.lock();
+
+    if (errorOccurred)
+    {
         _errorOccurred = true;
-        _errorMessage = error.what();
+        _errorMessage = errorMessage;
+    }
+    else
+    {
+        std::atomic_store(&_asset, asset);
+        _memorySize = memorySize;
+        _assetCache->_addMemoryUsage(typeid(T).name(), _memorySize, _loadCount > 0);
+        ++_loadCount;
+    }
+    _loading = false;
+    _done.store(true, std::memory_order_release);
+    _loadedCondition.notify_all();
+
+    // Notify the actions waiting for the asset on the finalization queue
+    std::vector<TaskFunction> readyActions;
+    readyActions.swap(_readyActions);
+    for (TaskFunction& action : readyActions)
+    {
+        _assetCache->_enqueueFinalization(std::move(action), _path);
     }
 }
 
@@ -31,6 +31,7 @@ namespace hect
 template <typename T>
 class AssetHandle
 {
+    friend class AssetCache;
 public:
 
     ///
@@ -59,6 +60,40 @@ public:
     /// \throws Error If the asset failed to load.
     std::shared_ptr<T> getShared() const;
 
+    ///
+    /// Returns whether the asset is done loading (whether or not it loaded
+    /// successfully).
+    ///
+    /// \throws Error If the handle is empty.
+    bool isReady() const;
+
+    ///
+    /// Waits until the asset is loaded, loading it on the calling thread if
+    /// it is not already loading.
+    ///
+    /// \throws Error If the handle is empty or the asset failed to load.
+    void wait() const;
+
+    ///
+    /// Enqueues an action to be executed once the asset is done loading.
+    ///
+    /// \remarks The action is executed on the thread which finalizes loads
+    /// in the asset cache (see AssetCache::finalizeLoads()).
+    ///
+    /// \param action The action to execute.
+    ///
+    /// \throws Error If the handle is empty.
+    void onReady(TaskFunction action) const;
+
+    ///
+    /// Sets whether the asset is pinned in the asset cache (a pinned asset
+    /// is never evicted).
+    ///
+    /// \param pinned Whether the asset is pinned.
+    ///
+    /// \throws Error If the handle is empty.
+    void setPinned(bool pinned) const;
+
     ///
     /// Returns the path to the asset.
     const Path& path() const;
@@ -52,6 +52,46 @@ std::shared_ptr<T> AssetHandle<T>::getShared() const
     return std::shared_ptr<T>();
 }
 
+template <typename T>
+bool AssetHandle<T>::isReady() const
+{
+    if (!_entry)
+    {
+        throw Error("Asset entry is null");
+    }
+    return _entry->isReady();
+}
+
+template <typename T>
+void AssetHandle<T>::wait() const
+{
+    if (!_entry)
+    {
+        throw Error("Asset entry is null");
+    }
+    _entry->get();
+}
+
+template <typename T>
+void AssetHandle<T>::onReady(TaskFunction action) const
+{
+    if (!_entry)
+    {
+        throw Error("Asset entry is null");
+    }
+    _entry->onReady(std::move(action));
+}
+
+template <typename T>
+void AssetHandle<T>::setPinned(bool pinned) const
+{
+    if (!_entry)
+    {
+        throw Error("Asset entry is null");
+    }
+    _entry->setPinned(pinned);
+}
+
 template <typename T>
 const Path& AssetHandle<T>::path() const
 {
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+namespace
+{
+
+double toMicroseconds(TimeSpan time)
+{
+    return (double)time.microseconds();
+}
+
+}
+
+AssetLoadProfile::Load::Load() :
+    bytesRead(0),
+    memorySize(0),
+    failed(false)
+{
+}
+
+TimeSpan AssetLoadProfile::Load::cost() const
+{
+    return readTime + decodeTime + finalizeTime;
+}
+
+void AssetLoadProfile::addLoad(const Load& load)
+{
+    _lastLoadIndices[load.path] = _loads.size();
+    _loads.push_back(load);
+}
+
+void AssetLoadProfile::addFinalizeTime(const Path& path, TimeSpan time)
+{
+    auto it = _lastLoadIndices.find(path);
+    if (it != _lastLoadIndices.end())
+    {
+        _loads[it->second].finalizeTime += time;
+    }
+}
+
+const std::vector<AssetLoadProfile::Load>& AssetLoadProfile::loads() const
+{
+    return _loads;
+}
+
+std::vector<const AssetLoadProfile::Load*> AssetLoadProfile::loadsByCost() const
+{
+    std::vector<const Load*> loads;
+    loads.reserve(_loads.size());
+    for (const Load& load : _loads)
+    {
+        loads.push_back(&load);
+    }
+
+    std::stable_sort(loads.begin(), loads.end(), [](const Load* a, const Load* b)
+    {
+        return a->cost().microseconds() > b->cost().microseconds();
+    });
+
+    return loads;
+}
+
+void AssetLoadProfile::save(WriteStream& stream) const
+{
+    DataValue loads(DataValueType::Array);
+    TimeSpan totalCost;
+    for (const Load* load : loadsByCost())
+    {
+        DataValue loadValue(DataValueType::Object);
+        loadValue.addMember("path", load->path.toString());
+        loadValue.addMember("type", load->typeName);
+        loadValue.addMember("parent", load->parentPath.toString());
+        loadValue.addMember("cost", toMicroseconds(load->cost()));
+        loadValue.addMember("totalTime", toMicroseconds(load->totalTime));
+        loadValue.addMember("readTime", toMicroseconds(load->readTime));
+        loadValue.addMember("decodeTime", toMicroseconds(load->decodeTime));
+        loadValue.addMember("finalizeTime", toMicroseconds(load->finalizeTime));
+        loadValue.addMember("bytesRead", (double)load->bytesRead);
+        loadValue.addMember("memorySize", (double)load->memorySize);
+        loadValue.addMember("failed", load->failed);
+        loads.addElement(loadValue);
+
+        totalCost += load->cost();
+    }
+
+    DataValue dataValue(DataValueType::Object);
+    dataValue.addMember("totalCost", toMicroseconds(totalCost));
+    dataValue.addMember("loads", loads);
+    DataValueJsonFormat::save(dataValue, stream);
+}
+
+void AssetLoadProfile::saveFoldedStacks(WriteStream& stream) const
+{
+    for (const Load& load : _loads)
+    {
+        // Follow the parents up to the first requesting asset (stopping at a
+        // path already in the chain in case of a cycle)
+        std::vector<Path> chain;
+        chain.push_back(load.path);
+        Path parentPath = load.parentPath;
+        while (parentPath != Path() && std::find(chain.begin(), chain.end(), parentPath) == chain.end())
+        {
+            chain.push_back(parentPath);
+
+            auto it = _lastLoadIndices.find(parentPath);
+            if (it == _lastLoadIndices.end())
+            {
+                break;
+            }
+            parentPath = _loads[it->second].parentPath;
+        }
+
+        std::stringstream ss;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+        {
+            if (it != chain.rbegin())
+            {
+                ss << ";";
+            }
+            ss << *it;
+        }
+        ss << " " << load.cost().microseconds() << "\n";
+
+        stream.writeString(ss.str(), false);
+    }
+}
\ No newline at end of file
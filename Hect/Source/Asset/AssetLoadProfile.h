@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A record of the time and memory spent loading each asset loaded from an
+/// asset cache while profiling.
+///
+/// \remarks The time of a load is split into the time spent reading files,
+/// the time spent decoding what was read, and the time spent finalizing the
+/// asset (see AssetCache::finalizeLoads()).  These exclude the time spent
+/// on other loads on the same thread during the load (the assets requested
+/// while loading the asset, or unrelated assets loaded while waiting for
+/// them), which are recorded as loads of their own.
+class AssetLoadProfile
+{
+public:
+
+    ///
+    /// A load of an asset.
+    struct Load
+    {
+        Load();
+
+        ///
+        /// Returns the time spent on the load itself (excluding the loads of
+        /// its dependencies).
+        TimeSpan cost() const;
+
+        ///
+        /// The path to the asset.
+        Path path;
+
+        ///
+        /// The name of the type of the asset.
+        std::string typeName;
+
+        ///
+        /// The path to the asset which requested the asset while loading
+        /// (empty if it was not requested while loading another asset).
+        Path parentPath;
+
+        ///
+        /// The total time of the load including the other loads on the same
+        /// thread during the load.
+        TimeSpan totalTime;
+
+        ///
+        /// The time spent reading files.
+        TimeSpan readTime;
+
+        ///
+        /// The time spent decoding the asset.
+        TimeSpan decodeTime;
+
+        ///
+        /// The time spent executing the finalization actions of the asset.
+        TimeSpan finalizeTime;
+
+        ///
+        /// The number of bytes read from files.
+        size_t bytesRead;
+
+        ///
+        /// The memory used by the loaded asset in bytes.
+        size_t memorySize;
+
+        ///
+        /// Whether the asset failed to load.
+        bool failed;
+    };
+
+    ///
+    /// Adds a load to the profile.
+    ///
+    /// \param load The load.
+    void addLoad(const Load& load);
+
+    ///
+    /// Adds time spent finalizing an asset to its most recent load.
+    ///
+    /// \remarks If the asset has no load in the profile then nothing happens.
+    ///
+    /// \param path The path to the asset.
+    /// \param time The time spent.
+    void addFinalizeTime(const Path& path, TimeSpan time);
+
+    ///
+    /// Returns the loads in the order they finished.
+    const std::vector<Load>& loads() const;
+
+    ///
+    /// Returns the loads ordered from the most to the least costly.
+    std::vector<const Load*> loadsByCost() const;
+
+    ///
+    /// Saves a report of the loads ordered by cost to a stream as JSON.
+    ///
+    /// \remarks Times are in microseconds.
+    ///
+    /// \param stream The stream to write to.
+    void save(WriteStream& stream) const;
+
+    ///
+    /// Saves the cost of each load along with the chain of assets which
+    /// requested it to a stream in the folded stack format used to generate
+    /// flame graphs.
+    ///
+    /// \remarks Each line is the paths from the first requesting asset to
+    /// the loaded asset separated by semicolons followed by the cost of the
+    /// load in microseconds.
+    ///
+    /// \param stream The stream to write to.
+    void saveFoldedStacks(WriteStream& stream) const;
+
+private:
+    std::vector<Load> _loads;
+    std::unordered_map<Path, size_t> _lastLoadIndices;
+};
+
+}
\ No newline at end of file
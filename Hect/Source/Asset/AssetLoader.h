@@ -50,4 +50,18 @@ public:
     static void load(T& asset, const Path& assetPath, AssetCache& assetCache);
 };
 
+///
+/// Returns the approximate number of bytes of memory used by an asset.
+///
+/// \remarks Asset types holding large buffers provide an overload so the
+/// asset cache can account for them.
+///
+/// \param asset The asset.
+template <typename T>
+size_t assetMemorySize(const T& asset)
+{
+    asset;
+    return sizeof(T);
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+void AssetManifest::addAsset(const Path& path, const std::string& typeName)
+{
+    if (_entryIndices.find(path) == _entryIndices.end())
+    {
+        Entry entry;
+        entry.path = path;
+        entry.typeName = typeName;
+
+        _entryIndices[path] = _entries.size();
+        _entries.push_back(entry);
+    }
+}
+
+void AssetManifest::addDependency(const Path& path, const Path& dependency)
+{
+    auto it = _entryIndices.find(path);
+    if (it == _entryIndices.end())
+    {
+        throw Error(format("Asset '%s' is not in the manifest", path.toString().c_str()));
+    }
+
+    std::vector<Path>& dependencies = _entries[it->second].dependencies;
+    if (std::find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end())
+    {
+        dependencies.push_back(dependency);
+    }
+}
+
+const std::vector<AssetManifest::Entry>& AssetManifest::entries() const
+{
+    return _entries;
+}
+
+std::vector<const AssetManifest::Entry*> AssetManifest::loadOrder() const
+{
+    std::vector<const Entry*> loadOrder;
+    std::vector<bool> visited(_entries.size(), false);
+
+    for (size_t i = 0; i < _entries.size(); ++i)
+    {
+        _addToLoadOrder(i, visited, loadOrder);
+    }
+
+    return loadOrder;
+}
+
+void AssetManifest::save(WriteStream& stream) const
+{
+    DataValue assets(DataValueType::Array);
+    for (const Entry& entry : _entries)
+    {
+        DataValue dependencies(DataValueType::Array);
+        for (const Path& dependency : entry.dependencies)
+        {
+            dependencies.addElement(dependency.toString());
+        }
+
+        DataValue asset(DataValueType::Object);
+        asset.addMember("path", entry.path.toString());
+        asset.addMember("type", entry.typeName);
+        asset.addMember("dependencies", dependencies);
+        assets.addElement(asset);
+    }
+
+    DataValue dataValue(DataValueType::Object);
+    dataValue.addMember("assets", assets);
+    DataValueJsonFormat::save(dataValue, stream);
+}
+
+void AssetManifest::load(ReadStream& stream)
+{
+    DataValue dataValue;
+    DataValueJsonFormat::load(dataValue, stream);
+
+    _entries.clear();
+    _entryIndices.clear();
+
+    for (const DataValue& asset : dataValue["assets"])
+    {
+        Path path(asset["path"].asString());
+        addAsset(path, asset["type"].asString());
+
+        for (const DataValue& dependency : asset["dependencies"])
+        {
+            addDependency(path, dependency.asString());
+        }
+    }
+}
+
+void AssetManifest::_addToLoadOrder(size_t index, std::vector<bool>& visited, std::vector<const Entry*>& loadOrder) const
+{
+    // Mark as visited before visiting the dependencies in case of a cycle
+    if (visited[index])
+    {
+        return;
+    }
+    visited[index] = true;
+
+    const Entry& entry = _entries[index];
+    for (const Path& dependency : entry.dependencies)
+    {
+        auto it = _entryIndices.find(dependency);
+        if (it != _entryIndices.end())
+        {
+            _addToLoadOrder(it->second, visited, loadOrder);
+        }
+    }
+
+    loadOrder.push_back(&entry);
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A record of the assets requested from an asset cache in the order they
+/// were first requested along with the assets each asset depends on.
+///
+/// \remarks A manifest recorded during one run of an application can be used
+/// to prefetch the assets on the next run.
+class AssetManifest
+{
+public:
+
+    ///
+    /// An asset in a manifest.
+    struct Entry
+    {
+        ///
+        /// The path to the asset.
+        Path path;
+
+        ///
+        /// The name of the type of the asset.
+        std::string typeName;
+
+        ///
+        /// The paths to the assets requested while loading the asset.
+        std::vector<Path> dependencies;
+    };
+
+    ///
+    /// Adds an asset to the manifest.
+    ///
+    /// \remarks If the asset is already in the manifest then nothing happens.
+    ///
+    /// \param path The path to the asset.
+    /// \param typeName The name of the type of the asset.
+    void addAsset(const Path& path, const std::string& typeName);
+
+    ///
+    /// Adds a dependency to an asset in the manifest.
+    ///
+    /// \remarks If the dependency was already added then nothing happens.
+    ///
+    /// \param path The path to the asset.
+    /// \param dependency The path to the asset it depends on.
+    ///
+    /// \throws Error If the asset is not in the manifest.
+    void addDependency(const Path& path, const Path& dependency);
+
+    ///
+    /// Returns the assets in the order they were first requested.
+    const std::vector<Entry>& entries() const;
+
+    ///
+    /// Returns the assets ordered so that each asset comes after the assets
+    /// it depends on.
+    std::vector<const Entry*> loadOrder() const;
+
+    ///
+    /// Saves the manifest to a stream as JSON.
+    ///
+    /// \param stream The stream to write to.
+    void save(WriteStream& stream) const;
+
+    ///
+    /// Loads the manifest from a stream of JSON.
+    ///
+    /// \param stream The stream to read from.
+    void load(ReadStream& stream);
+
+private:
+    void _addToLoadOrder(size_t index, std::vector<bool>& visited, std::vector<const Entry*>& loadOrder) const;
+
+    std::vector<Entry> _entries;
+    std::unordered_map<Path, size_t> _entryIndices;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+ActionQueue::ActionQueue() :
+    _nextSequence(0),
+    _takenCount(0)
+{
+}
+
+void ActionQueue::enqueue(TaskFunction action)
+{
+    _enqueue(Task(), 0, std::move(action));
+}
+
+void ActionQueue::enqueueWhenDone(Task task, TaskFunction action)
+{
+    _enqueue(std::move(task), 0, std::move(action));
+}
+
+void ActionQueue::enqueueAfter(TimeSpan delay, TaskFunction action)
+{
+    _enqueue(Task(), Timer::totalElapsed().microseconds() + delay.microseconds(), std::move(action));
+}
+
+size_t ActionQueue::execute()
+{
+    return _execute(-1);
+}
+
+size_t ActionQueue::execute(TimeSpan budget)
+{
+    return _execute(Timer::totalElapsed().microseconds() + budget.microseconds());
+}
+
+size_t ActionQueue::pendingCount() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _entries.size() + _takenCount;
+}
+
+ActionQueue::Entry::Entry() :
+    dueTime(0),
+    sequence(0)
+{
+}
+
+ActionQueue::Entry::Entry(Entry&& entry) :
+    action(std::move(entry.action)),
+    task(std::move(entry.task)),
+    dueTime(entry.dueTime),
+    sequence(entry.sequence)
+{
+}
+
+ActionQueue::Entry& ActionQueue::Entry::operator=(Entry&& entry)
+{
+    action = std::move(entry.action);
+    task = std::move(entry.task);
+    dueTime = entry.dueTime;
+    sequence = entry.sequence;
+    return *this;
+}
+
+size_t ActionQueue::_execute(int64_t timeLimit)
+{
+    int64_t now = Timer::totalElapsed().microseconds();
+
+    // Take all of the ready actions at once (actions enqueued while
+    // executing are left for the next call)
+    std::vector<Entry> readyEntries;
+    _takeReady(now, readyEntries);
+
+    size_t executedCount = 0;
+    try
+    {
+        while (executedCount < readyEntries.size())
+        {
+            // Release the action before executing the next one even if an
+            // error occurs
+            TaskFunction action(std::move(readyEntries[executedCount].action));
+            ++executedCount;
+            action();
+
+            // Stop once the time limit (if any) has passed
+            if (timeLimit >= 0 && Timer::totalElapsed().microseconds() >= timeLimit)
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        _returnUnexecuted(readyEntries, executedCount);
+        throw;
+    }
+
+    _returnUnexecuted(readyEntries, executedCount);
+    return executedCount;
+}
+
+void ActionQueue::_enqueue(Task task, int64_t dueTime, TaskFunction action)
+{
+    if (action.isEmpty())
+    {
+        throw Error("Action is empty");
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Entry entry;
+    entry.action = std::move(action);
+    entry.task = std::move(task);
+    entry.dueTime = dueTime;
+    entry.sequence = _nextSequence++;
+    _entries.push_back(std::move(entry));
+}
+
+void ActionQueue::_takeReady(int64_t now, std::vector<Entry>& readyEntries)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Move the ready entries out in a single pass, compacting the entries
+    // which remain (both stay in the order they were enqueued)
+    auto remaining = _entries.begin();
+    for (auto it = _entries.begin(); it != _entries.end(); ++it)
+    {
+        if (it->dueTime <= now && it->task.isDone())
+        {
+            readyEntries.push_back(std::move(*it));
+        }
+        else
+        {
+            if (remaining != it)
+            {
+                *remaining = std::move(*it);
+            }
+            ++remaining;
+        }
+    }
+    _entries.erase(remaining, _entries.end());
+
+    _takenCount += readyEntries.size();
+}
+
+void ActionQueue::_returnUnexecuted(std::vector<Entry>& readyEntries, size_t executedCount)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _takenCount -= readyEntries.size();
+
+    if (executedCount == readyEntries.size())
+    {
+        return;
+    }
+
+    // Merge the actions which were not executed back in the order they
+    // were enqueued
+    std::vector<Entry> entries;
+    entries.reserve(_entries.size() + readyEntries.size() - executedCount);
+    std::merge(
+        std::make_move_iterator(readyEntries.begin() + executedCount), std::make_move_iterator(readyEntries.end()),
+        std::make_move_iterator(_entries.begin()), std::make_move_iterator(_entries.end()),
+        std::back_inserter(entries), [](const Entry& a, const Entry& b)
+    {
+        return a.sequence < b.sequence;
+    });
+    _entries.swap(entries);
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A queue of actions which are executed on the thread which executes the
+/// queue (e.g. the main thread once every frame).
+///
+/// \remarks Actions may be enqueued from any thread.  An action may wait
+/// for a task to be done or for a delay to pass before it is executed,
+/// which allows a chain of asynchronous work to return to the executing
+/// thread without blocking it.
+class ActionQueue :
+    public Uncopyable
+{
+public:
+
+    ///
+    /// Constructs an empty action queue.
+    ActionQueue();
+
+    ///
+    /// Enqueues an action to be executed the next time the queue is
+    /// executed.
+    ///
+    /// \param action The action to execute.
+    ///
+    /// \throws Error If the action is empty.
+    void enqueue(TaskFunction action);
+
+    ///
+    /// Enqueues an action to be executed once a task is done.
+    ///
+    /// \remarks The action is executed whether or not an error occurred in
+    /// the task; the action may call Task::wait() to rethrow the error
+    /// without blocking.
+    ///
+    /// \param task The task to wait for.
+    /// \param action The action to execute.
+    ///
+    /// \throws Error If the action is empty.
+    void enqueueWhenDone(Task task, TaskFunction action);
+
+    ///
+    /// Enqueues an action to be executed once a delay has passed.
+    ///
+    /// \param delay The delay.
+    /// \param action The action to execute.
+    ///
+    /// \throws Error If the action is empty.
+    void enqueueAfter(TimeSpan delay, TaskFunction action);
+
+    ///
+    /// Executes all actions which are ready on the calling thread.
+    ///
+    /// \remarks Actions enqueued while executing are not executed until the
+    /// next call.
+    ///
+    /// \returns The number of actions executed.
+    ///
+    /// \throws Error If an error occurs in an action (the remaining ready
+    /// actions are executed on the next call).
+    size_t execute();
+
+    ///
+    /// Executes actions which are ready on the calling thread until a time
+    /// budget is spent.
+    ///
+    /// \remarks At least one ready action is executed even if it takes
+    /// longer than the budget.  Actions enqueued while executing are not
+    /// executed until the next call.
+    ///
+    /// \param budget The maximum time to spend executing actions.
+    ///
+    /// \returns The number of actions executed.
+    ///
+    /// \throws Error If an error occurs in an action (the remaining ready
+    /// actions are executed on the next call).
+    size_t execute(TimeSpan budget);
+
+    ///
+    /// Returns the number of actions which have not been executed.
+    size_t pendingCount() const;
+
+private:
+    struct Entry
+    {
+        Entry();
+        Entry(Entry&& entry);
+
+        Entry& operator=(Entry&& entry);
+
+        TaskFunction action;
+
+        // The task the action waits for (if any)
+        Task task;
+
+        // The time the action may be executed after (in microseconds)
+        int64_t dueTime;
+
+        // The order the action was enqueued in
+        uint64_t sequence;
+
+    private:
+        Entry(const Entry&);
+        Entry& operator=(const Entry&);
+    };
+
+    size_t _execute(int64_t timeLimit);
+    void _enqueue(Task task, int64_t dueTime, TaskFunction action);
+    void _takeReady(int64_t now, std::vector<Entry>& readyEntries);
+    void _returnUnexecuted(std::vector<Entry>& readyEntries, size_t executedCount);
+
+    mutable std::mutex _mutex;
+    std::vector<Entry> _entries;
+    uint64_t _nextSequence;
+
+    // The number of actions taken to be executed which have not been
+    // returned
+    size_t _takenCount;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A bounded channel carrying items from any number of sending threads to
+/// one receiving thread.
+///
+/// \remarks Sending and receiving do not lock unless the receiver is
+/// waiting for items, in which case a sender wakes it up.  Once the channel
+/// is closed no more items can be sent, but items already sent can still be
+/// received.
+template <typename T>
+class Channel :
+    public Uncopyable
+{
+public:
+
+    ///
+    /// Constructs an empty channel.
+    ///
+    /// \param capacity The maximum number of items in the channel (rounded
+    /// up to a power of two of at least two).
+    Channel(size_t capacity = 1024);
+
+    ///
+    /// Sends an item without waiting.
+    ///
+    /// \param item The item to send.
+    ///
+    /// \returns True if the item was sent; false if the channel was full or
+    /// closed.
+    bool trySend(T item);
+
+    ///
+    /// Sends as many items as fit without waiting.
+    ///
+    /// \param items The items to send (moved from if sent).
+    /// \param count The number of items.
+    ///
+    /// \returns The number of items sent.
+    size_t trySend(T* items, size_t count);
+
+    ///
+    /// Sends an item, waiting while the channel is full.
+    ///
+    /// \param item The item to send.
+    ///
+    /// \returns True if the item was sent; false if the channel was closed.
+    bool send(T item);
+
+    ///
+    /// Receives an item without waiting.
+    ///
+    /// \warning Must only be called from the receiving thread.
+    ///
+    /// \param item The received item.
+    ///
+    /// \returns True if an item was received; false if the channel was
+    /// empty.
+    bool tryReceive(T& item);
+
+    ///
+    /// Receives up to a number of items without waiting.
+    ///
+    /// \warning Must only be called from the receiving thread.
+    ///
+    /// \param items The array to move the received items to.
+    /// \param maxCount The maximum number of items to receive.
+    ///
+    /// \returns The number of items received.
+    size_t tryReceive(T* items, size_t maxCount);
+
+    ///
+    /// Receives an item, waiting until one is sent.
+    ///
+    /// \warning Must only be called from the receiving thread.
+    ///
+    /// \param item The received item.
+    ///
+    /// \returns True if an item was received; false if the channel was
+    /// closed and empty.
+    bool receive(T& item);
+
+    ///
+    /// Receives up to a number of items, waiting until at least one is sent
+    /// or a timeout passes.
+    ///
+    /// \warning Must only be called from the receiving thread.
+    ///
+    /// \param items The array to move the received items to.
+    /// \param maxCount The maximum number of items to receive.
+    /// \param timeout The maximum time to wait.
+    ///
+    /// \returns The number of items received.
+    size_t receive(T* items, size_t maxCount, TimeSpan timeout);
+
+    ///
+    /// Closes the channel, waking up the receiver if it is waiting.
+    void close();
+
+    ///
+    /// Returns whether the channel is closed.
+    bool isClosed() const;
+
+private:
+    void _wakeReceiver();
+
+    // Waits until the channel is not empty, is closed or the time limit
+    // passes (in microseconds; negative for no limit)
+    void _waitForItems(int64_t timeLimit);
+
+    MpscQueue<T> _queue;
+    std::atomic<bool> _closed;
+
+    std::atomic<bool> _receiverWaiting;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+};
+
+}
+
+#include "Channel.inl"
\ No newline at end of file
@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+namespace hect
+{
+
+template <typename T>
+Channel<T>::Channel(size_t capacity) :
+    _queue(capacity),
+    _closed(false),
+    _receiverWaiting(false)
+{
+}
+
+template <typename T>
+bool Channel<T>::trySend(T item)
+{
+    return trySend(&item, 1) == 1;
+}
+
+template <typename T>
+size_t Channel<T>::trySend(T* items, size_t count)
+{
+    if (_closed)
+    {
+        return 0;
+    }
+
+    size_t sentCount = _queue.push(items, count);
+    if (sentCount > 0)
+    {
+        _wakeReceiver();
+    }
+
+    return sentCount;
+}
+
+template <typename T>
+bool Channel<T>::send(T item)
+{
+    while (!_closed)
+    {
+        if (trySend(&item, 1) == 1)
+        {
+            return true;
+        }
+
+        std::this_thread::yield();
+    }
+
+    return false;
+}
+
+template <typename T>
+bool Channel<T>::tryReceive(T& item)
+{
+    return _queue.pop(item);
+}
+
+template <typename T>
+size_t Channel<T>::tryReceive(T* items, size_t maxCount)
+{
+    return _queue.pop(items, maxCount);
+}
+
+template <typename T>
+bool Channel<T>::receive(T& item)
+{
+    while (!_queue.pop(item))
+    {
+        if (_closed && _queue.empty())
+        {
+            return false;
+        }
+
+        _waitForItems(-1);
+    }
+
+    return true;
+}
+
+template <typename T>
+size_t Channel<T>::receive(T* items, size_t maxCount, TimeSpan timeout)
+{
+    size_t receivedCount = _queue.pop(items, maxCount);
+    if (receivedCount == 0 && maxCount > 0 && !_closed)
+    {
+        _waitForItems(Timer::totalElapsed().microseconds() + timeout.microseconds());
+        receivedCount = _queue.pop(items, maxCount);
+    }
+
+    return receivedCount;
+}
+
+template <typename T>
+void Channel<T>::close()
+{
+    _closed = true;
+    _wakeReceiver();
+}
+
+template <typename T>
+bool Channel<T>::isClosed() const
+{
+    return _closed;
+}
+
+template <typename T>
+void Channel<T>::_wakeReceiver()
+{
+    // Order the push before checking whether the receiver is waiting (the
+    // receiver orders the opposite way)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_receiverWaiting.load(std::memory_order_relaxed))
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.notify_one();
+    }
+}
+
+template <typename T>
+void Channel<T>::_waitForItems(int64_t timeLimit)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _receiverWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // A sender which pushed before the flag was set is seen here, and one
+    // which pushes after sees the flag and notifies under the mutex
+    while (_queue.empty() && !_closed)
+    {
+        if (timeLimit < 0)
+        {
+            _condition.wait(lock);
+        }
+        else
+        {
+            int64_t remaining = timeLimit - Timer::totalElapsed().microseconds();
+            if (remaining <= 0 || _condition.wait_for(lock, std::chrono::microseconds(remaining)) == std::cv_status::timeout)
+            {
+                break;
+            }
+        }
+    }
+
+    _receiverWaiting.store(false, std::memory_order_relaxed);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+#ifdef HECT_WINDOWS
+#include <Windows.h>
+#endif
+
+using namespace hect;
+
+namespace
+{
+
+size_t countDistinct(const std::vector<CpuTopology::Processor>& processors, unsigned CpuTopology::Processor::*member)
+{
+    std::vector<unsigned> values;
+    for (const CpuTopology::Processor& processor : processors)
+    {
+        if (std::find(values.begin(), values.end(), processor.*member) == values.end())
+        {
+            values.push_back(processor.*member);
+        }
+    }
+    return values.size();
+}
+
+}
+
+CpuTopology::Processor::Processor() :
+    index(0),
+    core(0),
+    cacheDomain(0),
+    node(0)
+{
+}
+
+CpuTopology CpuTopology::detect()
+{
+    CpuTopology topology;
+
+#ifdef HECT_WINDOWS
+    DWORD length = 0;
+    GetLogicalProcessorInformation(nullptr, &length);
+
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> informations(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!informations.empty() && GetLogicalProcessorInformation(&informations[0], &length))
+    {
+        const unsigned maxProcessorCount = sizeof(ULONG_PTR) * 8;
+
+        std::vector<Processor> processors(maxProcessorCount);
+        std::vector<bool> present(maxProcessorCount, false);
+        unsigned coreCount = 0;
+        unsigned cacheDomainCount = 0;
+
+        for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& information : informations)
+        {
+            for (unsigned i = 0; i < maxProcessorCount; ++i)
+            {
+                if (!(information.ProcessorMask & ((ULONG_PTR)1 << i)))
+                {
+                    continue;
+                }
+
+                Processor& processor = processors[i];
+                processor.index = i;
+
+                switch (information.Relationship)
+                {
+                case RelationProcessorCore:
+                    present[i] = true;
+                    processor.core = coreCount;
+                    break;
+                case RelationCache:
+                    if (information.Cache.Level == 3)
+                    {
+                        processor.cacheDomain = cacheDomainCount;
+                    }
+                    break;
+                case RelationNumaNode:
+                    processor.node = information.NumaNode.NodeNumber;
+                    break;
+                }
+            }
+
+            if (information.Relationship == RelationProcessorCore)
+            {
+                ++coreCount;
+            }
+            else if (information.Relationship == RelationCache && information.Cache.Level == 3)
+            {
+                ++cacheDomainCount;
+            }
+        }
+
+        for (unsigned i = 0; i < maxProcessorCount; ++i)
+        {
+            if (present[i])
+            {
+                // Without a shared last-level cache, treat each node as a
+                // cache domain
+                if (cacheDomainCount == 0)
+                {
+                    processors[i].cacheDomain = processors[i].node;
+                }
+
+                topology.addProcessor(processors[i]);
+            }
+        }
+    }
+#endif
+
+    if (topology._processors.empty())
+    {
+        unsigned processorCount = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < processorCount; ++i)
+        {
+            Processor processor;
+            processor.index = i;
+            processor.core = i;
+            topology.addProcessor(processor);
+        }
+    }
+
+    return topology;
+}
+
+bool CpuTopology::pinCurrentThread(unsigned processorIndex)
+{
+#ifdef HECT_WINDOWS
+    if (processorIndex < sizeof(DWORD_PTR) * 8)
+    {
+        return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << processorIndex) != 0;
+    }
+#else
+    processorIndex;
+#endif
+
+    return false;
+}
+
+CpuTopology::CpuTopology()
+{
+}
+
+void CpuTopology::addProcessor(const Processor& processor)
+{
+    _processors.push_back(processor);
+}
+
+const std::vector<CpuTopology::Processor>& CpuTopology::processors() const
+{
+    return _processors;
+}
+
+size_t CpuTopology::coreCount() const
+{
+    return countDistinct(_processors, &Processor::core);
+}
+
+size_t CpuTopology::cacheDomainCount() const
+{
+    return countDistinct(_processors, &Processor::cacheDomain);
+}
+
+size_t CpuTopology::nodeCount() const
+{
+    return countDistinct(_processors, &Processor::node);
+}
\ No newline at end of file
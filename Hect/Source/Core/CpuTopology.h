@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// Describes how the logical processors of the system share cores, caches
+/// and memory.
+class CpuTopology
+{
+public:
+
+    ///
+    /// A logical processor.
+    struct Processor
+    {
+        Processor();
+
+        ///
+        /// The index of the processor in the system.
+        unsigned index;
+
+        ///
+        /// The physical core the processor belongs to.
+        unsigned core;
+
+        ///
+        /// The last-level cache domain the processor belongs to.
+        unsigned cacheDomain;
+
+        ///
+        /// The NUMA node the processor belongs to.
+        unsigned node;
+    };
+
+    ///
+    /// Detects the topology of the system.
+    ///
+    /// \remarks If the topology cannot be queried then each logical
+    /// processor is assumed to be a core of its own sharing one cache
+    /// domain and node.
+    static CpuTopology detect();
+
+    ///
+    /// Pins the calling thread to a logical processor.
+    ///
+    /// \param processorIndex The index of the processor.
+    ///
+    /// \returns True if the thread was pinned; false if pinning is not
+    /// supported.
+    static bool pinCurrentThread(unsigned processorIndex);
+
+    ///
+    /// Constructs an empty topology.
+    CpuTopology();
+
+    ///
+    /// Adds a logical processor to the topology.
+    ///
+    /// \param processor The processor to add.
+    void addProcessor(const Processor& processor);
+
+    ///
+    /// Returns the logical processors.
+    const std::vector<Processor>& processors() const;
+
+    ///
+    /// Returns the number of physical cores.
+    size_t coreCount() const;
+
+    ///
+    /// Returns the number of last-level cache domains.
+    size_t cacheDomainCount() const;
+
+    ///
+    /// Returns the number of NUMA nodes.
+    size_t nodeCount() const;
+
+private:
+    std::vector<Processor> _processors;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,719 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+namespace
+{
+
+// The header at the beginning of the memory of a document
+struct DocumentHeader
+{
+    uint32_t signature;
+    uint32_t version;
+    uint32_t size;
+    uint32_t reserved;
+};
+
+// A value within a document
+struct DocumentNode
+{
+    uint8_t type;
+    uint8_t reserved[3];
+
+    // The length of a string or the number of elements/members
+    uint32_t size;
+
+    union
+    {
+        // The value of a bool or number
+        double number;
+
+        // The offset from the beginning of the document to the characters of
+        // a string or the elements/members of an array/object
+        uint32_t offset;
+    };
+};
+
+// A member of an object within a document
+struct DocumentMember
+{
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    DocumentNode value;
+};
+
+const DocumentNode nullNode = { 0 };
+const size_t rootOffset = sizeof(DocumentHeader);
+const size_t alignment = 8;
+
+size_t align(size_t size)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+const DocumentNode* nodeAt(const uint8_t* data, size_t offset)
+{
+    return data ? (const DocumentNode*)(data + offset) : &nullNode;
+}
+
+const DocumentMember* memberAt(const uint8_t* data, const DocumentNode* node, size_t index)
+{
+    return (const DocumentMember*)(data + node->offset) + index;
+}
+
+// Returns the number of bytes needed for the strings/elements/members
+// referenced by a value and all of its descendants
+size_t measure(const DataValue& dataValue)
+{
+    size_t size = 0;
+    if (dataValue.isString())
+    {
+        size += align(dataValue.asString().size() + 1);
+    }
+    else if (dataValue.isArray())
+    {
+        size += align(dataValue.size() * sizeof(DocumentNode));
+        for (const DataValue& element : dataValue)
+        {
+            size += measure(element);
+        }
+    }
+    else if (dataValue.isObject())
+    {
+        size += align(dataValue.size() * sizeof(DocumentMember));
+        for (const std::string& name : dataValue.memberNames())
+        {
+            size += align(name.size() + 1);
+            size += measure(dataValue[name]);
+        }
+    }
+    return size;
+}
+
+// Lays out values within the pre-allocated memory of a document
+class DocumentBuilder
+{
+public:
+    DocumentBuilder(std::vector<uint8_t>& data, size_t nextOffset) :
+        _data(&data),
+        _nextOffset(nextOffset)
+    {
+    }
+
+    void write(size_t nodeOffset, const DataValue& dataValue)
+    {
+        DocumentNode* node = _node(nodeOffset);
+        node->type = (uint8_t)dataValue.type();
+
+        if (dataValue.isBool())
+        {
+            node->number = dataValue.asBool() ? 1.0 : 0.0;
+        }
+        else if (dataValue.isNumber())
+        {
+            node->number = dataValue.asDouble();
+        }
+        else if (dataValue.isString())
+        {
+            const std::string& string = dataValue.asString();
+            node->size = (uint32_t)string.size();
+            node->offset = _writeString(string);
+        }
+        else if (dataValue.isArray())
+        {
+            size_t elementsOffset = _allocate(dataValue.size() * sizeof(DocumentNode));
+            node->size = (uint32_t)dataValue.size();
+            node->offset = (uint32_t)elementsOffset;
+
+            size_t elementOffset = elementsOffset;
+            for (const DataValue& element : dataValue)
+            {
+                write(elementOffset, element);
+                elementOffset += sizeof(DocumentNode);
+            }
+        }
+        else if (dataValue.isObject())
+        {
+            size_t membersOffset = _allocate(dataValue.size() * sizeof(DocumentMember));
+            node->size = (uint32_t)dataValue.size();
+            node->offset = (uint32_t)membersOffset;
+
+            // Member names are already sorted since they come from a map
+            size_t memberOffset = membersOffset;
+            for (const std::string& name : dataValue.memberNames())
+            {
+                uint32_t nameOffset = _writeString(name);
+
+                DocumentMember* member = (DocumentMember*)&(*_data)[memberOffset];
+                member->nameOffset = nameOffset;
+                member->nameLength = (uint32_t)name.size();
+
+                write(memberOffset + offsetof(DocumentMember, value), dataValue[name]);
+                memberOffset += sizeof(DocumentMember);
+            }
+        }
+    }
+
+private:
+    DocumentNode* _node(size_t offset)
+    {
+        return (DocumentNode*)&(*_data)[offset];
+    }
+
+    size_t _allocate(size_t size)
+    {
+        size_t offset = _nextOffset;
+        _nextOffset += align(size);
+        assert(_nextOffset <= _data->size());
+        return offset;
+    }
+
+    uint32_t _writeString(const std::string& string)
+    {
+        size_t offset = _allocate(string.size() + 1);
+        std::memcpy(&(*_data)[offset], string.c_str(), string.size() + 1);
+        return (uint32_t)offset;
+    }
+
+    std::vector<uint8_t>* _data;
+    size_t _nextOffset;
+};
+
+// Throws an error if the range is outside of the document
+void validateRange(size_t documentSize, uint64_t offset, uint64_t size)
+{
+    if (offset + size > documentSize)
+    {
+        throw Error("Document contains an out of range offset");
+    }
+}
+
+void validateString(const std::vector<uint8_t>& data, uint32_t offset, uint32_t length)
+{
+    validateRange(data.size(), offset, (uint64_t)length + 1);
+    if (data[offset + length] != 0)
+    {
+        throw Error("Document contains an unterminated string");
+    }
+}
+
+void validateNode(const std::vector<uint8_t>& data, size_t nodeOffset)
+{
+    validateRange(data.size(), nodeOffset, sizeof(DocumentNode));
+    const DocumentNode* node = nodeAt(&data[0], nodeOffset);
+
+    DataValueType type = (DataValueType)node->type;
+    if (type == DataValueType::String || type == DataValueType::Array || type == DataValueType::Object)
+    {
+        // Values always reference memory after themselves; this rules out
+        // cycles
+        if (node->offset <= nodeOffset)
+        {
+            throw Error("Document contains an invalid offset");
+        }
+    }
+
+    switch (type)
+    {
+    case DataValueType::Null:
+    case DataValueType::Bool:
+    case DataValueType::Number:
+        break;
+    case DataValueType::String:
+        validateString(data, node->offset, node->size);
+        break;
+    case DataValueType::Array:
+        validateRange(data.size(), node->offset, (uint64_t)node->size * sizeof(DocumentNode));
+        for (uint32_t i = 0; i < node->size; ++i)
+        {
+            validateNode(data, node->offset + i * sizeof(DocumentNode));
+        }
+        break;
+    case DataValueType::Object:
+        validateRange(data.size(), node->offset, (uint64_t)node->size * sizeof(DocumentMember));
+        for (uint32_t i = 0; i < node->size; ++i)
+        {
+            const DocumentMember* member = memberAt(&data[0], node, i);
+            validateString(data, member->nameOffset, member->nameLength);
+
+            // Member names must be sorted for look-ups to work
+            if (i > 0)
+            {
+                const DocumentMember* previous = member - 1;
+                if (std::strcmp((const char*)&data[previous->nameOffset], (const char*)&data[member->nameOffset]) >= 0)
+                {
+                    throw Error("Document contains unsorted member names");
+                }
+            }
+
+            validateNode(data, node->offset + i * sizeof(DocumentMember) + offsetof(DocumentMember, value));
+        }
+        break;
+    default:
+        throw Error("Document contains a value of an unknown type");
+    }
+}
+
+template <typename T>
+T readComponents(const DataDocumentValue& value, size_t componentCount)
+{
+    T result;
+
+    size_t count = std::min(componentCount, value.isArray() ? value.size() : 0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        result[i] = value[i].asDouble();
+    }
+
+    return result;
+}
+
+}
+
+DataDocumentValue DataDocumentValue::Iterator::operator*() const
+{
+    return DataDocumentValue(_data, _offset);
+}
+
+DataDocumentValue::Iterator& DataDocumentValue::Iterator::operator++()
+{
+    _offset += sizeof(DocumentNode);
+    return *this;
+}
+
+bool DataDocumentValue::Iterator::operator==(const Iterator& iterator) const
+{
+    return _data == iterator._data && _offset == iterator._offset;
+}
+
+bool DataDocumentValue::Iterator::operator!=(const Iterator& iterator) const
+{
+    return !(*this == iterator);
+}
+
+DataDocumentValue::Iterator::Iterator(const uint8_t* data, size_t offset) :
+    _data(data),
+    _offset(offset)
+{
+}
+
+DataDocumentValue::DataDocumentValue() :
+    _data(nullptr),
+    _offset(0)
+{
+}
+
+DataValueType DataDocumentValue::type() const
+{
+    return (DataValueType)nodeAt(_data, _offset)->type;
+}
+
+bool DataDocumentValue::isNull() const
+{
+    return type() == DataValueType::Null;
+}
+
+bool DataDocumentValue::isBool() const
+{
+    return type() == DataValueType::Bool;
+}
+
+bool DataDocumentValue::isNumber() const
+{
+    return type() == DataValueType::Number;
+}
+
+bool DataDocumentValue::isString() const
+{
+    return type() == DataValueType::String;
+}
+
+bool DataDocumentValue::isArray() const
+{
+    return type() == DataValueType::Array;
+}
+
+bool DataDocumentValue::isObject() const
+{
+    return type() == DataValueType::Object;
+}
+
+bool DataDocumentValue::asBool() const
+{
+    if (isBool())
+    {
+        return nodeAt(_data, _offset)->number == 1.0;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+int DataDocumentValue::asInt() const
+{
+    return (int)asDouble();
+}
+
+unsigned DataDocumentValue::asUnsigned() const
+{
+    return (unsigned)asDouble();
+}
+
+double DataDocumentValue::asDouble() const
+{
+    if (isNumber())
+    {
+        return nodeAt(_data, _offset)->number;
+    }
+    else
+    {
+        return 0.0;
+    }
+}
+
+Vector2<> DataDocumentValue::asVector2() const
+{
+    return readComponents<Vector2<>>(*this, 2);
+}
+
+Vector3<> DataDocumentValue::asVector3() const
+{
+    return readComponents<Vector3<>>(*this, 3);
+}
+
+Vector4<> DataDocumentValue::asVector4() const
+{
+    return readComponents<Vector4<>>(*this, 4);
+}
+
+Quaternion<> DataDocumentValue::asQuaternion() const
+{
+    return readComponents<Quaternion<>>(*this, 4);
+}
+
+const char* DataDocumentValue::asString() const
+{
+    if (isString())
+    {
+        return (const char*)(_data + nodeAt(_data, _offset)->offset);
+    }
+    else
+    {
+        return "";
+    }
+}
+
+size_t DataDocumentValue::size() const
+{
+    if (isArray() || isObject())
+    {
+        return nodeAt(_data, _offset)->size;
+    }
+
+    return 0;
+}
+
+const char* DataDocumentValue::memberName(size_t index) const
+{
+    if (isObject() && index < size())
+    {
+        const DocumentMember* member = memberAt(_data, nodeAt(_data, _offset), index);
+        return (const char*)(_data + member->nameOffset);
+    }
+    else
+    {
+        return "";
+    }
+}
+
+DataDocumentValue DataDocumentValue::memberValue(size_t index) const
+{
+    if (isObject() && index < size())
+    {
+        const DocumentNode* node = nodeAt(_data, _offset);
+        return DataDocumentValue(_data, node->offset + index * sizeof(DocumentMember) + offsetof(DocumentMember, value));
+    }
+    else
+    {
+        return DataDocumentValue();
+    }
+}
+
+DataDocumentValue DataDocumentValue::member(const char* name) const
+{
+    if (!isObject())
+    {
+        return DataDocumentValue();
+    }
+
+    // Binary search the members, which are sorted by name
+    size_t first = 0;
+    size_t last = size();
+    while (first < last)
+    {
+        size_t middle = first + (last - first) / 2;
+
+        int comparison = std::strcmp(memberName(middle), name);
+        if (comparison == 0)
+        {
+            return memberValue(middle);
+        }
+        else if (comparison < 0)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    return DataDocumentValue();
+}
+
+DataValue DataDocumentValue::toDataValue() const
+{
+    switch (type())
+    {
+    case DataValueType::Bool:
+        return DataValue(asBool());
+    case DataValueType::Number:
+        return DataValue(asDouble());
+    case DataValueType::String:
+        return DataValue(asString());
+    case DataValueType::Array:
+    {
+        DataValue dataValue(DataValueType::Array);
+        for (DataDocumentValue element : *this)
+        {
+            dataValue.addElement(element.toDataValue());
+        }
+        return dataValue;
+    }
+    case DataValueType::Object:
+    {
+        DataValue dataValue(DataValueType::Object);
+        for (size_t i = 0; i < size(); ++i)
+        {
+            dataValue.addMember(memberName(i), memberValue(i).toDataValue());
+        }
+        return dataValue;
+    }
+    default:
+        return DataValue();
+    }
+}
+
+DataDocumentValue DataDocumentValue::operator[](size_t index) const
+{
+    if (isArray() && index < size())
+    {
+        const DocumentNode* node = nodeAt(_data, _offset);
+        return DataDocumentValue(_data, node->offset + index * sizeof(DocumentNode));
+    }
+    else
+    {
+        return DataDocumentValue();
+    }
+}
+
+DataDocumentValue DataDocumentValue::operator[](const std::string& name) const
+{
+    return member(name.c_str());
+}
+
+DataDocumentValue DataDocumentValue::at(const DataValuePath& path) const
+{
+    DataDocumentValue value = *this;
+    for (size_t i = 0; i < path.size() && !value.isNull(); ++i)
+    {
+        if (path.isIndex(i) && value.isArray())
+        {
+            value = value[path.index(i)];
+        }
+        else
+        {
+            value = value.member(path.name(i).c_str());
+        }
+    }
+    return value;
+}
+
+DataDocumentValue::Iterator DataDocumentValue::begin() const
+{
+    if (isArray())
+    {
+        return Iterator(_data, nodeAt(_data, _offset)->offset);
+    }
+    else
+    {
+        return Iterator(nullptr, 0);
+    }
+}
+
+DataDocumentValue::Iterator DataDocumentValue::end() const
+{
+    if (isArray())
+    {
+        const DocumentNode* node = nodeAt(_data, _offset);
+        return Iterator(_data, node->offset + node->size * sizeof(DocumentNode));
+    }
+    else
+    {
+        return Iterator(nullptr, 0);
+    }
+}
+
+DataDocumentValue::DataDocumentValue(const uint8_t* data, size_t offset) :
+    _data(data),
+    _offset(offset)
+{
+}
+
+const uint32_t DataDocument::Signature = 0xFE02;
+const uint32_t DataDocument::Version = 1;
+
+DataDocument::DataDocument()
+{
+    _build(DataValue());
+}
+
+DataDocument::DataDocument(const DataValue& dataValue)
+{
+    _build(dataValue);
+}
+
+DataDocument::DataDocument(DataDocument&& document) :
+    _data(std::move(document._data))
+{
+}
+
+DataDocumentValue DataDocument::root() const
+{
+    if (_data.empty())
+    {
+        return DataDocumentValue();
+    }
+
+    return DataDocumentValue(&_data[0], rootOffset);
+}
+
+const uint8_t* DataDocument::data() const
+{
+    return _data.empty() ? nullptr : &_data[0];
+}
+
+size_t DataDocument::dataSize() const
+{
+    return _data.size();
+}
+
+void DataDocument::save(WriteStream& stream) const
+{
+    if (!_data.empty())
+    {
+        stream.writeBytes(&_data[0], _data.size());
+    }
+}
+
+void DataDocument::load(ReadStream& stream)
+{
+    DocumentHeader header;
+    header.signature = stream.readUnsignedInt();
+    header.version = stream.readUnsignedInt();
+    header.size = stream.readUnsignedInt();
+    header.reserved = stream.readUnsignedInt();
+
+    if (header.signature != Signature)
+    {
+        throw Error("The stream does not contain a valid document");
+    }
+    else if (header.version != Version)
+    {
+        throw Error(format("Unsupported document version %d", header.version));
+    }
+    else if (header.size < rootOffset + sizeof(DocumentNode))
+    {
+        throw Error("The stream does not contain a valid document");
+    }
+
+    // Read the entire document in one allocation
+    std::vector<uint8_t> data(header.size);
+    std::memcpy(&data[0], &header, sizeof(DocumentHeader));
+    stream.readBytes(&data[rootOffset], header.size - rootOffset);
+
+    _data.swap(data);
+    try
+    {
+        _validate();
+    }
+    catch (Error&)
+    {
+        _data.swap(data);
+        throw;
+    }
+}
+
+DataDocument& DataDocument::operator=(const DataValue& dataValue)
+{
+    _build(dataValue);
+    return *this;
+}
+
+DataDocument& DataDocument::operator=(DataDocument&& document)
+{
+    _data = std::move(document._data);
+    return *this;
+}
+
+void DataDocument::_build(const DataValue& dataValue)
+{
+    // Measure the document first so that it is built in one allocation
+    size_t size = rootOffset + sizeof(DocumentNode) + measure(dataValue);
+    if ((uint64_t)size > UINT32_MAX)
+    {
+        throw Error("Data value is too large to build a document from");
+    }
+
+    std::vector<uint8_t> data(size);
+
+    DocumentHeader* header = (DocumentHeader*)&data[0];
+    header->signature = Signature;
+    header->version = Version;
+    header->size = (uint32_t)size;
+    header->reserved = 0;
+
+    DocumentBuilder builder(data, rootOffset + sizeof(DocumentNode));
+    builder.write(rootOffset, dataValue);
+
+    _data.swap(data);
+}
+
+void DataDocument::_validate() const
+{
+    validateNode(_data, rootOffset);
+}
\ No newline at end of file
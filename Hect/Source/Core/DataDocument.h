@@ -0,0 +1,320 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+class DataDocument;
+
+///
+/// A read-only handle to a value within a data document.
+///
+/// \remarks A data document value is a lightweight pointer into the memory of
+/// the document it belongs to.  It is only valid for the lifetime of the
+/// document.
+class DataDocumentValue
+{
+    friend class DataDocument;
+public:
+
+    ///
+    /// Iterates over the elements of an array value.
+    class Iterator
+    {
+        friend class DataDocumentValue;
+    public:
+
+        ///
+        /// Returns the element the iterator is at.
+        DataDocumentValue operator*() const;
+
+        ///
+        /// Moves the iterator to the next element.
+        Iterator& operator++();
+
+        ///
+        /// Returns whether the iterator is at the same element as another.
+        ///
+        /// \param iterator The other iterator.
+        bool operator==(const Iterator& iterator) const;
+
+        ///
+        /// Returns whether the iterator is at a different element than
+        /// another.
+        ///
+        /// \param iterator The other iterator.
+        bool operator!=(const Iterator& iterator) const;
+
+    private:
+        Iterator(const uint8_t* data, size_t offset);
+
+        const uint8_t* _data;
+        size_t _offset;
+    };
+
+    ///
+    /// Constructs a null value that does not belong to a document.
+    DataDocumentValue();
+
+    ///
+    /// Returns the type.
+    DataValueType type() const;
+
+    ///
+    /// Returns whether the value is null.
+    bool isNull() const;
+
+    ///
+    /// Returns whether the value is a bool.
+    bool isBool() const;
+
+    ///
+    /// Returns whether the value is a number.
+    bool isNumber() const;
+
+    ///
+    /// Returns whether the value is a string.
+    bool isString() const;
+
+    ///
+    /// Returns whether the value is an array.
+    bool isArray() const;
+
+    ///
+    /// Returns whether the value is an object.
+    bool isObject() const;
+
+    ///
+    /// Returns the value as a bool (false if the value is not a bool).
+    bool asBool() const;
+
+    ///
+    /// Returns the value as an int (zero if the value is not a number).
+    int asInt() const;
+
+    ///
+    /// Returns the value as an unsigned int (zero if the value is not a
+    /// number).
+    unsigned asUnsigned() const;
+
+    ///
+    /// Returns the value as a double (zero if the value is not a number).
+    double asDouble() const;
+
+    ///
+    /// Returns the value as a 2-dimensional vector (assumes the value is an
+    /// array of numbers).
+    Vector2<> asVector2() const;
+
+    ///
+    /// Returns the value as a 3-dimensional vector (assumes the value is an
+    /// array of numbers).
+    Vector3<> asVector3() const;
+
+    ///
+    /// Returns the value as a 4-dimensional vector (assumes the value is an
+    /// array of numbers).
+    Vector4<> asVector4() const;
+
+    ///
+    /// Returns the value as a quaternion (assumes the value is an array of
+    /// numbers).
+    Quaternion<> asQuaternion() const;
+
+    ///
+    /// Returns the value as a null-terminated string (empty string if the
+    /// value is not a string).
+    ///
+    /// \remarks The string is stored within the document so no memory is
+    /// allocated.
+    const char* asString() const;
+
+    ///
+    /// Returns the number of elements or members.
+    size_t size() const;
+
+    ///
+    /// Returns the name of the member at the given index (empty string if the
+    /// value is not an object or the index is out of range).
+    ///
+    /// \remarks Members are ordered by name.
+    ///
+    /// \param index The index of the member.
+    const char* memberName(size_t index) const;
+
+    ///
+    /// Returns the value of the member at the given index.
+    ///
+    /// \remarks Members are ordered by name.
+    ///
+    /// \param index The index of the member.
+    DataDocumentValue memberValue(size_t index) const;
+
+    ///
+    /// Returns the member of the given name (null if the value is not an
+    /// object or has no member of the name).
+    ///
+    /// \remarks The member is found using a binary search without allocating
+    /// any memory.
+    ///
+    /// \param name The name of the member to access.
+    DataDocumentValue member(const char* name) const;
+
+    ///
+    /// Constructs a data value from this value and all of its descendants.
+    DataValue toDataValue() const;
+
+    ///
+    /// Returns the element at the given index.
+    ///
+    /// \remarks Only applies to values that are arrays.
+    ///
+    /// \param index The index to access the element at.
+    DataDocumentValue operator[](size_t index) const;
+
+    ///
+    /// Returns the member of the given name.
+    ///
+    /// \remarks Only applies to values that are objects.  The member is found
+    /// using a binary search.
+    ///
+    /// \param name The name of the member to access.
+    DataDocumentValue operator[](const std::string& name) const;
+
+    ///
+    /// Returns the value at the given path relative to this value (null if
+    /// there is no value at the path).
+    ///
+    /// \param path The path to the value.
+    DataDocumentValue at(const DataValuePath& path) const;
+
+    ///
+    /// Returns an iterator at the beginning of the elements.
+    ///
+    /// \remarks Only applies to values that are arrays.
+    Iterator begin() const;
+
+    ///
+    /// Returns an iterator at the end of the elements.
+    ///
+    /// \remarks Only applies to values that are arrays.
+    Iterator end() const;
+
+private:
+    DataDocumentValue(const uint8_t* data, size_t offset);
+
+    const uint8_t* _data;
+    size_t _offset;
+};
+
+///
+/// An immutable hierarchical structure of data stored in a single block of
+/// memory.
+///
+/// \remarks All values of a document are laid out in one contiguous
+/// allocation and link to each other using offsets instead of pointers.  This
+/// makes a document cheap to build and free, safe to read from multiple
+/// threads without locking, and relocatable: the block of memory can be
+/// written to a stream and loaded back without any fix-up.
+class DataDocument
+{
+public:
+
+    ///
+    /// The number identifying the serialized form of a document.
+    static const uint32_t Signature;
+
+    ///
+    /// The version of the serialized form of a document.
+    static const uint32_t Version;
+
+    ///
+    /// Constructs an empty document with a null root value.
+    DataDocument();
+
+    ///
+    /// Constructs a document from a data value.
+    ///
+    /// \param dataValue The data value to build the document from.
+    DataDocument(const DataValue& dataValue);
+
+    ///
+    /// Constructs a document moved from another.
+    ///
+    /// \param document The document to move.
+    DataDocument(DataDocument&& document);
+
+    ///
+    /// Returns the root value.
+    DataDocumentValue root() const;
+
+    ///
+    /// Returns the raw memory of the document.
+    const uint8_t* data() const;
+
+    ///
+    /// Returns the size of the raw memory of the document in bytes.
+    size_t dataSize() const;
+
+    ///
+    /// Saves the document to a stream.
+    ///
+    /// \remarks The raw memory of the document is written as is.
+    ///
+    /// \param stream The stream to write to.
+    void save(WriteStream& stream) const;
+
+    ///
+    /// Loads the document from a stream.
+    ///
+    /// \param stream The stream to read from.
+    ///
+    /// \throws Error If the stream does not contain a valid document.
+    void load(ReadStream& stream);
+
+    ///
+    /// Replaces the document with one built from a data value.
+    ///
+    /// \param dataValue The data value to build the document from.
+    ///
+    /// \returns A reference to the document.
+    DataDocument& operator=(const DataValue& dataValue);
+
+    ///
+    /// Replaces the document with one moved from another.
+    ///
+    /// \param document The document to move.
+    ///
+    /// \returns A reference to the document.
+    DataDocument& operator=(DataDocument&& document);
+
+private:
+    void _build(const DataValue& dataValue);
+    void _validate() const;
+
+    std::vector<uint8_t> _data;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+void AssetLoader<DataDocument>::load(DataDocument& document, const Path& assetPath, AssetCache& assetCache)
+{
+    FileReadStream stream = assetCache.fileSystem().openFileForRead(assetPath);
+
+    // Detect whether the file is a saved document, binary, or JSON
+    uint32_t signature = 0;
+    if (stream.length() >= sizeof(uint32_t))
+    {
+        signature = stream.readUnsignedInt();
+        stream.seek(0);
+    }
+
+    if (signature == DataDocument::Signature)
+    {
+        document.load(stream);
+    }
+    else if (signature == DataValueBinaryFormat::Signature)
+    {
+        DataValue dataValue;
+        DataValueBinaryFormat::load(dataValue, stream);
+        document = dataValue;
+    }
+    else
+    {
+        DataValue dataValue;
+        DataValueJsonFormat::load(dataValue, stream);
+        document = dataValue;
+    }
+}
\ No newline at end of file
@@ -426,6 +426,23 @@ const DataValue& DataValue::operator[](const std::string& name) const
     }
 }
 
+const DataValue& DataValue::at(const DataValuePath& path) const
+{
+    const DataValue* value = this;
+    for (size_t i = 0; i < path.size() && !value->isNull(); ++i)
+    {
+        if (path.isIndex(i) && value->isArray())
+        {
+            value = &(*value)[path.index(i)];
+        }
+        else
+        {
+            value = &(*value)[path.name(i)];
+        }
+    }
+    return *value;
+}
+
 DataValue::Array::const_iterator DataValue::begin() const
 {
     if (isArray())
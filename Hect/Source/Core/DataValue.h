@@ -281,6 +281,13 @@ public:
     /// \param name The name of the member to access.
     const DataValue& operator[](const std::string& name) const;
 
+    ///
+    /// Returns the value at the given path relative to this value (null if
+    /// there is no value at the path).
+    ///
+    /// \param path The path to the value.
+    const DataValue& at(const DataValuePath& path) const;
+
     ///
     /// Returns an iterator at the beginning of the elements.
     ///
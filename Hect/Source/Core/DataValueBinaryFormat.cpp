@@ -0,0 +1,790 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+namespace
+{
+
+const uint8_t version = 2;
+const uint8_t keyDictionaryFlag = 0x01;
+
+// The byte preceding each encoded value
+enum Tag
+{
+    NullTag = 0x00,
+    FalseTag = 0x01,
+    TrueTag = 0x02,
+    Int8Tag = 0x03,
+    Int16Tag = 0x04,
+    Int32Tag = 0x05,
+    Float32Tag = 0x06,
+    Float64Tag = 0x07,
+    StringTag = 0x08,
+    ArrayTag = 0x09,
+    ObjectTag = 0x0A,
+
+    // Integers from 0 to 127 are stored in the tag itself
+    FixIntTag = 0x80
+};
+
+void checkRange(const uint8_t* position, const uint8_t* end, uint64_t size)
+{
+    if (position > end || (uint64_t)(end - position) < size)
+    {
+        throw Error("Binary data value is truncated");
+    }
+}
+
+uint64_t decodeVarUnsignedInt(const uint8_t*& position, const uint8_t* end)
+{
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        checkRange(position, end, 1);
+        uint8_t byte = *position++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return value;
+        }
+    }
+
+    throw Error("Variable length integer is too long");
+}
+
+template <typename T>
+T decodeScalar(const uint8_t* position, const uint8_t* end)
+{
+    checkRange(position, end, sizeof(T));
+
+    // Copy to avoid unaligned reads
+    T value;
+    std::memcpy(&value, position, sizeof(T));
+    return value;
+}
+
+// Decodes a length-prefixed string and returns the position after it
+const uint8_t* decodeString(const uint8_t* position, const uint8_t* end, const char*& string, size_t& length)
+{
+    length = (size_t)decodeVarUnsignedInt(position, end);
+    checkRange(position, end, length);
+    string = (const char*)position;
+    return position + length;
+}
+
+void collectKeys(const DataValue& dataValue, std::map<std::string, uint32_t>& keys)
+{
+    if (dataValue.isArray())
+    {
+        for (const DataValue& element : dataValue)
+        {
+            collectKeys(element, keys);
+        }
+    }
+    else if (dataValue.isObject())
+    {
+        for (const std::string& name : dataValue.memberNames())
+        {
+            keys[name] = 0;
+            collectKeys(dataValue[name], keys);
+        }
+    }
+}
+
+// Encodes data values directly to a stream
+class Encoder
+{
+public:
+    Encoder(WriteStream& stream, const std::map<std::string, uint32_t>* keys) :
+        _stream(&stream),
+        _keys(keys)
+    {
+    }
+
+    void encode(const DataValue& dataValue)
+    {
+        switch (dataValue.type())
+        {
+        case DataValueType::Bool:
+            _stream->writeUnsignedByte(dataValue.asBool() ? TrueTag : FalseTag);
+            break;
+        case DataValueType::Number:
+            _encodeNumber(dataValue.asDouble());
+            break;
+        case DataValueType::String:
+            _stream->writeUnsignedByte(StringTag);
+            _encodeString(dataValue.asString());
+            break;
+        case DataValueType::Array:
+        {
+            _stream->writeUnsignedByte(ArrayTag);
+            size_t sizePosition = _beginContainer();
+            _stream->writeVarUnsignedInt(dataValue.size());
+            for (const DataValue& element : dataValue)
+            {
+                encode(element);
+            }
+            _endContainer(sizePosition);
+            break;
+        }
+        case DataValueType::Object:
+        {
+            _stream->writeUnsignedByte(ObjectTag);
+            size_t sizePosition = _beginContainer();
+            _stream->writeVarUnsignedInt(dataValue.size());
+            for (const std::string& name : dataValue.memberNames())
+            {
+                if (_keys)
+                {
+                    _stream->writeVarUnsignedInt((*_keys).find(name)->second);
+                }
+                else
+                {
+                    _encodeString(name);
+                }
+                encode(dataValue[name]);
+            }
+            _endContainer(sizePosition);
+            break;
+        }
+        default:
+            _stream->writeUnsignedByte(NullTag);
+        }
+    }
+
+private:
+    // Writes a placeholder for the encoded size of a container and returns
+    // its position
+    size_t _beginContainer()
+    {
+        size_t sizePosition = _stream->position();
+        _stream->writeUnsignedInt(0);
+        return sizePosition;
+    }
+
+    // Writes the encoded size of the container begun at the given position
+    void _endContainer(size_t sizePosition)
+    {
+        size_t endPosition = _stream->position();
+        size_t size = endPosition - sizePosition - sizeof(uint32_t);
+        if ((uint64_t)size > UINT32_MAX)
+        {
+            throw Error("Binary data value container is too large");
+        }
+
+        _stream->seek(sizePosition);
+        _stream->writeUnsignedInt((uint32_t)size);
+        _stream->seek(endPosition);
+    }
+
+    void _encodeNumber(double value)
+    {
+        // Use the smallest type which represents the number exactly
+        bool negativeZero = value == 0.0 && 1.0 / value < 0.0;
+        if (!negativeZero && value == std::floor(value) && value >= INT32_MIN && value <= INT32_MAX)
+        {
+            int32_t integer = (int32_t)value;
+            if (integer >= 0 && integer < 128)
+            {
+                _stream->writeUnsignedByte((uint8_t)(FixIntTag | integer));
+            }
+            else if (integer >= INT8_MIN && integer <= INT8_MAX)
+            {
+                _stream->writeUnsignedByte(Int8Tag);
+                _stream->writeByte((int8_t)integer);
+            }
+            else if (integer >= INT16_MIN && integer <= INT16_MAX)
+            {
+                _stream->writeUnsignedByte(Int16Tag);
+                _stream->writeShort((int16_t)integer);
+            }
+            else
+            {
+                _stream->writeUnsignedByte(Int32Tag);
+                _stream->writeInt(integer);
+            }
+        }
+        else if ((double)(float)value == value)
+        {
+            _stream->writeUnsignedByte(Float32Tag);
+            _stream->writeFloat((float)value);
+        }
+        else
+        {
+            _stream->writeUnsignedByte(Float64Tag);
+            _stream->writeDouble(value);
+        }
+    }
+
+    void _encodeString(const std::string& string)
+    {
+        _stream->writeVarUnsignedInt(string.size());
+        _stream->writeString(string, false);
+    }
+
+    WriteStream* _stream;
+    const std::map<std::string, uint32_t>* _keys;
+};
+
+}
+
+DataValueBinaryView DataValueBinaryView::Iterator::operator*() const
+{
+    return _value;
+}
+
+DataValueBinaryView::Iterator& DataValueBinaryView::Iterator::operator++()
+{
+    if (_remaining > 0)
+    {
+        _value._value = _value._skip();
+        --_remaining;
+    }
+    return *this;
+}
+
+bool DataValueBinaryView::Iterator::operator==(const Iterator& iterator) const
+{
+    return _remaining == iterator._remaining;
+}
+
+bool DataValueBinaryView::Iterator::operator!=(const Iterator& iterator) const
+{
+    return _remaining != iterator._remaining;
+}
+
+DataValueBinaryView::Iterator::Iterator(const DataValueBinaryView& value, size_t remaining) :
+    _value(value),
+    _remaining(remaining)
+{
+}
+
+DataValueBinaryView::DataValueBinaryView() :
+    _value(nullptr),
+    _end(nullptr)
+{
+}
+
+DataValueBinaryView::DataValueBinaryView(const uint8_t* data, size_t size) :
+    _value(nullptr),
+    _end(data + size)
+{
+    const uint8_t* position = data;
+
+    // Header
+    if (decodeScalar<uint32_t>(position, _end) != DataValueBinaryFormat::Signature)
+    {
+        throw Error("The data is not in the binary data value format");
+    }
+    position += sizeof(uint32_t);
+
+    uint8_t dataVersion = decodeScalar<uint8_t>(position++, _end);
+    if (dataVersion != version)
+    {
+        throw Error(format("Unsupported binary data value version %d", dataVersion));
+    }
+
+    uint8_t flags = decodeScalar<uint8_t>(position++, _end);
+
+    // Key dictionary
+    if (flags & keyDictionaryFlag)
+    {
+        size_t dictionaryCount = (size_t)decodeVarUnsignedInt(position, _end);
+
+        // Each entry is at least one byte long
+        checkRange(position, _end, dictionaryCount);
+
+        // Decode the entries once so each key is looked up by index
+        std::shared_ptr<std::vector<Key>> dictionary(new std::vector<Key>(dictionaryCount));
+        for (Key& key : *dictionary)
+        {
+            position = decodeString(position, _end, key.name, key.length);
+        }
+        _dictionary = dictionary;
+    }
+
+    // Root value
+    checkRange(position, _end, 1);
+    _value = position;
+}
+
+DataValueType DataValueBinaryView::type() const
+{
+    if (!_value)
+    {
+        return DataValueType::Null;
+    }
+
+    uint8_t tag = *_value;
+    if (tag & FixIntTag)
+    {
+        return DataValueType::Number;
+    }
+
+    switch (tag)
+    {
+    case FalseTag:
+    case TrueTag:
+        return DataValueType::Bool;
+    case Int8Tag:
+    case Int16Tag:
+    case Int32Tag:
+    case Float32Tag:
+    case Float64Tag:
+        return DataValueType::Number;
+    case StringTag:
+        return DataValueType::String;
+    case ArrayTag:
+        return DataValueType::Array;
+    case ObjectTag:
+        return DataValueType::Object;
+    default:
+        return DataValueType::Null;
+    }
+}
+
+bool DataValueBinaryView::isNull() const
+{
+    return type() == DataValueType::Null;
+}
+
+bool DataValueBinaryView::isBool() const
+{
+    return type() == DataValueType::Bool;
+}
+
+bool DataValueBinaryView::isNumber() const
+{
+    return type() == DataValueType::Number;
+}
+
+bool DataValueBinaryView::isString() const
+{
+    return type() == DataValueType::String;
+}
+
+bool DataValueBinaryView::isArray() const
+{
+    return type() == DataValueType::Array;
+}
+
+bool DataValueBinaryView::isObject() const
+{
+    return type() == DataValueType::Object;
+}
+
+bool DataValueBinaryView::asBool() const
+{
+    return _value && *_value == TrueTag;
+}
+
+int DataValueBinaryView::asInt() const
+{
+    return (int)asDouble();
+}
+
+unsigned DataValueBinaryView::asUnsigned() const
+{
+    return (unsigned)asDouble();
+}
+
+double DataValueBinaryView::asDouble() const
+{
+    if (!_value)
+    {
+        return 0.0;
+    }
+
+    uint8_t tag = *_value;
+    if (tag & FixIntTag)
+    {
+        return (double)(tag & ~FixIntTag);
+    }
+
+    const uint8_t* position = _value + 1;
+    switch (tag)
+    {
+    case Int8Tag:
+        return (double)decodeScalar<int8_t>(position, _end);
+    case Int16Tag:
+        return (double)decodeScalar<int16_t>(position, _end);
+    case Int32Tag:
+        return (double)decodeScalar<int32_t>(position, _end);
+    case Float32Tag:
+        return (double)decodeScalar<float>(position, _end);
+    case Float64Tag:
+        return decodeScalar<double>(position, _end);
+    default:
+        return 0.0;
+    }
+}
+
+std::string DataValueBinaryView::asString() const
+{
+    return std::string(stringData() ? stringData() : "", stringLength());
+}
+
+const char* DataValueBinaryView::stringData() const
+{
+    if (!isString())
+    {
+        return nullptr;
+    }
+
+    const char* string;
+    size_t length;
+    decodeString(_value + 1, _end, string, length);
+    return string;
+}
+
+size_t DataValueBinaryView::stringLength() const
+{
+    if (!isString())
+    {
+        return 0;
+    }
+
+    const char* string;
+    size_t length;
+    decodeString(_value + 1, _end, string, length);
+    return length;
+}
+
+size_t DataValueBinaryView::size() const
+{
+    size_t count = 0;
+    _children(count);
+    return count;
+}
+
+std::string DataValueBinaryView::memberName(size_t index) const
+{
+    size_t count = 0;
+    const uint8_t* position = _children(count);
+    if (!isObject() || index >= count)
+    {
+        return std::string();
+    }
+
+    // Skip the members before the index
+    const char* name;
+    size_t length;
+    for (size_t i = 0; i < index; ++i)
+    {
+        position = _key(position, name, length);
+        position = _at(position)._skip();
+    }
+
+    _key(position, name, length);
+    return std::string(name, length);
+}
+
+DataValueBinaryView DataValueBinaryView::memberValue(size_t index) const
+{
+    size_t count = 0;
+    const uint8_t* position = _children(count);
+    if (!isObject() || index >= count)
+    {
+        return DataValueBinaryView();
+    }
+
+    // Skip the members before the index
+    const char* name;
+    size_t length;
+    for (size_t i = 0; i < index; ++i)
+    {
+        position = _key(position, name, length);
+        position = _at(position)._skip();
+    }
+
+    return _at(_key(position, name, length));
+}
+
+DataValueBinaryView DataValueBinaryView::member(const char* name) const
+{
+    size_t count = 0;
+    const uint8_t* position = _children(count);
+    if (!isObject())
+    {
+        return DataValueBinaryView();
+    }
+
+    size_t nameLength = std::strlen(name);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const char* key;
+        size_t keyLength;
+        position = _key(position, key, keyLength);
+
+        DataValueBinaryView value = _at(position);
+        if (keyLength == nameLength && std::memcmp(key, name, nameLength) == 0)
+        {
+            return value;
+        }
+        position = value._skip();
+    }
+
+    return DataValueBinaryView();
+}
+
+DataValue DataValueBinaryView::toDataValue() const
+{
+    switch (type())
+    {
+    case DataValueType::Bool:
+        return DataValue(asBool());
+    case DataValueType::Number:
+        return DataValue(asDouble());
+    case DataValueType::String:
+        return DataValue(asString());
+    case DataValueType::Array:
+    {
+        DataValue dataValue(DataValueType::Array);
+        for (DataValueBinaryView element : *this)
+        {
+            dataValue.addElement(element.toDataValue());
+        }
+        return dataValue;
+    }
+    case DataValueType::Object:
+    {
+        DataValue dataValue(DataValueType::Object);
+
+        size_t count = 0;
+        const uint8_t* position = _children(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const char* name;
+            size_t length;
+            position = _key(position, name, length);
+
+            DataValueBinaryView value = _at(position);
+            dataValue.addMember(std::string(name, length), value.toDataValue());
+            position = value._skip();
+        }
+        return dataValue;
+    }
+    default:
+        return DataValue();
+    }
+}
+
+DataValueBinaryView DataValueBinaryView::operator[](size_t index) const
+{
+    size_t count = 0;
+    const uint8_t* position = _children(count);
+    if (!isArray() || index >= count)
+    {
+        return DataValueBinaryView();
+    }
+
+    // Skip the elements before the index
+    for (size_t i = 0; i < index; ++i)
+    {
+        position = _at(position)._skip();
+    }
+
+    return _at(position);
+}
+
+DataValueBinaryView DataValueBinaryView::operator[](const std::string& name) const
+{
+    return member(name.c_str());
+}
+
+DataValueBinaryView DataValueBinaryView::at(const DataValuePath& path) const
+{
+    DataValueBinaryView value = *this;
+    for (size_t i = 0; i < path.size() && !value.isNull(); ++i)
+    {
+        if (path.isIndex(i) && value.isArray())
+        {
+            value = value[path.index(i)];
+        }
+        else
+        {
+            value = value.member(path.name(i).c_str());
+        }
+    }
+    return value;
+}
+
+DataValueBinaryView::Iterator DataValueBinaryView::begin() const
+{
+    size_t count = 0;
+    const uint8_t* position = _children(count);
+    if (!isArray())
+    {
+        return Iterator(DataValueBinaryView(), 0);
+    }
+
+    return Iterator(_at(position), count);
+}
+
+DataValueBinaryView::Iterator DataValueBinaryView::end() const
+{
+    return Iterator(DataValueBinaryView(), 0);
+}
+
+const uint8_t* DataValueBinaryView::_skip() const
+{
+    checkRange(_value, _end, 1);
+
+    uint8_t tag = *_value;
+    if (tag & FixIntTag)
+    {
+        return _value + 1;
+    }
+
+    switch (tag)
+    {
+    case NullTag:
+    case FalseTag:
+    case TrueTag:
+        return _value + 1;
+    case Int8Tag:
+        return _value + 2;
+    case Int16Tag:
+        return _value + 3;
+    case Int32Tag:
+    case Float32Tag:
+        return _value + 5;
+    case Float64Tag:
+        return _value + 9;
+    case StringTag:
+    {
+        const char* string;
+        size_t length;
+        return decodeString(_value + 1, _end, string, length);
+    }
+    case ArrayTag:
+    case ObjectTag:
+    {
+        // Containers are prefixed with their encoded size so they are
+        // skipped without visiting their descendants
+        uint32_t size = decodeScalar<uint32_t>(_value + 1, _end);
+        const uint8_t* position = _value + 1 + sizeof(uint32_t);
+        checkRange(position, _end, size);
+        return position + size;
+    }
+    default:
+        throw Error(format("Binary data value contains an invalid tag %d", tag));
+    }
+}
+
+const uint8_t* DataValueBinaryView::_children(size_t& count) const
+{
+    count = 0;
+    if (!_value || (*_value != ArrayTag && *_value != ObjectTag))
+    {
+        return nullptr;
+    }
+
+    // Skip the encoded size of the container
+    const uint8_t* position = _value + 1 + sizeof(uint32_t);
+    count = (size_t)decodeVarUnsignedInt(position, _end);
+    return position;
+}
+
+const uint8_t* DataValueBinaryView::_key(const uint8_t* position, const char*& name, size_t& length) const
+{
+    if (_dictionary)
+    {
+        size_t index = (size_t)decodeVarUnsignedInt(position, _end);
+        if (index >= _dictionary->size())
+        {
+            throw Error("Binary data value references an invalid key");
+        }
+
+        const Key& key = (*_dictionary)[index];
+        name = key.name;
+        length = key.length;
+        return position;
+    }
+    else
+    {
+        return decodeString(position, _end, name, length);
+    }
+}
+
+DataValueBinaryView DataValueBinaryView::_at(const uint8_t* position) const
+{
+    checkRange(position, _end, 1);
+
+    DataValueBinaryView value(*this);
+    value._value = position;
+    return value;
+}
+
+const uint32_t DataValueBinaryFormat::Signature = 0xFE03;
+const char* const DataValueBinaryFormat::Extension = "bin";
+
+void DataValueBinaryFormat::save(const DataValue& dataValue, WriteStream& stream, bool keyDictionary)
+{
+    // Header
+    stream.writeUnsignedInt(Signature);
+    stream.writeUnsignedByte(version);
+    stream.writeUnsignedByte(keyDictionary ? keyDictionaryFlag : 0);
+
+    // Key dictionary
+    std::map<std::string, uint32_t> keys;
+    if (keyDictionary)
+    {
+        collectKeys(dataValue, keys);
+        stream.writeVarUnsignedInt(keys.size());
+
+        uint32_t index = 0;
+        for (auto& pair : keys)
+        {
+            pair.second = index++;
+            stream.writeVarUnsignedInt(pair.first.size());
+            stream.writeString(pair.first, false);
+        }
+    }
+
+    // Root value
+    Encoder encoder(stream, keyDictionary ? &keys : nullptr);
+    encoder.encode(dataValue);
+}
+
+void DataValueBinaryFormat::load(DataValue& dataValue, const uint8_t* data, size_t size)
+{
+    DataValueBinaryView view(data, size);
+    dataValue = view.toDataValue();
+}
+
+void DataValueBinaryFormat::load(DataValue& dataValue, ReadStream& stream)
+{
+    size_t size = stream.length() - stream.position();
+    if (size == 0)
+    {
+        throw Error("The data is not in the binary data value format");
+    }
+
+    std::vector<uint8_t> data(size);
+    stream.readBytes(&data[0], size);
+    load(dataValue, &data[0], size);
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A read-only view of a data value encoded in the binary data value format.
+///
+/// \remarks A view decodes directly from the encoded memory as it is accessed;
+/// no part of the data value tree is materialized unless toDataValue() is
+/// called.  Accessing an element or member skips over the values before it
+/// (without visiting their descendants), so iterating using begin() and end()
+/// is preferred over indexing when visiting every element.  A view is only valid for the lifetime of the
+/// memory it was constructed from (which may be a memory-mapped file).
+class DataValueBinaryView
+{
+public:
+
+    class Iterator;
+
+    ///
+    /// Constructs a null view.
+    DataValueBinaryView();
+
+    ///
+    /// Constructs a view of the root value of encoded data.
+    ///
+    /// \param data The encoded data.
+    /// \param size The size of the encoded data in bytes.
+    ///
+    /// \throws Error If the data does not begin with a valid header.
+    DataValueBinaryView(const uint8_t* data, size_t size);
+
+    ///
+    /// Returns the type.
+    DataValueType type() const;
+
+    ///
+    /// Returns whether the value is null.
+    bool isNull() const;
+
+    ///
+    /// Returns whether the value is a bool.
+    bool isBool() const;
+
+    ///
+    /// Returns whether the value is a number.
+    bool isNumber() const;
+
+    ///
+    /// Returns whether the value is a string.
+    bool isString() const;
+
+    ///
+    /// Returns whether the value is an array.
+    bool isArray() const;
+
+    ///
+    /// Returns whether the value is an object.
+    bool isObject() const;
+
+    ///
+    /// Returns the value as a bool (false if the value is not a bool).
+    bool asBool() const;
+
+    ///
+    /// Returns the value as an int (zero if the value is not a number).
+    int asInt() const;
+
+    ///
+    /// Returns the value as an unsigned int (zero if the value is not a
+    /// number).
+    unsigned asUnsigned() const;
+
+    ///
+    /// Returns the value as a double (zero if the value is not a number).
+    double asDouble() const;
+
+    ///
+    /// Returns a copy of the value as a string (empty string if the value is
+    /// not a string).
+    std::string asString() const;
+
+    ///
+    /// Returns a pointer to the encoded characters of a string value (null if
+    /// the value is not a string).
+    ///
+    /// \remarks The characters are not null-terminated; use stringLength().
+    const char* stringData() const;
+
+    ///
+    /// Returns the length of a string value (zero if the value is not a
+    /// string).
+    size_t stringLength() const;
+
+    ///
+    /// Returns the number of elements or members.
+    size_t size() const;
+
+    ///
+    /// Returns a copy of the name of the member at the given index (empty
+    /// string if the value is not an object or the index is out of range).
+    ///
+    /// \param index The index of the member.
+    std::string memberName(size_t index) const;
+
+    ///
+    /// Returns the value of the member at the given index.
+    ///
+    /// \param index The index of the member.
+    DataValueBinaryView memberValue(size_t index) const;
+
+    ///
+    /// Returns the member of the given name (null if the value is not an
+    /// object or has no member of the name).
+    ///
+    /// \param name The name of the member to access.
+    DataValueBinaryView member(const char* name) const;
+
+    ///
+    /// Decodes this value and all of its descendants into a data value.
+    DataValue toDataValue() const;
+
+    ///
+    /// Returns the element at the given index.
+    ///
+    /// \remarks Only applies to values that are arrays.
+    ///
+    /// \param index The index to access the element at.
+    DataValueBinaryView operator[](size_t index) const;
+
+    ///
+    /// Returns the member of the given name.
+    ///
+    /// \remarks Only applies to values that are objects.
+    ///
+    /// \param name The name of the member to access.
+    DataValueBinaryView operator[](const std::string& name) const;
+
+    ///
+    /// Returns the value at the given path relative to this value (null if
+    /// there is no value at the path).
+    ///
+    /// \param path The path to the value.
+    DataValueBinaryView at(const DataValuePath& path) const;
+
+    ///
+    /// Returns an iterator at the beginning of the elements.
+    ///
+    /// \remarks Only applies to values that are arrays.
+    Iterator begin() const;
+
+    ///
+    /// Returns an iterator at the end of the elements.
+    ///
+    /// \remarks Only applies to values that are arrays.
+    Iterator end() const;
+
+private:
+    struct Key
+    {
+        const char* name;
+        size_t length;
+    };
+
+    const uint8_t* _skip() const;
+    const uint8_t* _children(size_t& count) const;
+    const uint8_t* _key(const uint8_t* position, const char*& name, size_t& length) const;
+    DataValueBinaryView _at(const uint8_t* position) const;
+
+    const uint8_t* _value;
+    const uint8_t* _end;
+
+    // The key dictionary is decoded once when the root view is constructed
+    // and shared by every view of the data
+    std::shared_ptr<const std::vector<Key>> _dictionary;
+};
+
+///
+/// Iterates over the elements of an array value.
+class DataValueBinaryView::Iterator
+{
+    friend class DataValueBinaryView;
+public:
+
+    ///
+    /// Returns the element the iterator is at.
+    DataValueBinaryView operator*() const;
+
+    ///
+    /// Moves the iterator to the next element.
+    Iterator& operator++();
+
+    ///
+    /// Returns whether the iterator is at the same element as another.
+    ///
+    /// \param iterator The other iterator.
+    bool operator==(const Iterator& iterator) const;
+
+    ///
+    /// Returns whether the iterator is at a different element than
+    /// another.
+    ///
+    /// \param iterator The other iterator.
+    bool operator!=(const Iterator& iterator) const;
+
+private:
+    Iterator(const DataValueBinaryView& value, size_t remaining);
+
+    DataValueBinaryView _value;
+    size_t _remaining;
+};
+
+///
+/// Provides the functionality for encoding data values in a compact binary
+/// format.
+///
+/// \remarks Numbers are stored in the smallest type which represents them
+/// exactly, strings are prefixed with their length, arrays/objects are
+/// prefixed with their encoded size and number of children, and
+/// member names may be stored once in a key dictionary at the beginning of
+/// the data.  Encoded data can be walked in place using a
+/// DataValueBinaryView.
+class DataValueBinaryFormat
+{
+public:
+
+    ///
+    /// The number identifying data in this format.
+    static const uint32_t Signature;
+
+    ///
+    /// The file extension of assets stored in this format.
+    static const char* const Extension;
+
+    ///
+    /// Saves a data value to a stream.
+    ///
+    /// \remarks The data value is encoded directly to the stream.
+    ///
+    /// \param dataValue The data value.
+    /// \param stream The stream to write to.
+    /// \param keyDictionary Whether to store each member name once in a key
+    /// dictionary instead of with each member.
+    static void save(const DataValue& dataValue, WriteStream& stream, bool keyDictionary = true);
+
+    ///
+    /// Loads a data value from encoded data.
+    ///
+    /// \param dataValue The data value to load to.
+    /// \param data The encoded data.
+    /// \param size The size of the encoded data in bytes.
+    ///
+    /// \throws Error If the data is invalid.
+    static void load(DataValue& dataValue, const uint8_t* data, size_t size);
+
+    ///
+    /// Loads a data value from a stream.
+    ///
+    /// \param dataValue The data value to load to.
+    /// \param stream The stream to read from.
+    ///
+    /// \throws Error If the data is invalid.
+    static void load(DataValue& dataValue, ReadStream& stream);
+};
+
+}
\ No newline at end of file
@@ -28,6 +28,22 @@ using namespace hect;
 void AssetLoader<DataValue>::load(DataValue& dataValue, const Path& assetPath, AssetCache& assetCache)
 {
     FileReadStream stream = assetCache.fileSystem().openFileForRead(assetPath);
-    std::string json = stream.readAllToString();
-    DataValueJsonFormat::load(dataValue, json);
+
+    // Detect whether the file is binary or JSON
+    uint32_t signature = 0;
+    if (stream.length() >= sizeof(uint32_t))
+    {
+        signature = stream.readUnsignedInt();
+        stream.seek(0);
+    }
+
+    if (signature == DataValueBinaryFormat::Signature)
+    {
+        DataValueBinaryFormat::load(dataValue, stream);
+    }
+    else
+    {
+        std::string json = stream.readAllToString();
+        DataValueJsonFormat::load(dataValue, json);
+    }
 }
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+DataValuePath::DataValuePath()
+{
+}
+
+DataValuePath::DataValuePath(const char* path)
+{
+    _parse(path);
+}
+
+DataValuePath::DataValuePath(const std::string& path)
+{
+    _parse(path.c_str());
+}
+
+size_t DataValuePath::size() const
+{
+    return _segments.size();
+}
+
+const std::string& DataValuePath::name(size_t index) const
+{
+    return _segments[index].name;
+}
+
+bool DataValuePath::isIndex(size_t index) const
+{
+    return _segments[index].isIndex;
+}
+
+size_t DataValuePath::index(size_t index) const
+{
+    return _segments[index].index;
+}
+
+std::string DataValuePath::toString() const
+{
+    std::string string;
+    for (const Segment& segment : _segments)
+    {
+        string += '/';
+        for (char c : segment.name)
+        {
+            if (c == '~')
+            {
+                string += "~0";
+            }
+            else if (c == '/')
+            {
+                string += "~1";
+            }
+            else
+            {
+                string += c;
+            }
+        }
+    }
+    return string;
+}
+
+void DataValuePath::_parse(const char* path)
+{
+    if (*path != '\0' && *path != '/')
+    {
+        throw Error(format("Invalid data value path '%s'", path));
+    }
+
+    const char* c = path;
+    while (*c == '/')
+    {
+        ++c;
+
+        Segment segment;
+        segment.isIndex = true;
+        segment.index = 0;
+
+        for (; *c != '\0' && *c != '/'; ++c)
+        {
+            char character = *c;
+            if (character == '~')
+            {
+                ++c;
+                if (*c == '0')
+                {
+                    character = '~';
+                }
+                else if (*c == '1')
+                {
+                    character = '/';
+                }
+                else
+                {
+                    throw Error(format("Invalid escape sequence in data value path '%s'", path));
+                }
+            }
+
+            // A segment is an index if it only contains digits without a
+            // leading zero
+            if (character < '0' || character > '9' || (segment.name == "0"))
+            {
+                segment.isIndex = false;
+            }
+            else if (segment.isIndex)
+            {
+                // An index too large to represent is treated as a name so it
+                // cannot wrap around to a valid index
+                if (segment.index > (SIZE_MAX - 9) / 10)
+                {
+                    segment.isIndex = false;
+                }
+                else
+                {
+                    segment.index = segment.index * 10 + (size_t)(character - '0');
+                }
+            }
+
+            segment.name += character;
+        }
+
+        if (segment.name.empty())
+        {
+            segment.isIndex = false;
+        }
+
+        _segments.push_back(std::move(segment));
+    }
+}
\ No newline at end of file
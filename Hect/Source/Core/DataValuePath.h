@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A path to a value nested within a data value (e.g.
+/// "/entities/12/Transform/position").
+///
+/// \remarks The syntax follows JSON pointers: each segment is preceded by a
+/// '/', "~1" escapes a '/' within a segment, and "~0" escapes a '~'.  A
+/// segment refers to an element if the value it is applied to is an array
+/// and to a member otherwise.  An empty path refers to the value itself.
+class DataValuePath
+{
+public:
+
+    ///
+    /// Constructs an empty path.
+    DataValuePath();
+
+    ///
+    /// Constructs a path from a string.
+    ///
+    /// \param path The path string.
+    ///
+    /// \throws Error If the path is invalid.
+    DataValuePath(const char* path);
+
+    ///
+    /// Constructs a path from a string.
+    ///
+    /// \param path The path string.
+    ///
+    /// \throws Error If the path is invalid.
+    DataValuePath(const std::string& path);
+
+    ///
+    /// Returns the number of segments.
+    size_t size() const;
+
+    ///
+    /// Returns the name of the segment at the given index.
+    ///
+    /// \param index The index of the segment.
+    const std::string& name(size_t index) const;
+
+    ///
+    /// Returns whether the segment at the given index is an element index.
+    ///
+    /// \param index The index of the segment.
+    bool isIndex(size_t index) const;
+
+    ///
+    /// Returns the element index of the segment at the given index.
+    ///
+    /// \param index The index of the segment.
+    size_t index(size_t index) const;
+
+    ///
+    /// Returns the path as a string.
+    std::string toString() const;
+
+private:
+    void _parse(const char* path);
+
+    struct Segment
+    {
+        std::string name;
+        bool isIndex;
+        size_t index;
+    };
+
+    std::vector<Segment> _segments;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// The 64-bit FNV-1a hash of no bytes.
+const uint64_t emptyHash = 14695981039346656037ull;
+
+///
+/// Returns the 64-bit FNV-1a hash of a sequence of bytes.
+///
+/// \remarks The hash is the same on every platform, so it may be stored.
+///
+/// \param data A pointer to the bytes.
+/// \param size The number of bytes.
+/// \param hash The hash to continue from.
+///
+/// \returns The hash.
+uint64_t hashBytes(const uint8_t* data, size_t size, uint64_t hash = emptyHash);
+
+///
+/// Returns the 64-bit FNV-1a hash of a string.
+///
+/// \param string The string.
+/// \param hash The hash to continue from.
+///
+/// \returns The hash.
+uint64_t hashString(const std::string& string, uint64_t hash = emptyHash);
+
+}
\ No newline at end of file
@@ -47,6 +47,8 @@ void LogicFlow::removeAllLayers()
 
 bool LogicFlow::update()
 {
+    _actionQueue.execute();
+
     _removeInactiveLayers();
 
     if (_layers.size() == 0)
@@ -81,6 +83,11 @@ bool LogicFlow::update()
     return true;
 }
 
+ActionQueue& LogicFlow::actionQueue()
+{
+    return _actionQueue;
+}
+
 void LogicFlow::_removeInactiveLayers()
 {
     // Build a list of inactive layers
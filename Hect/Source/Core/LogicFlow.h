@@ -30,7 +30,8 @@ namespace hect
 /// Manages a flow of logic layers.
 ///
 /// \remarks All layers in the flow are updated in the order in which they were
-/// added.  Inactive layers are removed from the flow.
+/// added.  Inactive layers are removed from the flow.  Asynchronous work can
+/// return to the thread updating the flow through the flow's action queue.
 class LogicFlow :
     public Uncopyable
 {
@@ -68,6 +69,11 @@ public:
     /// \returns True if there are layers in the flow; false otherwise.
     bool update();
 
+    ///
+    /// Returns the queue of actions executed at the start of each update
+    /// (on the thread updating the flow).
+    ActionQueue& actionQueue();
+
 private:
     void _removeInactiveLayers();
 
@@ -76,6 +82,8 @@ private:
     TimeSpan _accumulator;
     TimeSpan _delta;
 
+    ActionQueue _actionQueue;
+
     std::vector<LogicLayer*> _layers;
 };
 
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+namespace hect
+{
+
+template <typename T>
+MpscQueue<T>::MpscQueue(size_t capacity) :
+    _cells(nullptr),
+    _capacity(2),
+    _tail(0),
+    _head(0)
+{
+    // With a single slot the filled sequence of a lap would equal the free
+    // sequence of the next lap, so there are always at least two slots
+    while (_capacity < capacity)
+    {
+        _capacity <<= 1;
+    }
+
+    // A slot is free for the position equal to its sequence number
+    _cells = new Cell[_capacity];
+    for (size_t i = 0; i < _capacity; ++i)
+    {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue()
+{
+    delete[] _cells;
+}
+
+template <typename T>
+bool MpscQueue<T>::push(T item)
+{
+    return _push(item);
+}
+
+template <typename T>
+size_t MpscQueue<T>::push(T* items, size_t count)
+{
+    size_t pushCount = 0;
+    while (pushCount < count && _push(items[pushCount]))
+    {
+        ++pushCount;
+    }
+    return pushCount;
+}
+
+template <typename T>
+bool MpscQueue<T>::pop(T& item)
+{
+    size_t position = _head.load(std::memory_order_relaxed);
+    Cell& cell = _cells[position & (_capacity - 1)];
+
+    // The slot is filled once its sequence number is one past the position
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+    {
+        return false;
+    }
+
+    item = std::move(cell.item);
+    cell.item = T();
+
+    // Free the slot for the position of the next lap
+    cell.sequence.store(position + _capacity, std::memory_order_release);
+    _head.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+size_t MpscQueue<T>::pop(T* items, size_t maxCount)
+{
+    size_t popCount = 0;
+    while (popCount < maxCount && pop(items[popCount]))
+    {
+        ++popCount;
+    }
+    return popCount;
+}
+
+template <typename T>
+bool MpscQueue<T>::empty() const
+{
+    size_t position = _head.load(std::memory_order_relaxed);
+    return _cells[position & (_capacity - 1)].sequence.load(std::memory_order_acquire) != position + 1;
+}
+
+template <typename T>
+size_t MpscQueue<T>::capacity() const
+{
+    return _capacity;
+}
+
+template <typename T>
+bool MpscQueue<T>::_push(T& item)
+{
+    size_t position = _tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;)
+    {
+        cell = &_cells[position & (_capacity - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+        // Compare the signed difference so the comparison holds when the
+        // counters wrap around
+        intptr_t difference = (intptr_t)(sequence - position);
+        if (difference == 0)
+        {
+            // The slot is free so try to claim the position
+            if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The slot still holds the item from the previous lap
+            return false;
+        }
+        else
+        {
+            // Another producer claimed the position
+            position = _tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->item = std::move(item);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+}
\ No newline at end of file
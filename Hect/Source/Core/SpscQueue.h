@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A bounded lock-free queue where one thread (the producer) pushes items
+/// and one thread (the consumer) pops them.
+///
+/// \remarks The items are stored in a ring buffer allocated once when the
+/// queue is constructed.  The items must be default constructible and
+/// movable.
+template <typename T>
+class SpscQueue :
+    public Uncopyable
+{
+public:
+
+    ///
+    /// Constructs an empty queue.
+    ///
+    /// \param capacity The maximum number of items in the queue (rounded up
+    /// to a power of two).
+    SpscQueue(size_t capacity = 1024);
+
+    ///
+    /// Pushes an item to the back of the queue.
+    ///
+    /// \warning Must only be called from the producing thread.
+    ///
+    /// \param item The item to push.
+    ///
+    /// \returns True if the item was pushed; false if the queue was full.
+    bool push(T item);
+
+    ///
+    /// Pushes as many items as fit to the back of the queue.
+    ///
+    /// \warning Must only be called from the producing thread.
+    ///
+    /// \param items The items to push (moved from if pushed).
+    /// \param count The number of items.
+    ///
+    /// \returns The number of items pushed.
+    size_t push(T* items, size_t count);
+
+    ///
+    /// Pops the item at the front of the queue.
+    ///
+    /// \warning Must only be called from the consuming thread.
+    ///
+    /// \param item The popped item.
+    ///
+    /// \returns True if an item was popped; false if the queue was empty.
+    bool pop(T& item);
+
+    ///
+    /// Pops up to a number of items from the front of the queue.
+    ///
+    /// \warning Must only be called from the consuming thread.
+    ///
+    /// \param items The array to move the popped items to.
+    /// \param maxCount The maximum number of items to pop.
+    ///
+    /// \returns The number of items popped.
+    size_t pop(T* items, size_t maxCount);
+
+    ///
+    /// Returns whether the queue appears to be empty.
+    ///
+    /// \remarks The result may be stale by the time it is used.
+    bool empty() const;
+
+    ///
+    /// Returns the maximum number of items in the queue.
+    size_t capacity() const;
+
+private:
+    std::vector<T> _items;
+    size_t _mask;
+
+    // The producer and consumer positions are kept on separate cache lines
+    // along with the producer's and consumer's last seen copy of the other's
+    // position
+    char _padding0[64];
+    std::atomic<size_t> _tail;
+    size_t _cachedHead;
+    char _padding1[64];
+    std::atomic<size_t> _head;
+    size_t _cachedTail;
+    char _padding2[64];
+};
+
+}
+
+#include "SpscQueue.inl"
\ No newline at end of file
@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+namespace hect
+{
+
+template <typename T>
+SpscQueue<T>::SpscQueue(size_t capacity) :
+    _tail(0),
+    _cachedHead(0),
+    _head(0),
+    _cachedTail(0)
+{
+    size_t roundedCapacity = 1;
+    while (roundedCapacity < capacity)
+    {
+        roundedCapacity <<= 1;
+    }
+
+    _items.resize(roundedCapacity);
+    _mask = roundedCapacity - 1;
+}
+
+template <typename T>
+bool SpscQueue<T>::push(T item)
+{
+    return push(&item, 1) == 1;
+}
+
+template <typename T>
+size_t SpscQueue<T>::push(T* items, size_t count)
+{
+    size_t tail = _tail.load(std::memory_order_relaxed);
+
+    // Only reload the consumer's position if the queue looks too full
+    if (_items.size() - (tail - _cachedHead) < count)
+    {
+        _cachedHead = _head.load(std::memory_order_acquire);
+    }
+
+    size_t pushCount = std::min(count, _items.size() - (tail - _cachedHead));
+    for (size_t i = 0; i < pushCount; ++i)
+    {
+        _items[(tail + i) & _mask] = std::move(items[i]);
+    }
+
+    if (pushCount > 0)
+    {
+        _tail.store(tail + pushCount, std::memory_order_release);
+    }
+
+    return pushCount;
+}
+
+template <typename T>
+bool SpscQueue<T>::pop(T& item)
+{
+    return pop(&item, 1) == 1;
+}
+
+template <typename T>
+size_t SpscQueue<T>::pop(T* items, size_t maxCount)
+{
+    size_t head = _head.load(std::memory_order_relaxed);
+
+    // Only reload the producer's position if the queue looks too empty
+    if (_cachedTail - head < maxCount)
+    {
+        _cachedTail = _tail.load(std::memory_order_acquire);
+    }
+
+    size_t popCount = std::min(maxCount, _cachedTail - head);
+    for (size_t i = 0; i < popCount; ++i)
+    {
+        T& slot = _items[(head + i) & _mask];
+        items[i] = std::move(slot);
+        slot = T();
+    }
+
+    if (popCount > 0)
+    {
+        _head.store(head + popCount, std::memory_order_release);
+    }
+
+    return popCount;
+}
+
+template <typename T>
+bool SpscQueue<T>::empty() const
+{
+    return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+}
+
+template <typename T>
+size_t SpscQueue<T>::capacity() const
+{
+    return _items.size();
+}
+
+}
\ No newline at end of file
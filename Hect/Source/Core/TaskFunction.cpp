@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+TaskFunction::TaskFunction() :
+    _operations(nullptr)
+{
+}
+
+TaskFunction::TaskFunction(TaskFunction&& function) :
+    _operations(function._operations)
+{
+    if (_operations)
+    {
+        _operations->move(function._storage, _storage);
+        function._operations = nullptr;
+    }
+}
+
+TaskFunction::~TaskFunction()
+{
+    _reset();
+}
+
+void TaskFunction::operator()()
+{
+    if (!_operations)
+    {
+        throw Error("Task function is empty");
+    }
+
+    _operations->invoke(_storage);
+}
+
+bool TaskFunction::isEmpty() const
+{
+    return _operations == nullptr;
+}
+
+TaskFunction& TaskFunction::operator=(TaskFunction&& function)
+{
+    if (this != &function)
+    {
+        _reset();
+
+        _operations = function._operations;
+        if (_operations)
+        {
+            _operations->move(function._storage, _storage);
+            function._operations = nullptr;
+        }
+    }
+
+    return *this;
+}
+
+void TaskFunction::_reset()
+{
+    if (_operations)
+    {
+        _operations->destroy(_storage);
+        _operations = nullptr;
+    }
+}
\ No newline at end of file
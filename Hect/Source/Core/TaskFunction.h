@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A move-only function taking no arguments and returning nothing.
+///
+/// \remarks Functions (including lambdas and their captures) which fit
+/// within the inline storage are stored without allocating memory.
+class TaskFunction
+{
+public:
+
+    ///
+    /// The number of bytes available for storing a function inline.
+    static const size_t InlineStorageSize = 64;
+
+    ///
+    /// Constructs an empty task function.
+    TaskFunction();
+
+    ///
+    /// Constructs a task function from a callable object.
+    ///
+    /// \param function The callable object.
+    template <typename T>
+    TaskFunction(T function);
+
+    ///
+    /// Constructs a task function moved from another.
+    ///
+    /// \param function The task function to move.
+    TaskFunction(TaskFunction&& function);
+
+    ~TaskFunction();
+
+    ///
+    /// Calls the function.
+    ///
+    /// \throws Error If the task function is empty.
+    void operator()();
+
+    ///
+    /// Returns whether the task function is empty.
+    bool isEmpty() const;
+
+    ///
+    /// Replaces the function with one moved from another task function.
+    ///
+    /// \param function The task function to move.
+    ///
+    /// \returns A reference to the task function.
+    TaskFunction& operator=(TaskFunction&& function);
+
+private:
+    TaskFunction(const TaskFunction&);
+    TaskFunction& operator=(const TaskFunction&);
+
+    typedef std::aligned_storage<InlineStorageSize, 16>::type Storage;
+
+    struct Operations
+    {
+        void (*invoke)(Storage& storage);
+
+        // Move-constructs the function into the destination and destroys
+        // the source
+        void (*move)(Storage& source, Storage& destination);
+
+        void (*destroy)(Storage& storage);
+    };
+
+    template <typename T, bool Inline>
+    struct Implementation;
+
+    void _reset();
+
+    const Operations* _operations;
+    Storage _storage;
+};
+
+}
+
+#include "TaskFunction.inl"
\ No newline at end of file
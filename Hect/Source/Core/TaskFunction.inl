@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+namespace hect
+{
+
+// Stores the function within the task function's storage
+template <typename T>
+struct TaskFunction::Implementation<T, true>
+{
+    static void construct(Storage& storage, T&& function)
+    {
+        new (&storage) T(std::move(function));
+    }
+
+    static void invoke(Storage& storage)
+    {
+        (*reinterpret_cast<T*>(&storage))();
+    }
+
+    static void move(Storage& source, Storage& destination)
+    {
+        T& function = *reinterpret_cast<T*>(&source);
+        new (&destination) T(std::move(function));
+        function.~T();
+    }
+
+    static void destroy(Storage& storage)
+    {
+        reinterpret_cast<T*>(&storage)->~T();
+    }
+
+    static const Operations operations;
+};
+
+template <typename T>
+const TaskFunction::Operations TaskFunction::Implementation<T, true>::operations =
+{
+    &TaskFunction::Implementation<T, true>::invoke,
+    &TaskFunction::Implementation<T, true>::move,
+    &TaskFunction::Implementation<T, true>::destroy
+};
+
+// Stores a pointer to the function allocated on the heap
+template <typename T>
+struct TaskFunction::Implementation<T, false>
+{
+    static void construct(Storage& storage, T&& function)
+    {
+        *reinterpret_cast<T**>(&storage) = new T(std::move(function));
+    }
+
+    static void invoke(Storage& storage)
+    {
+        (**reinterpret_cast<T**>(&storage))();
+    }
+
+    static void move(Storage& source, Storage& destination)
+    {
+        *reinterpret_cast<T**>(&destination) = *reinterpret_cast<T**>(&source);
+    }
+
+    static void destroy(Storage& storage)
+    {
+        delete *reinterpret_cast<T**>(&storage);
+    }
+
+    static const Operations operations;
+};
+
+template <typename T>
+const TaskFunction::Operations TaskFunction::Implementation<T, false>::operations =
+{
+    &TaskFunction::Implementation<T, false>::invoke,
+    &TaskFunction::Implementation<T, false>::move,
+    &TaskFunction::Implementation<T, false>::destroy
+};
+
+template <typename T>
+TaskFunction::TaskFunction(T function) :
+    _operations(nullptr)
+{
+    // Store the function inline if it fits
+    typedef Implementation<T, sizeof(T) <= InlineStorageSize && std::alignment_of<T>::value <= std::alignment_of<Storage>::value> ImplementationType;
+    ImplementationType::construct(_storage, std::move(function));
+    _operations = &ImplementationType::operations;
+}
+
+}
\ No newline at end of file
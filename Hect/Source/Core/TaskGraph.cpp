@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+TaskGraph::TaskGraph()
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+    // The tasks must outlive any notifications between them
+    for (Task::Data* data : _tasks)
+    {
+        if (!data->done)
+        {
+            data->taskPool->_wait(data);
+        }
+    }
+
+    for (Task::Data* data : _tasks)
+    {
+        Task::_removeReference(data);
+    }
+}
+
+size_t TaskGraph::addTask(TaskFunction action)
+{
+    _checkNotRunning();
+
+    // The graph holds the only reference to the task outside of the pool's
+    // queues
+    Task::Data* data = new Task::Data();
+    data->action = std::move(action);
+
+    _tasks.push_back(data);
+    _predecessorCounts.push_back(0);
+    return _tasks.size() - 1;
+}
+
+void TaskGraph::addDependency(size_t predecessor, size_t successor)
+{
+    _checkNotRunning();
+
+    if (predecessor >= _tasks.size() || successor >= _tasks.size() || predecessor == successor)
+    {
+        throw Error("Invalid task graph dependency");
+    }
+
+    _tasks[predecessor]->graphSuccessors.push_back(_tasks[successor]);
+    ++_predecessorCounts[successor];
+}
+
+void TaskGraph::submit(TaskPool& taskPool, TaskPriority priority)
+{
+    _checkNotRunning();
+
+    // Reset every task before any of them can notify another
+    for (size_t i = 0; i < _tasks.size(); ++i)
+    {
+        Task::Data* data = _tasks[i];
+        data->done = false;
+        data->errorOccurred = false;
+        data->taskPool = &taskPool;
+        data->priority = priority;
+        data->requiredPredecessors = _predecessorCounts[i];
+        data->completedPredecessors = 0;
+        data->continuations = nullptr;
+    }
+
+    if (priority == TaskPriority::Critical)
+    {
+        taskPool._criticalTaskCount += _tasks.size();
+    }
+
+    // Schedule the tasks without predecessors
+    for (size_t i = 0; i < _tasks.size(); ++i)
+    {
+        if (_predecessorCounts[i] == 0)
+        {
+            taskPool._schedule(_tasks[i]);
+        }
+    }
+}
+
+void TaskGraph::wait()
+{
+    for (Task::Data* data : _tasks)
+    {
+        Task(data).wait();
+    }
+}
+
+bool TaskGraph::isDone() const
+{
+    for (Task::Data* data : _tasks)
+    {
+        if (!data->done)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TaskGraph::_checkNotRunning() const
+{
+    if (!isDone())
+    {
+        throw Error("Task graph is running");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A graph of tasks with dependencies between them which is built once and
+/// can be submitted to a task pool repeatedly (e.g. once every frame).
+///
+/// \remarks All task records are allocated while the graph is built, so
+/// submitting the graph does not allocate memory.  The dependencies must
+/// not form a cycle.
+class TaskGraph :
+    public Uncopyable
+{
+public:
+
+    ///
+    /// Constructs an empty task graph.
+    TaskGraph();
+
+    ///
+    /// Waits until the graph is done if it was submitted.
+    ~TaskGraph();
+
+    ///
+    /// Adds a task to the graph.
+    ///
+    /// \param action The action for the task to perform.
+    ///
+    /// \returns The index of the task in the graph.
+    ///
+    /// \throws Error If the graph is running.
+    size_t addTask(TaskFunction action);
+
+    ///
+    /// Adds a dependency between two tasks in the graph.
+    ///
+    /// \param predecessor The index of the task which must be done first.
+    /// \param successor The index of the task which depends on the
+    /// predecessor.
+    ///
+    /// \throws Error If either index is invalid or the graph is running.
+    void addDependency(size_t predecessor, size_t successor);
+
+    ///
+    /// Submits all tasks in the graph to a task pool.
+    ///
+    /// \param taskPool The task pool to execute the tasks in.
+    /// \param priority The priority of the tasks.
+    ///
+    /// \throws Error If the graph is running.
+    void submit(TaskPool& taskPool, TaskPriority priority = TaskPriority::Normal);
+
+    ///
+    /// Waits until all tasks in the graph are done.
+    ///
+    /// \throws Error If an error occurred while executing one of the tasks.
+    void wait();
+
+    ///
+    /// Returns whether all tasks in the graph are done.
+    bool isDone() const;
+
+private:
+    void _checkNotRunning() const;
+
+    std::vector<Task::Data*> _tasks;
+    std::vector<size_t> _predecessorCounts;
+};
+
+}
\ No newline at end of file
@@ -25,8 +25,50 @@
 
 using namespace hect;
 
-Task::Task()
+#ifdef HECT_WINDOWS
+#define HECT_THREAD_LOCAL __declspec(thread)
+#else
+#define HECT_THREAD_LOCAL __thread
+#endif
+
+namespace
+{
+
+// The pool and index of the worker running on the current thread (set as
+// the worker starts)
+HECT_THREAD_LOCAL const TaskPool* currentPool = nullptr;
+HECT_THREAD_LOCAL size_t currentWorkerIndex = (size_t)-1;
+
+}
+
+Task::Continuation Task::_closedContinuation;
+
+Task::Task() :
+    _data(nullptr)
+{
+}
+
+Task::Task(const Task& task) :
+    _data(task._data)
+{
+    if (_data)
+    {
+        _addReference(_data);
+    }
+}
+
+Task::Task(Task&& task) :
+    _data(task._data)
+{
+    task._data = nullptr;
+}
+
+Task::~Task()
 {
+    if (_data)
+    {
+        _removeReference(_data);
+    }
 }
 
 void Task::wait()
@@ -36,10 +78,10 @@ void Task::wait()
         return;
     }
 
-    Task::Data* data = _data.get();
-    while (!data->done)
+    Task::Data* data = _data;
+    if (!data->done)
     {
-        std::this_thread::yield();
+        data->taskPool->_wait(data);
     }
 
     // Re-throw the error if one occurred
@@ -56,26 +98,146 @@ bool Task::isDone() const
         return true;
     }
 
-    Task::Data* data = _data.get();
-    return data->done;
+    return _data->done;
+}
+
+Task Task::then(TaskFunction action)
+{
+    if (!_data)
+    {
+        throw Error("Task is empty");
+    }
+
+    return _data->taskPool->enqueue(std::move(action), std::vector<Task>(1, *this), _data->priority);
+}
+
+Task& Task::operator=(const Task& task)
+{
+    if (task._data)
+    {
+        _addReference(task._data);
+    }
+
+    if (_data)
+    {
+        _removeReference(_data);
+    }
+
+    _data = task._data;
+    return *this;
+}
+
+Task& Task::operator=(Task&& task)
+{
+    if (this != &task)
+    {
+        if (_data)
+        {
+            _removeReference(_data);
+        }
+
+        _data = task._data;
+        task._data = nullptr;
+    }
+
+    return *this;
+}
+
+Task::Data::Data() :
+    done(true),
+    errorOccurred(false),
+    taskPool(nullptr),
+    priority(TaskPriority::Normal),
+    queuedTime(0),
+    requiredPredecessors(0),
+    completedPredecessors(0),
+    continuations(nullptr),
+    referenceCount(1),
+    pooled(false),
+    nextFree(nullptr)
+{
 }
 
-Task::Task(const std::shared_ptr<Data>& data) :
+Task::Task(Data* data) :
     _data(data)
 {
+    _addReference(_data);
+}
+
+void Task::_addReference(Data* data)
+{
+    ++data->referenceCount;
+}
+
+void Task::_removeReference(Data* data)
+{
+    if (--data->referenceCount == 0)
+    {
+        if (data->pooled)
+        {
+            data->taskPool->_freeData(data);
+        }
+        else
+        {
+            delete data;
+        }
+    }
+}
+
+TaskPool::TaskPool() :
+    _freeList(nullptr),
+    _injectedTaskCount(0),
+    _queuedTaskCount(0),
+    _criticalTaskCount(0),
+    _sleepingThreadCount(0),
+    _waitingThreadCount(0),
+    _timingEnabled(false),
+    _tracing(false),
+    _startedWorkerCount(0),
+    _started(false),
+    _stop(false)
+{
+    CpuTopology topology = CpuTopology::detect();
+    _initializeThreads(topology, topology.processors().size(), false);
 }
 
 TaskPool::TaskPool(size_t threadCount) :
+    _freeList(nullptr),
+    _injectedTaskCount(0),
+    _queuedTaskCount(0),
+    _criticalTaskCount(0),
+    _sleepingThreadCount(0),
+    _waitingThreadCount(0),
+    _timingEnabled(false),
+    _tracing(false),
+    _startedWorkerCount(0),
+    _started(false),
+    _stop(false)
+{
+    _initializeThreads(CpuTopology::detect(), threadCount, false);
+}
+
+TaskPool::TaskPool(const CpuTopology& topology, size_t threadCount, bool pinThreads) :
+    _freeList(nullptr),
+    _injectedTaskCount(0),
+    _queuedTaskCount(0),
+    _criticalTaskCount(0),
+    _sleepingThreadCount(0),
+    _waitingThreadCount(0),
+    _timingEnabled(false),
+    _tracing(false),
+    _startedWorkerCount(0),
+    _started(false),
     _stop(false)
 {
-    _initializeThreads(threadCount);
+    _initializeThreads(topology, threadCount, pinThreads);
 }
 
 TaskPool::~TaskPool()
 {
     // Notify all threads that the pool is stopping
     {
-        std::unique_lock<std::mutex> lock(_queueMutex);
+        std::unique_lock<std::mutex> lock(_sleepMutex);
         _stop = true;
         _condition.notify_all();
     }
@@ -85,99 +247,1063 @@ TaskPool::~TaskPool()
     {
         thread.join();
     }
+
+    // Release the tasks which were never executed
+    Task::Data* data;
+    for (size_t lane = 0; lane < _priorityCount; ++lane)
+    {
+        for (auto& worker : _workers)
+        {
+            while (worker->queues[lane].pop(data))
+            {
+                Task::_removeReference(data);
+            }
+        }
+
+        InjectionQueue& injectionQueue = _injectionQueues[lane];
+        for (size_t i = 0; i < injectionQueue.count; ++i)
+        {
+            data = injectionQueue.tasks[(injectionQueue.front + i) % injectionQueue.tasks.size()];
+            Task::_removeReference(data);
+        }
+    }
+
+    // Delete the task data in the free lists
+    for (auto& worker : _workers)
+    {
+        while (worker->freeList)
+        {
+            data = worker->freeList;
+            worker->freeList = data->nextFree;
+            delete data;
+        }
+    }
+
+    while (_freeList)
+    {
+        data = _freeList;
+        _freeList = data->nextFree;
+        delete data;
+    }
 }
 
-Task TaskPool::enqueue(TaskAction action)
+Task TaskPool::enqueue(TaskFunction action, TaskPriority priority)
 {
-    // Create the task data
-    auto data = std::make_shared<Task::Data>();
-    data->action = action;
-    data->done = false;
-    data->errorOccurred = false;
+    Task task;
+    task._data = _createData(std::move(action), priority);
+    _schedule(task._data);
+    return task;
+}
 
-    // Create the task
-    Task task(data);
+Task TaskPool::enqueue(TaskFunction action, const std::vector<Task>& predecessors, TaskPriority priority)
+{
+    Task task;
+    task._data = _createData(std::move(action), priority);
+    _addPredecessors(task._data, predecessors, false);
+    return task;
+}
 
-    if (_threads.empty())
+Task TaskPool::whenAll(const std::vector<Task>& tasks)
+{
+    Task task;
+    task._data = _createData(TaskFunction(), TaskPriority::Normal);
+    _addPredecessors(task._data, tasks, false);
+    return task;
+}
+
+Task TaskPool::whenAny(const std::vector<Task>& tasks)
+{
+    Task task;
+    task._data = _createData(TaskFunction(), TaskPriority::Normal);
+    _addPredecessors(task._data, tasks, true);
+    return task;
+}
+
+void TaskPool::finishFrame()
+{
+    _waitUntil([this]
     {
-        // The task pool has no threads so execute the action synchronously
-        try
+        return _criticalTaskCount == 0;
+    }, true);
+}
+
+bool TaskPool::shouldYield() const
+{
+    size_t workerIndex = _currentWorkerIndex();
+    if (workerIndex >= _workers.size())
+    {
+        return false;
+    }
+
+    // Check for waiting tasks of a higher priority than the current task
+    size_t currentLane = (size_t)_workers[workerIndex]->currentPriority;
+    for (size_t lane = 0; lane < currentLane; ++lane)
+    {
+        if (_queuedTaskCounts[lane] > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t TaskPool::threadCount() const
+{
+    return _threads.size();
+}
+
+const CpuTopology::Processor& TaskPool::workerProcessor(size_t workerIndex) const
+{
+    if (workerIndex >= _workerProcessors.size())
+    {
+        throw Error("Invalid worker index");
+    }
+
+    return _workerProcessors[workerIndex];
+}
+
+TaskPool::ThreadStatistics::ThreadStatistics() :
+    executedTaskCount(0),
+    stolenTaskCount(0),
+    waitCount(0)
+{
+}
+
+void TaskPool::setTimingEnabled(bool enabled)
+{
+    _timingEnabled = enabled;
+}
+
+TaskPool::Statistics TaskPool::statistics() const
+{
+    Statistics statistics;
+    statistics.queueDepthHistogram.resize(_queueDepthBucketCount, 0);
+
+    for (const std::unique_ptr<Telemetry>& telemetry : _telemetry)
+    {
+        ThreadStatistics threadStatistics;
+        threadStatistics.executedTaskCount = telemetry->executedTaskCount;
+        threadStatistics.stolenTaskCount = telemetry->stolenTaskCount;
+        threadStatistics.waitCount = telemetry->waitCount;
+        threadStatistics.busyTime = TimeSpan::fromMicroseconds(telemetry->busyTime);
+        threadStatistics.idleTime = TimeSpan::fromMicroseconds(telemetry->idleTime);
+        threadStatistics.waitTime = TimeSpan::fromMicroseconds(telemetry->waitTime);
+        threadStatistics.totalQueueLatency = TimeSpan::fromMicroseconds(telemetry->totalQueueLatency);
+        threadStatistics.maximumQueueLatency = TimeSpan::fromMicroseconds(telemetry->maximumQueueLatency);
+        statistics.threads.push_back(threadStatistics);
+
+        for (size_t i = 0; i < _queueDepthBucketCount; ++i)
         {
-            action();
+            statistics.queueDepthHistogram[i] += telemetry->queueDepthCounts[i];
         }
-        catch (Error& error)
+    }
+
+    return statistics;
+}
+
+void TaskPool::resetStatistics()
+{
+    for (const std::unique_ptr<Telemetry>& telemetry : _telemetry)
+    {
+        telemetry->executedTaskCount = 0;
+        telemetry->stolenTaskCount = 0;
+        telemetry->waitCount = 0;
+        telemetry->busyTime = 0;
+        telemetry->idleTime = 0;
+        telemetry->waitTime = 0;
+        telemetry->totalQueueLatency = 0;
+        telemetry->maximumQueueLatency = 0;
+
+        for (size_t i = 0; i < _queueDepthBucketCount; ++i)
         {
-            data->errorOccurred = true;
-            data->error = error;
+            telemetry->queueDepthCounts[i] = 0;
         }
+    }
+}
 
-        data->done = true;
+void TaskPool::startTrace(size_t eventCapacity)
+{
+    for (const std::unique_ptr<Telemetry>& telemetry : _telemetry)
+    {
+        std::unique_lock<std::mutex> lock(telemetry->traceMutex);
+        telemetry->traceEvents.assign(std::max<size_t>(eventCapacity, 1), TraceEvent());
+        telemetry->traceEventCount = 0;
     }
-    else
+
+    _tracing = true;
+}
+
+void TaskPool::stopTrace()
+{
+    _tracing = false;
+}
+
+void TaskPool::writeTrace(WriteStream& stream) const
+{
+    static const char* priorityNames[] = { "Critical", "High", "Normal", "Low" };
+
+    DataValue events(DataValueType::Array);
+    for (size_t threadIndex = 0; threadIndex < _telemetry.size(); ++threadIndex)
     {
-        // Add this task to the queue
+        // Name the thread
+        DataValue threadName(DataValueType::Object);
+        threadName.addMember("name", threadIndex < _workers.size() ? format("Worker %d", (int)threadIndex) : std::string("Other threads"));
+
+        DataValue metadataEvent(DataValueType::Object);
+        metadataEvent.addMember("name", "thread_name");
+        metadataEvent.addMember("ph", "M");
+        metadataEvent.addMember("pid", 0);
+        metadataEvent.addMember("tid", (unsigned)threadIndex);
+        metadataEvent.addMember("args", threadName);
+        events.addElement(metadataEvent);
+
+        // Add the events in the ring buffer from oldest to newest
+        const Telemetry& telemetry = *_telemetry[threadIndex];
+        std::unique_lock<std::mutex> lock(telemetry.traceMutex);
+
+        size_t capacity = telemetry.traceEvents.size();
+        size_t eventCount = std::min(telemetry.traceEventCount, capacity);
+        for (size_t i = 0; i < eventCount; ++i)
         {
-            std::unique_lock<std::mutex> lock(_queueMutex);
-            _taskQueue.push_back(task);
+            const TraceEvent& traceEvent = telemetry.traceEvents[(telemetry.traceEventCount - eventCount + i) % capacity];
+
+            DataValue arguments(DataValueType::Object);
+            arguments.addMember("queued", (double)(traceEvent.startTime - traceEvent.queuedTime));
+
+            DataValue event(DataValueType::Object);
+            event.addMember("name", priorityNames[(size_t)traceEvent.priority]);
+            event.addMember("cat", "task");
+            event.addMember("ph", "X");
+            event.addMember("ts", (double)traceEvent.startTime);
+            event.addMember("dur", (double)(traceEvent.finishTime - traceEvent.startTime));
+            event.addMember("pid", 0);
+            event.addMember("tid", (unsigned)threadIndex);
+            event.addMember("args", arguments);
+            events.addElement(event);
         }
+    }
 
-        // Notify one of the threads that a new task is available
-        _condition.notify_one();
+    DataValue trace(DataValueType::Object);
+    trace.addMember("traceEvents", events);
+    trace.addMember("displayTimeUnit", "ms");
+
+    DataValueJsonFormat::save(trace, stream);
+}
+
+TaskPool::ParallelState::ParallelState(size_t begin, size_t end, size_t grainSize, size_t participantCount) :
+    next(begin),
+    end(end),
+    grainSize(std::max<size_t>(grainSize, 1)),
+    divisor(participantCount * 2),
+    activeCount(0),
+    errorOccurred(false)
+{
+}
+
+size_t TaskPool::_participantCount(size_t begin, size_t end, size_t grainSize) const
+{
+    if (begin >= end)
+    {
+        return 0;
     }
 
-    return task;
+    // No more participants than there are chunks of the grain size
+    grainSize = std::max<size_t>(grainSize, 1);
+    size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+    return std::min(_threads.size() + 1, chunkCount);
 }
 
-void TaskPool::_initializeThreads(size_t threadCount)
+bool TaskPool::_claimChunk(ParallelState& state, size_t& chunkBegin, size_t& chunkEnd)
 {
-    for (unsigned i = 0; i < threadCount; ++i)
+    chunkBegin = state.next;
+    do
     {
-        _threads.push_back(std::thread([this]
+        if (chunkBegin >= state.end)
         {
-            _threadLoop();
+            return false;
+        }
+
+        // Claim a share of the remaining range, which shrinks as the range
+        // is consumed
+        size_t remaining = state.end - chunkBegin;
+        size_t chunkSize = std::max(state.grainSize, remaining / state.divisor);
+        chunkEnd = chunkBegin + std::min(chunkSize, remaining);
+    }
+    while (!state.next.compare_exchange_weak(chunkBegin, chunkEnd));
+
+    return true;
+}
+
+TaskPool::Telemetry::Telemetry() :
+    executedTaskCount(0),
+    stolenTaskCount(0),
+    waitCount(0),
+    busyTime(0),
+    idleTime(0),
+    waitTime(0),
+    totalQueueLatency(0),
+    maximumQueueLatency(0),
+    executionDepth(0),
+    traceEventCount(0)
+{
+    for (size_t i = 0; i < _queueDepthBucketCount; ++i)
+    {
+        queueDepthCounts[i] = 0;
+    }
+}
+
+void TaskPool::_initializeThreads(const CpuTopology& topology, size_t threadCount, bool pinThreads)
+{
+    // Start the clock before any worker thread can read it
+    _now();
+
+    for (size_t lane = 0; lane < _priorityCount; ++lane)
+    {
+        _injectionQueues[lane].front = 0;
+        _injectionQueues[lane].count = 0;
+        _queuedTaskCounts[lane] = 0;
+    }
+
+    // Order the processors so that workers are placed on separate cores
+    // before sharing a core, nearest to each other first
+    std::vector<CpuTopology::Processor> processors = topology.processors();
+    if (processors.empty())
+    {
+        processors.push_back(CpuTopology::Processor());
+    }
+
+    std::stable_sort(processors.begin(), processors.end(), [](const CpuTopology::Processor& a, const CpuTopology::Processor& b)
+    {
+        if (a.node != b.node)
+        {
+            return a.node < b.node;
+        }
+        else if (a.cacheDomain != b.cacheDomain)
+        {
+            return a.cacheDomain < b.cacheDomain;
+        }
+        return a.core < b.core;
+    });
+
+    std::vector<CpuTopology::Processor> candidates;
+    std::vector<CpuTopology::Processor> siblings;
+    for (const CpuTopology::Processor& processor : processors)
+    {
+        bool coreTaken = false;
+        for (const CpuTopology::Processor& candidate : candidates)
+        {
+            coreTaken = coreTaken || (candidate.core == processor.core && candidate.node == processor.node);
+        }
+        (coreTaken ? siblings : candidates).push_back(processor);
+    }
+    candidates.insert(candidates.end(), siblings.begin(), siblings.end());
+
+    // Wrap around if there are more workers than processors and then group
+    // the workers by node and cache domain
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        _workerProcessors.push_back(candidates[i % candidates.size()]);
+    }
+
+    std::stable_sort(_workerProcessors.begin(), _workerProcessors.end(), [](const CpuTopology::Processor& a, const CpuTopology::Processor& b)
+    {
+        if (a.node != b.node)
+        {
+            return a.node < b.node;
+        }
+        return a.cacheDomain < b.cacheDomain;
+    });
+
+    // Each worker creates its own state and telemetry (so that the memory
+    // is local to the worker's node); all threads outside of the pool share
+    // the last telemetry
+    _workers.resize(threadCount);
+    _telemetry.resize(threadCount + 1);
+    _telemetry[threadCount].reset(new Telemetry());
+
+    _threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        _threads.push_back(std::thread([this, i, pinThreads]
+        {
+            _startWorker(i, pinThreads);
+            _threadLoop(i);
         }));
     }
+
+    // Wait until every worker has created its state
+    while (_startedWorkerCount < threadCount)
+    {
+        std::this_thread::yield();
+    }
+    _started = true;
 }
 
-void TaskPool::_threadLoop()
+void TaskPool::_startWorker(size_t workerIndex, bool pinThread)
 {
-    while (true)
+    currentPool = this;
+    currentWorkerIndex = workerIndex;
+
+    const CpuTopology::Processor& processor = _workerProcessors[workerIndex];
+    if (pinThread)
     {
-        Task task;
+        CpuTopology::pinCurrentThread(processor.index);
+    }
 
+    std::unique_ptr<Worker> worker(new Worker());
+    worker->randomState = (uint32_t)(workerIndex + 1) * 2654435761u;
+    worker->currentPriority = TaskPriority::Normal;
+    worker->bypassCount = 0;
+    worker->agingLane = 0;
+    worker->freeList = nullptr;
+    worker->freeCount = 0;
+
+    // Order the other workers by distance
+    for (size_t i = 0; i < _workerProcessors.size(); ++i)
+    {
+        if (i != workerIndex && _workerProcessors[i].node == processor.node && _workerProcessors[i].cacheDomain == processor.cacheDomain)
         {
-            std::unique_lock<std::mutex> lock(_queueMutex);
+            worker->victims.push_back(i);
+        }
+    }
+    worker->cacheDomainVictimCount = worker->victims.size();
 
-            while (!_stop && _taskQueue.empty())
+    for (size_t i = 0; i < _workerProcessors.size(); ++i)
+    {
+        if (_workerProcessors[i].node == processor.node && _workerProcessors[i].cacheDomain != processor.cacheDomain)
+        {
+            worker->victims.push_back(i);
+        }
+    }
+    worker->nodeVictimCount = worker->victims.size() - worker->cacheDomainVictimCount;
+
+    for (size_t i = 0; i < _workerProcessors.size(); ++i)
+    {
+        if (_workerProcessors[i].node != processor.node)
+        {
+            worker->victims.push_back(i);
+        }
+    }
+
+    _workers[workerIndex] = std::move(worker);
+    _telemetry[workerIndex].reset(new Telemetry());
+
+    // Wait until every worker has been started before looking for tasks
+    ++_startedWorkerCount;
+    while (!_started)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void TaskPool::_threadLoop(size_t workerIndex)
+{
+    const unsigned spinCount = 64;
+
+    Telemetry& telemetry = *_telemetry[workerIndex];
+
+    while (!_stop)
+    {
+        Task::Data* data = nullptr;
+        int64_t idleStartTime = _timingEnabled ? _now() : 0;
+
+        // Look for a task, yielding for a while before sleeping
+        bool found = false;
+        for (unsigned spin = 0; spin < spinCount && !found && !_stop; ++spin)
+        {
+            found = _take(workerIndex, data);
+            if (!found)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        if (idleStartTime != 0)
+        {
+            telemetry.idleTime += _now() - idleStartTime;
+        }
+
+        if (found)
+        {
+            _execute(data, workerIndex);
+        }
+        else
+        {
+            // Sleep until a task is queued or the pool is stopping
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            ++_sleepingThreadCount;
+            while (!_stop && _queuedTaskCount == 0)
             {
                 _condition.wait(lock);
             }
+            --_sleepingThreadCount;
+        }
+    }
+}
+
+Task::Data* TaskPool::_createData(TaskFunction action, TaskPriority priority)
+{
+    const size_t batchSize = 64;
+
+    Task::Data* data = nullptr;
+
+    size_t workerIndex = _currentWorkerIndex();
+    if (workerIndex < _workers.size())
+    {
+        Worker& worker = *_workers[workerIndex];
 
-            if (_stop)
+        // Refill the worker's free list from the shared list if it is empty
+        if (!worker.freeList)
+        {
+            std::unique_lock<std::mutex> lock(_freeListMutex);
+            while (_freeList && worker.freeCount < batchSize)
             {
-                return;
+                Task::Data* freeData = _freeList;
+                _freeList = freeData->nextFree;
+                freeData->nextFree = worker.freeList;
+                worker.freeList = freeData;
+                ++worker.freeCount;
             }
+        }
 
-            // Get the next task
-            task = _taskQueue.front();
-            _taskQueue.pop_front();
+        if (worker.freeList)
+        {
+            data = worker.freeList;
+            worker.freeList = data->nextFree;
+            --worker.freeCount;
+        }
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(_freeListMutex);
+        if (_freeList)
+        {
+            data = _freeList;
+            _freeList = data->nextFree;
         }
+    }
+
+    if (!data)
+    {
+        data = new Task::Data();
+        data->taskPool = this;
+        data->pooled = true;
+    }
+
+    data->action = std::move(action);
+    data->priority = priority;
+    data->done = false;
+    data->errorOccurred = false;
+    data->requiredPredecessors = 0;
+    data->completedPredecessors = 0;
+    data->continuations = nullptr;
+    data->referenceCount = 1;
+    data->nextFree = nullptr;
+    data->queuedTime = 0;
+
+    if (priority == TaskPriority::Critical)
+    {
+        ++_criticalTaskCount;
+    }
+
+    return data;
+}
+
+void TaskPool::_freeData(Task::Data* data)
+{
+    const size_t batchSize = 64;
+
+    // Release anything captured by the action
+    data->action = TaskFunction();
 
-        // Execute the task
-        Task::Data* data = task._data.get();
-        if (data)
+    size_t workerIndex = _currentWorkerIndex();
+    if (workerIndex < _workers.size())
+    {
+        Worker& worker = *_workers[workerIndex];
+        data->nextFree = worker.freeList;
+        worker.freeList = data;
+
+        // Hand a batch over to the shared list if the worker has too much
+        // (tasks enqueued from other threads are usually released on
+        // worker threads)
+        if (++worker.freeCount >= batchSize * 2)
         {
-            try
+            Task::Data* first = worker.freeList;
+            Task::Data* last = first;
+            for (size_t i = 1; i < batchSize; ++i)
             {
-                data->action();
+                last = last->nextFree;
             }
-            catch (Error& error)
+
+            worker.freeList = last->nextFree;
+            worker.freeCount -= batchSize;
+
+            std::unique_lock<std::mutex> lock(_freeListMutex);
+            last->nextFree = _freeList;
+            _freeList = first;
+        }
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(_freeListMutex);
+        data->nextFree = _freeList;
+        _freeList = data;
+    }
+}
+
+void TaskPool::_addPredecessors(Task::Data* data, const std::vector<Task>& predecessors, bool any)
+{
+    // The number of predecessors must be known before any of them can
+    // notify the task
+    data->requiredPredecessors = any ? std::min<size_t>(1, predecessors.size()) : predecessors.size();
+    if (data->requiredPredecessors == 0)
+    {
+        _ready(data);
+        return;
+    }
+
+    for (const Task& predecessor : predecessors)
+    {
+        Task::Data* predecessorData = predecessor._data;
+        if (!predecessorData)
+        {
+            // An empty task is always done
+            _notifyPredecessorDone(data);
+            continue;
+        }
+
+        // Add a continuation to the predecessor unless it is already done
+        // (the continuation holds a reference to the task)
+        Task::Continuation* continuation = new Task::Continuation();
+        continuation->data = data;
+        continuation->next = predecessorData->continuations.load();
+        Task::_addReference(data);
+        do
+        {
+            if (continuation->next == &Task::_closedContinuation)
             {
-                data->errorOccurred = true;
-                data->error = error;
+                Task::_removeReference(data);
+                delete continuation;
+                _notifyPredecessorDone(data);
+                break;
             }
+        }
+        while (!predecessorData->continuations.compare_exchange_weak(continuation->next, continuation));
+    }
+}
 
-            data->done = true;
+void TaskPool::_schedule(Task::Data* data)
+{
+    // The queue holds a reference until the task is executed
+    Task::_addReference(data);
+
+    if (_timingEnabled || _tracing)
+    {
+        data->queuedTime = _now();
+    }
+
+    if (_threads.empty())
+    {
+        // The task pool has no threads so execute the action synchronously
+        _execute(data, (size_t)-1);
+    }
+    else
+    {
+        _push(data);
+    }
+}
+
+void TaskPool::_push(Task::Data* data)
+{
+    size_t lane = (size_t)data->priority;
+
+    // Count the task before it becomes visible so the counts never drop
+    // below the number of queued tasks
+    size_t queueDepth = _queuedTaskCount++;
+    ++_queuedTaskCounts[lane];
+
+    size_t workerIndex = _currentWorkerIndex();
+
+    // Record the queue depth in the histogram
+    size_t bucket = 0;
+    while (queueDepth > 0 && bucket < _queueDepthBucketCount - 1)
+    {
+        queueDepth >>= 1;
+        ++bucket;
+    }
+    _telemetryFor(workerIndex).queueDepthCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    if (workerIndex < _workers.size())
+    {
+        // Enqueued from a worker thread so push to the worker's own queue
+        _workers[workerIndex]->queues[lane].push(data);
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(_injectionMutex);
+        InjectionQueue& injectionQueue = _injectionQueues[lane];
+
+        // Grow the ring buffer if it is full
+        size_t capacity = injectionQueue.tasks.size();
+        if (injectionQueue.count == capacity)
+        {
+            std::vector<Task::Data*> grownTasks(std::max<size_t>(64, capacity * 2));
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                grownTasks[i] = injectionQueue.tasks[(injectionQueue.front + i) % capacity];
+            }
+
+            injectionQueue.tasks.swap(grownTasks);
+            injectionQueue.front = 0;
+        }
+
+        injectionQueue.tasks[(injectionQueue.front + injectionQueue.count) % injectionQueue.tasks.size()] = data;
+        ++injectionQueue.count;
+        ++_injectedTaskCount;
+    }
+
+    // Wake a sleeping thread if there is one
+    if (_sleepingThreadCount > 0)
+    {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _condition.notify_one();
+    }
+}
+
+bool TaskPool::_take(size_t workerIndex, Task::Data*& data)
+{
+    const unsigned maxBypassCount = 16;
+
+    Worker& worker = *_workers[workerIndex];
+
+    bool found = false;
+
+    // Serve a lane in turn if too many tasks were taken while lower
+    // priority tasks were waiting
+    if (worker.bypassCount >= maxBypassCount)
+    {
+        for (size_t i = 0; i < _priorityCount && !found; ++i)
+        {
+            size_t lane = (worker.agingLane + i) % _priorityCount;
+            found = _takeFromLane(workerIndex, lane, data);
+        }
+
+        worker.agingLane = (worker.agingLane + 1) % _priorityCount;
+        worker.bypassCount = 0;
+    }
+
+    // Serve the lanes from the highest priority down
+    for (size_t lane = 0; lane < _priorityCount && !found; ++lane)
+    {
+        found = _takeFromLane(workerIndex, lane, data);
+    }
+
+    if (found)
+    {
+        // Count the task as bypassing any waiting lower priority tasks
+        bool bypassed = false;
+        for (size_t lane = (size_t)data->priority + 1; lane < _priorityCount && !bypassed; ++lane)
+        {
+            bypassed = _queuedTaskCounts[lane] > 0;
+        }
+
+        if (bypassed)
+        {
+            ++worker.bypassCount;
+        }
+        else
+        {
+            worker.bypassCount = 0;
+        }
+    }
+
+    return found;
+}
+
+bool TaskPool::_takeFromLane(size_t workerIndex, size_t lane, Task::Data*& data)
+{
+    if (_queuedTaskCounts[lane] == 0)
+    {
+        return false;
+    }
+
+    // Pop from the worker's own queue (only possible on a worker thread)
+    bool found = workerIndex < _workers.size() && _workers[workerIndex]->queues[lane].pop(data);
+
+    // Take from the injection queue
+    if (!found && _injectedTaskCount > 0)
+    {
+        std::unique_lock<std::mutex> lock(_injectionMutex);
+        InjectionQueue& injectionQueue = _injectionQueues[lane];
+        if (injectionQueue.count > 0)
+        {
+            data = injectionQueue.tasks[injectionQueue.front];
+            injectionQueue.front = (injectionQueue.front + 1) % injectionQueue.tasks.size();
+            --injectionQueue.count;
+            --_injectedTaskCount;
+            found = true;
         }
     }
+
+    if (!found)
+    {
+        found = _steal(workerIndex, lane, data);
+        if (found)
+        {
+            _telemetryFor(workerIndex).stolenTaskCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (found)
+    {
+        --_queuedTaskCounts[lane];
+        --_queuedTaskCount;
+    }
+    return found;
+}
+
+bool TaskPool::_steal(size_t workerIndex, size_t lane, Task::Data*& data)
+{
+    size_t workerCount = _workers.size();
+
+    if (workerIndex >= workerCount)
+    {
+        // Threads outside of the pool have no locality to prefer
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            if (_workers[i]->queues[lane].steal(data))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    Worker& worker = *_workers[workerIndex];
+
+    // Pick a random victim to start from within each group of victims
+    // (xorshift)
+    uint32_t& random = worker.randomState;
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+
+    size_t groupEnds[] =
+    {
+        worker.cacheDomainVictimCount,
+        worker.cacheDomainVictimCount + worker.nodeVictimCount,
+        worker.victims.size()
+    };
+
+    size_t groupBegin = 0;
+    for (size_t groupEnd : groupEnds)
+    {
+        size_t groupSize = groupEnd - groupBegin;
+        for (size_t i = 0; i < groupSize; ++i)
+        {
+            size_t victimIndex = worker.victims[groupBegin + (random + i) % groupSize];
+            if (_workers[victimIndex]->queues[lane].steal(data))
+            {
+                return true;
+            }
+        }
+        groupBegin = groupEnd;
+    }
+
+    return false;
+}
+
+void TaskPool::_execute(Task::Data* data, size_t workerIndex)
+{
+    // Track the priority of the task executing on a worker thread (a task
+    // may be executed within another while helping)
+    TaskPriority previousPriority = TaskPriority::Normal;
+    if (workerIndex < _workers.size())
+    {
+        previousPriority = _workers[workerIndex]->currentPriority;
+        _workers[workerIndex]->currentPriority = data->priority;
+    }
+
+    Telemetry& telemetry = _telemetryFor(workerIndex);
+    telemetry.executedTaskCount.fetch_add(1, std::memory_order_relaxed);
+
+    bool timing = _timingEnabled || _tracing;
+    int64_t startTime = timing ? _now() : 0;
+
+    bool onWorkerThread = workerIndex < _workers.size();
+    if (onWorkerThread)
+    {
+        ++telemetry.executionDepth;
+    }
+
+    try
+    {
+        data->action();
+    }
+    catch (Error& error)
+    {
+        data->errorOccurred = true;
+        data->error = error;
+    }
+
+    if (onWorkerThread)
+    {
+        --telemetry.executionDepth;
+    }
+
+    if (timing)
+    {
+        int64_t finishTime = _now();
+
+        // Only count the outermost task on a worker thread as busy time
+        // since nested tasks execute within it
+        if (!onWorkerThread || telemetry.executionDepth == 0)
+        {
+            telemetry.busyTime += finishTime - startTime;
+        }
+
+        if (data->queuedTime != 0)
+        {
+            int64_t queueLatency = startTime - data->queuedTime;
+            telemetry.totalQueueLatency += queueLatency;
+
+            int64_t maximumQueueLatency = telemetry.maximumQueueLatency;
+            while (queueLatency > maximumQueueLatency && !telemetry.maximumQueueLatency.compare_exchange_weak(maximumQueueLatency, queueLatency))
+            {
+            }
+        }
+
+        if (_tracing)
+        {
+            TraceEvent traceEvent;
+            traceEvent.queuedTime = data->queuedTime != 0 ? data->queuedTime : startTime;
+            traceEvent.startTime = startTime;
+            traceEvent.finishTime = finishTime;
+            traceEvent.priority = data->priority;
+
+            std::unique_lock<std::mutex> lock(telemetry.traceMutex);
+            if (!telemetry.traceEvents.empty())
+            {
+                telemetry.traceEvents[telemetry.traceEventCount % telemetry.traceEvents.size()] = traceEvent;
+                ++telemetry.traceEventCount;
+            }
+        }
+    }
+
+    if (onWorkerThread)
+    {
+        _workers[workerIndex]->currentPriority = previousPriority;
+    }
+
+    _complete(data);
+
+    // Release the queue's reference
+    Task::_removeReference(data);
+}
+
+void TaskPool::_wait(Task::Data* data)
+{
+    _waitUntil([data]
+    {
+        return data->done.load();
+    }, false);
+}
+
+void TaskPool::_notifyWaitingThreads()
+{
+    if (_waitingThreadCount > 0)
+    {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _condition.notify_all();
+        _waitCondition.notify_all();
+    }
+}
+
+TaskPool::Telemetry& TaskPool::_telemetryFor(size_t workerIndex)
+{
+    // Threads outside of the pool share the last telemetry
+    return *_telemetry[std::min(workerIndex, _workers.size())];
+}
+
+int64_t TaskPool::_now()
+{
+    return Timer::totalElapsed().microseconds();
+}
+
+TaskPriority TaskPool::_currentPriority() const
+{
+    size_t workerIndex = _currentWorkerIndex();
+    if (workerIndex < _workers.size())
+    {
+        return _workers[workerIndex]->currentPriority;
+    }
+
+    return TaskPriority::Normal;
+}
+
+size_t TaskPool::_currentWorkerIndex() const
+{
+    if (currentPool == this)
+    {
+        return currentWorkerIndex;
+    }
+
+    return (size_t)-1;
+}
+
+void TaskPool::_complete(Task::Data* data)
+{
+    // Notify the successors within the task graph
+    for (Task::Data* successor : data->graphSuccessors)
+    {
+        _notifyPredecessorDone(successor);
+    }
+
+    // Notify the continuations and close the list so any continuations
+    // added later are notified immediately
+    Task::Continuation* continuation = data->continuations.exchange(&Task::_closedContinuation);
+    while (continuation)
+    {
+        Task::Continuation* next = continuation->next;
+        _notifyPredecessorDone(continuation->data);
+        Task::_removeReference(continuation->data);
+        delete continuation;
+        continuation = next;
+    }
+
+    // Mark the task done last so nothing refers to the task once it is
+    // observed as done
+    TaskPool* taskPool = data->taskPool;
+    bool critical = data->priority == TaskPriority::Critical;
+    data->done = true;
+
+    if (critical)
+    {
+        --taskPool->_criticalTaskCount;
+    }
+
+    taskPool->_notifyWaitingThreads();
+}
+
+void TaskPool::_notifyPredecessorDone(Task::Data* data)
+{
+    if (++data->completedPredecessors == data->requiredPredecessors)
+    {
+        _ready(data);
+    }
+}
+
+void TaskPool::_ready(Task::Data* data)
+{
+    if (!data->action.isEmpty())
+    {
+        data->taskPool->_schedule(data);
+    }
+    else
+    {
+        // A task without an action only joins its predecessors
+        _complete(data);
+    }
 }
\ No newline at end of file
@@ -26,24 +26,70 @@
 namespace hect
 {
 
+class TaskPool;
+class WriteStream;
+
 ///
 /// An action for a task to execute.
 typedef std::function<void()> TaskAction;
 
+///
+/// The priority class of a task.
+enum class TaskPriority
+{
+    ///
+    /// A task which must finish before the end of the frame (see
+    /// TaskPool::finishFrame()).
+    Critical,
+
+    ///
+    /// A task which the current frame depends on (e.g. physics or culling).
+    High,
+
+    ///
+    /// A task without any particular urgency.
+    Normal,
+
+    ///
+    /// Background work which may span several frames (e.g. asset loading).
+    Low
+};
+
 ///
 /// A handle for an enqueued task.
+///
+/// \remarks A task must not outlive the pool it was enqueued in.
 class Task
 {
     friend class TaskPool;
+    friend class TaskGraph;
 public:
 
     ///
     /// Creates an empty task.
     Task();
 
+    ///
+    /// Creates a handle to the same task as another.
+    ///
+    /// \param task The task.
+    Task(const Task& task);
+
+    ///
+    /// Creates a handle moved from another.
+    ///
+    /// \param task The task to move.
+    Task(Task&& task);
+
+    ~Task();
+
     ///
     /// Waits until the task has completed.
     ///
+    /// \remarks When called from a worker thread of the task's pool, other
+    /// queued tasks are executed while waiting.  Otherwise the calling thread
+    /// spins briefly and then blocks until the task is done.
+    ///
     /// \throws Error If an error occurred while executing the task's action.
     void wait();
 
@@ -51,33 +97,207 @@ public:
     /// Returns whether the task is done.
     bool isDone() const;
 
+    ///
+    /// Enqueues a task to be executed once this task is done.
+    ///
+    /// \remarks The continuation is executed in the same task pool with the
+    /// same priority whether or not an error occurred in this task.
+    ///
+    /// \param action The action for the continuation to perform.
+    ///
+    /// \returns The continuation task.
+    ///
+    /// \throws Error If the task is empty.
+    Task then(TaskFunction action);
+
+    ///
+    /// Makes the task a handle to the same task as another.
+    ///
+    /// \param task The task.
+    ///
+    /// \returns A reference to the task.
+    Task& operator=(const Task& task);
+
+    ///
+    /// Moves a handle into the task.
+    ///
+    /// \param task The task to move.
+    ///
+    /// \returns A reference to the task.
+    Task& operator=(Task&& task);
+
 private:
+    struct Continuation;
+
     struct Data
     {
-        TaskAction action;
+        Data();
+
+        TaskFunction action;
         std::atomic<bool> done;
         bool errorOccurred;
         Error error;
+
+        // The pool the task is executed in
+        TaskPool* taskPool;
+        TaskPriority priority;
+
+        // When the task was queued (in microseconds, if timing is enabled)
+        int64_t queuedTime;
+
+        // The task becomes ready once the required number of predecessors
+        // are done
+        size_t requiredPredecessors;
+        std::atomic<size_t> completedPredecessors;
+
+        // Tasks to notify once done; set to the closed sentinel once the
+        // task is done
+        std::atomic<Continuation*> continuations;
+
+        // Tasks within the same task graph to notify once done
+        std::vector<Data*> graphSuccessors;
+
+        // The number of handles, queue entries and continuations referring
+        // to the task
+        std::atomic<size_t> referenceCount;
+
+        // Whether the data is returned to its pool once no longer referenced
+        // (otherwise it is deleted)
+        bool pooled;
+
+        // The next data in the pool's free list
+        Data* nextFree;
     };
 
-    Task(const std::shared_ptr<Data>& data);
+    struct Continuation
+    {
+        Data* data;
+        Continuation* next;
+    };
 
-    std::shared_ptr<Data> _data;
+    Task(Data* data);
+
+    static void _addReference(Data* data);
+    static void _removeReference(Data* data);
+
+    Data* _data;
+
+    static Continuation _closedContinuation;
 };
 
 ///
 /// Provides the functionality for executing asynchronous tasks.
+///
+/// \remarks Each worker thread owns a work-stealing queue.  Tasks enqueued
+/// from a worker thread are pushed to that worker's queue and popped in LIFO
+/// order; tasks enqueued from other threads are placed in a shared injection
+/// queue.  A worker with no tasks of its own takes from the injection queue
+/// or steals from another worker (preferring workers sharing its cache) before
+/// going to sleep.
+///
+/// Each priority class has its own lane in every queue.  Workers serve the
+/// lanes from the highest priority down at every task boundary, so a long
+/// burst of background tasks does not delay frame-critical tasks queued
+/// after it.  To keep lower lanes from starving, a worker which has taken
+/// too many tasks in a row while lower-priority tasks were waiting takes its
+/// next task from a lower lane.
+///
+/// Task data is reference counted and recycled through free lists kept by
+/// each worker thread (and a shared list for other threads), so enqueuing
+/// and executing tasks does not allocate memory once the pool is warm
+/// unless a task's action does not fit within a task function's inline
+/// storage.
 class TaskPool :
     public Uncopyable
 {
+    friend class Task;
+    friend class TaskGraph;
 public:
 
+    ///
+    /// Statistics of a thread executing tasks.
+    ///
+    /// \remarks The times are only measured while timing is enabled.
+    struct ThreadStatistics
+    {
+        ThreadStatistics();
+
+        ///
+        /// The number of tasks executed.
+        uint64_t executedTaskCount;
+
+        ///
+        /// The number of tasks stolen from other worker threads.
+        uint64_t stolenTaskCount;
+
+        ///
+        /// The number of times the thread waited for a task or for the
+        /// critical tasks of a frame which was not done.
+        uint64_t waitCount;
+
+        ///
+        /// The time spent executing tasks.
+        TimeSpan busyTime;
+
+        ///
+        /// The time spent looking for a task to execute or sleeping.
+        TimeSpan idleTime;
+
+        ///
+        /// The time spent blocked while waiting.
+        TimeSpan waitTime;
+
+        ///
+        /// The total time tasks spent queued before starting.
+        TimeSpan totalQueueLatency;
+
+        ///
+        /// The longest time a task spent queued before starting.
+        TimeSpan maximumQueueLatency;
+    };
+
+    ///
+    /// Statistics collected by a task pool.
+    struct Statistics
+    {
+        ///
+        /// The statistics of each worker thread followed by the combined
+        /// statistics of all threads outside of the pool.
+        std::vector<ThreadStatistics> threads;
+
+        ///
+        /// The number of tasks queued when the number of tasks already
+        /// queued was zero (the first bucket) or within [2^(i-1), 2^i) (the
+        /// bucket at index i).
+        std::vector<uint64_t> queueDepthHistogram;
+    };
+
+    ///
+    /// Constructs a task pool with a worker thread for each logical
+    /// processor of the system.
+    TaskPool();
+
     ///
     /// Constructs a task pool with a specific number of worker threads.
     ///
     /// \param threadCount The number of worker threads.
     TaskPool(size_t threadCount);
 
+    ///
+    /// Constructs a task pool with a specific number of worker threads
+    /// placed on the processors of a topology.
+    ///
+    /// \remarks Workers are placed on separate cores before sharing a core
+    /// and are grouped by cache domain and node.  Idle workers steal from
+    /// workers sharing their cache domain first, then from workers on their
+    /// node and then from the rest.
+    ///
+    /// \param topology The topology of the system.
+    /// \param threadCount The number of worker threads.
+    /// \param pinThreads Whether each worker thread is pinned to its
+    /// processor.
+    TaskPool(const CpuTopology& topology, size_t threadCount, bool pinThreads = false);
+
     ///
     /// Waits until all running tasks complete (ignores any enqueued tasks
     /// remaining).
@@ -87,21 +307,352 @@ public:
     /// Enqueues a task to be executed asynchronously.
     ///
     /// \param action The action for the task to perform.
+    /// \param priority The priority of the task.
     ///
     /// \returns The queued task.
-    Task enqueue(TaskAction action);
+    Task enqueue(TaskFunction action, TaskPriority priority = TaskPriority::Normal);
+
+    ///
+    /// Enqueues a task to be executed asynchronously once all of its
+    /// predecessors are done.
+    ///
+    /// \param action The action for the task to perform.
+    /// \param predecessors The tasks which must be done first.
+    /// \param priority The priority of the task.
+    ///
+    /// \returns The queued task.
+    Task enqueue(TaskFunction action, const std::vector<Task>& predecessors, TaskPriority priority = TaskPriority::Normal);
+
+    ///
+    /// Returns a task which is done once all of the given tasks are done.
+    ///
+    /// \param tasks The tasks.
+    Task whenAll(const std::vector<Task>& tasks);
+
+    ///
+    /// Returns a task which is done once any of the given tasks is done.
+    ///
+    /// \param tasks The tasks.
+    Task whenAny(const std::vector<Task>& tasks);
+
+    ///
+    /// Waits until all critical tasks are done.
+    ///
+    /// \remarks The calling thread executes critical tasks while waiting.
+    void finishFrame();
+
+    ///
+    /// Returns whether the task executing on the calling thread should
+    /// return as soon as possible because tasks of a higher priority are
+    /// waiting.
+    ///
+    /// \remarks Long-running low-priority tasks can check this to split
+    /// their work into several tasks.
+    bool shouldYield() const;
+
+    ///
+    /// Executes a function over a range of indices in parallel and waits
+    /// until the entire range is processed.
+    ///
+    /// \remarks The range is split into chunks which are claimed by the
+    /// calling thread and the worker threads as they become free.  Chunks
+    /// start large and shrink as the remaining range shrinks (but never
+    /// below the grain size) so that the load stays balanced.  The chunks
+    /// are processed with the priority of the task calling the function.
+    ///
+    /// \param begin The first index in the range.
+    /// \param end One past the last index in the range.
+    /// \param grainSize The minimum number of indices in a chunk.
+    /// \param function The function to call for each chunk of the range,
+    /// taking the first and one past the last index of the chunk.
+    ///
+    /// \throws Error If an error occurred in one of the calls to the
+    /// function.
+    template <typename Function>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, Function function);
+
+    ///
+    /// Computes a value over a range of indices in parallel.
+    ///
+    /// \param begin The first index in the range.
+    /// \param end One past the last index in the range.
+    /// \param grainSize The minimum number of indices in a chunk.
+    /// \param identity The identity value of the reduction.
+    /// \param map The function computing the value for a chunk of the
+    /// range, taking the first and one past the last index of the chunk.
+    /// \param reduce The function combining two values (must be associative
+    /// and commutative).
+    ///
+    /// \returns The reduced value.
+    ///
+    /// \throws Error If an error occurred in one of the calls to the
+    /// functions.
+    template <typename T, typename MapFunction, typename ReduceFunction>
+    T parallelReduce(size_t begin, size_t end, size_t grainSize, const T& identity, MapFunction map, ReduceFunction reduce);
+
+    ///
+    /// Sorts a range of values in parallel using a merge sort.
+    ///
+    /// \remarks The sort is stable.  The value type must be default
+    /// constructible and movable.
+    ///
+    /// \param first The first value in the range.
+    /// \param last One past the last value in the range.
+    template <typename RandomAccessIterator>
+    void parallelSort(RandomAccessIterator first, RandomAccessIterator last);
+
+    ///
+    /// Sorts a range of values in parallel using a merge sort.
+    ///
+    /// \remarks The sort is stable.  The value type must be default
+    /// constructible and movable.
+    ///
+    /// \param first The first value in the range.
+    /// \param last One past the last value in the range.
+    /// \param compare The function returning whether a value is ordered
+    /// before another.
+    template <typename RandomAccessIterator, typename Compare>
+    void parallelSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare);
+
+    ///
+    /// Sorts values by an unsigned integer key in parallel using a radix
+    /// sort.
+    ///
+    /// \remarks The sort is stable.  Only the bytes of the key which are
+    /// non-zero in at least one value are sorted on.
+    ///
+    /// \param values The values to sort.
+    /// \param key The function returning the key of a value.
+    template <typename T, typename KeyFunction>
+    void parallelSortByKey(std::vector<T>& values, KeyFunction key);
+
+    ///
+    /// Returns the number of worker threads.
+    size_t threadCount() const;
+
+    ///
+    /// Returns the processor a worker thread is placed on.
+    ///
+    /// \param workerIndex The index of the worker thread.
+    ///
+    /// \throws Error If the index is invalid.
+    const CpuTopology::Processor& workerProcessor(size_t workerIndex) const;
+
+    ///
+    /// Sets whether the time spent by threads and tasks is measured.
+    ///
+    /// \remarks Timing reads the clock several times for each task so it is
+    /// disabled by default.
+    ///
+    /// \param enabled Whether timing is enabled.
+    void setTimingEnabled(bool enabled);
+
+    ///
+    /// Returns the statistics collected since the pool was constructed or
+    /// the statistics were last reset.
+    Statistics statistics() const;
+
+    ///
+    /// Resets the collected statistics.
+    void resetStatistics();
+
+    ///
+    /// Starts recording an event for each executed task.
+    ///
+    /// \remarks Tasks are timed while recording even if timing is not
+    /// enabled.  Each thread keeps the most recent events in a ring buffer.
+    ///
+    /// \param eventCapacity The maximum number of events kept for each
+    /// thread.
+    void startTrace(size_t eventCapacity = 65536);
+
+    ///
+    /// Stops recording task events (the recorded events are kept until the
+    /// next trace is started).
+    void stopTrace();
+
+    ///
+    /// Writes the recorded task events in the Chrome trace event format
+    /// (which can be loaded in chrome://tracing).
+    ///
+    /// \param stream The stream to write to.
+    void writeTrace(WriteStream& stream) const;
 
 private:
-    void _initializeThreads(size_t threadCount);
-    void _threadLoop();
+    struct ParallelState
+    {
+        ParallelState(size_t begin, size_t end, size_t grainSize, size_t participantCount);
+
+        std::atomic<size_t> next;
+        size_t end;
+        size_t grainSize;
+        size_t divisor;
+
+        // The number of worker threads processing chunks
+        std::atomic<size_t> activeCount;
+
+        std::atomic<bool> errorOccurred;
+        std::mutex errorMutex;
+        Error error;
+    };
+
+    template <typename Function>
+    void _parallelChunks(size_t begin, size_t end, size_t grainSize, size_t participantCount, Function& function);
+
+    template <typename Function>
+    static void _participate(ParallelState& state, size_t participant, Function& function);
+
+    size_t _participantCount(size_t begin, size_t end, size_t grainSize) const;
+    static bool _claimChunk(ParallelState& state, size_t& chunkBegin, size_t& chunkEnd);
+
+    static const size_t _priorityCount = 4;
+    static const size_t _queueDepthBucketCount = 16;
+
+    struct TraceEvent
+    {
+        int64_t queuedTime;
+        int64_t startTime;
+        int64_t finishTime;
+        TaskPriority priority;
+    };
+
+    // The statistics and trace events of a worker thread (or of all
+    // threads outside of the pool)
+    struct Telemetry
+    {
+        Telemetry();
+
+        std::atomic<uint64_t> executedTaskCount;
+        std::atomic<uint64_t> stolenTaskCount;
+        std::atomic<uint64_t> waitCount;
+
+        // Times in microseconds
+        std::atomic<int64_t> busyTime;
+        std::atomic<int64_t> idleTime;
+        std::atomic<int64_t> waitTime;
+        std::atomic<int64_t> totalQueueLatency;
+        std::atomic<int64_t> maximumQueueLatency;
+
+        std::atomic<uint64_t> queueDepthCounts[_queueDepthBucketCount];
+
+        // The number of tasks executing on a worker's thread (a task may
+        // be executed within another while helping)
+        unsigned executionDepth;
+
+        // A ring buffer of the most recent trace events
+        mutable std::mutex traceMutex;
+        std::vector<TraceEvent> traceEvents;
+        size_t traceEventCount;
+    };
 
-    std::deque<Task> _taskQueue;
+    struct Worker
+    {
+        // A queue for each priority
+        WorkStealingQueue<Task::Data*> queues[_priorityCount];
+        uint32_t randomState;
+
+        // The priority of the task executing on the worker's thread
+        TaskPriority currentPriority;
+
+        // The number of tasks taken in a row while tasks of a lower
+        // priority were waiting, and the lane to serve next once too many
+        // were taken
+        unsigned bypassCount;
+        size_t agingLane;
+
+        // Task data released on the worker's thread
+        Task::Data* freeList;
+        size_t freeCount;
+
+        // The workers to steal from, nearest first: those sharing the
+        // worker's cache domain, then those on the worker's node, then the
+        // rest
+        std::vector<size_t> victims;
+        size_t cacheDomainVictimCount;
+        size_t nodeVictimCount;
+    };
 
+    void _initializeThreads(const CpuTopology& topology, size_t threadCount, bool pinThreads);
+    void _startWorker(size_t workerIndex, bool pinThread);
+    void _threadLoop(size_t workerIndex);
+
+    Task::Data* _createData(TaskFunction action, TaskPriority priority);
+    void _freeData(Task::Data* data);
+    void _addPredecessors(Task::Data* data, const std::vector<Task>& predecessors, bool any);
+
+    void _schedule(Task::Data* data);
+    void _push(Task::Data* data);
+    bool _take(size_t workerIndex, Task::Data*& data);
+    bool _takeFromLane(size_t workerIndex, size_t lane, Task::Data*& data);
+    bool _steal(size_t workerIndex, size_t lane, Task::Data*& data);
+    void _execute(Task::Data* data, size_t workerIndex);
+    void _wait(Task::Data* data);
+    void _notifyWaitingThreads();
+    size_t _currentWorkerIndex() const;
+    TaskPriority _currentPriority() const;
+    Telemetry& _telemetryFor(size_t workerIndex);
+    static int64_t _now();
+
+    template <typename Condition>
+    void _waitUntil(Condition condition, bool helpWithCriticalTasks);
+
+    static void _complete(Task::Data* data);
+    static void _notifyPredecessorDone(Task::Data* data);
+    static void _ready(Task::Data* data);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
     std::vector<std::thread> _threads;
 
-    std::mutex _queueMutex;
+    // The telemetry of each worker followed by the telemetry of threads
+    // outside of the pool
+    std::vector<std::unique_ptr<Telemetry>> _telemetry;
+    std::atomic<bool> _timingEnabled;
+    std::atomic<bool> _tracing;
+
+    // The processor of each worker
+    std::vector<CpuTopology::Processor> _workerProcessors;
+
+    // The number of worker threads which have created their state and
+    // whether all threads have been started
+    std::atomic<size_t> _startedWorkerCount;
+    std::atomic<bool> _started;
+
+    // Task data released on threads outside of the pool or handed over by
+    // workers with too much free data of their own
+    Task::Data* _freeList;
+    std::mutex _freeListMutex;
+
+    // Tasks enqueued from threads outside of the pool (a ring buffer for
+    // each priority which only allocates when it grows)
+    struct InjectionQueue
+    {
+        std::vector<Task::Data*> tasks;
+        size_t front;
+        size_t count;
+    };
+
+    InjectionQueue _injectionQueues[_priorityCount];
+    std::mutex _injectionMutex;
+    std::atomic<size_t> _injectedTaskCount;
+
+    // The number of tasks in all queues, in total and for each priority
+    std::atomic<size_t> _queuedTaskCount;
+    std::atomic<size_t> _queuedTaskCounts[_priorityCount];
+
+    // The number of critical tasks which are not done
+    std::atomic<size_t> _criticalTaskCount;
+
+    std::mutex _sleepMutex;
     std::condition_variable _condition;
-    bool _stop;
+    std::atomic<size_t> _sleepingThreadCount;
+
+    // Threads blocked in Task::wait() (worker threads waiting on a task
+    // also count as sleeping)
+    std::condition_variable _waitCondition;
+    std::atomic<size_t> _waitingThreadCount;
+    std::atomic<bool> _stop;
 };
 
-}
\ No newline at end of file
+}
+
+#include "TaskPool.inl"
\ No newline at end of file
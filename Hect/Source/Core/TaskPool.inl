@@ -0,0 +1,355 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+namespace hect
+{
+
+template <typename Function>
+void TaskPool::parallelFor(size_t begin, size_t end, size_t grainSize, Function function)
+{
+    auto chunkFunction = [&function](size_t participant, size_t chunkBegin, size_t chunkEnd)
+    {
+        participant;
+        function(chunkBegin, chunkEnd);
+    };
+
+    size_t participantCount = _participantCount(begin, end, grainSize);
+    _parallelChunks(begin, end, grainSize, participantCount, chunkFunction);
+}
+
+template <typename T, typename MapFunction, typename ReduceFunction>
+T TaskPool::parallelReduce(size_t begin, size_t end, size_t grainSize, const T& identity, MapFunction map, ReduceFunction reduce)
+{
+    size_t participantCount = _participantCount(begin, end, grainSize);
+
+    // Each participant reduces the chunks it processes into its own value
+    std::vector<T> values(participantCount, identity);
+    auto chunkFunction = [&values, &map, &reduce](size_t participant, size_t chunkBegin, size_t chunkEnd)
+    {
+        values[participant] = reduce(values[participant], map(chunkBegin, chunkEnd));
+    };
+
+    _parallelChunks(begin, end, grainSize, participantCount, chunkFunction);
+
+    T result = identity;
+    for (const T& value : values)
+    {
+        result = reduce(result, value);
+    }
+    return result;
+}
+
+template <typename RandomAccessIterator>
+void TaskPool::parallelSort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type ValueType;
+    parallelSort(first, last, std::less<ValueType>());
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void TaskPool::parallelSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type ValueType;
+
+    const size_t minimumRunSize = 2048;
+
+    size_t count = last - first;
+    size_t runCount = _participantCount(0, count, minimumRunSize);
+    if (runCount <= 1)
+    {
+        std::stable_sort(first, last, compare);
+        return;
+    }
+
+    std::vector<ValueType> source(std::make_move_iterator(first), std::make_move_iterator(last));
+    std::vector<ValueType> destination(count);
+
+    // Sort a run for each participant
+    size_t runSize = (count + runCount - 1) / runCount;
+    parallelFor(0, runCount, 1, [&](size_t runBegin, size_t runEnd)
+    {
+        for (size_t run = runBegin; run < runEnd; ++run)
+        {
+            auto runFirst = source.begin() + run * runSize;
+            auto runLast = source.begin() + std::min((run + 1) * runSize, count);
+            std::stable_sort(runFirst, runLast, compare);
+        }
+    });
+
+    // Merge pairs of adjacent runs until a single run remains
+    for (; runSize < count; runSize *= 2)
+    {
+        size_t pairCount = (count + 2 * runSize - 1) / (2 * runSize);
+        parallelFor(0, pairCount, 1, [&](size_t pairBegin, size_t pairEnd)
+        {
+            for (size_t pair = pairBegin; pair < pairEnd; ++pair)
+            {
+                size_t low = pair * 2 * runSize;
+                size_t middle = std::min(low + runSize, count);
+                size_t high = std::min(low + 2 * runSize, count);
+                std::merge(std::make_move_iterator(source.begin() + low), std::make_move_iterator(source.begin() + middle),
+                           std::make_move_iterator(source.begin() + middle), std::make_move_iterator(source.begin() + high),
+                           destination.begin() + low, compare);
+            }
+        });
+
+        source.swap(destination);
+    }
+
+    std::move(source.begin(), source.end(), first);
+}
+
+template <typename T, typename KeyFunction>
+void TaskPool::parallelSortByKey(std::vector<T>& values, KeyFunction key)
+{
+    const size_t radixBits = 8;
+    const size_t radixSize = 1 << radixBits;
+    const size_t minimumBlockSize = 16384;
+
+    size_t count = values.size();
+
+    // Find which bytes of the keys are used at all
+    uint64_t usedBits = parallelReduce(0, count, minimumBlockSize, (uint64_t)0, [&](size_t begin, size_t end)
+    {
+        uint64_t bits = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            bits |= (uint64_t)key(values[i]);
+        }
+        return bits;
+    }, [](uint64_t a, uint64_t b)
+    {
+        return a | b;
+    });
+
+    size_t blockCount = _participantCount(0, count, minimumBlockSize);
+    size_t blockSize = blockCount > 0 ? (count + blockCount - 1) / blockCount : 0;
+
+    std::vector<T> buffer(count);
+    std::vector<size_t> offsets(radixSize * blockCount);
+
+    for (size_t shift = 0; shift < 64 && (usedBits >> shift) != 0; shift += radixBits)
+    {
+        // Skip digits which are zero in every key
+        if (((usedBits >> shift) & (radixSize - 1)) == 0)
+        {
+            continue;
+        }
+
+        // Count the occurrences of each digit within each block
+        std::fill(offsets.begin(), offsets.end(), 0);
+        parallelFor(0, blockCount, 1, [&](size_t blockBegin, size_t blockEnd)
+        {
+            for (size_t block = blockBegin; block < blockEnd; ++block)
+            {
+                size_t* blockCounts = &offsets[block * radixSize];
+                size_t last = std::min((block + 1) * blockSize, count);
+                for (size_t i = block * blockSize; i < last; ++i)
+                {
+                    ++blockCounts[((uint64_t)key(values[i]) >> shift) & (radixSize - 1)];
+                }
+            }
+        });
+
+        // Compute where each block writes each digit so that the order of
+        // values with equal digits is preserved
+        size_t offset = 0;
+        for (size_t digit = 0; digit < radixSize; ++digit)
+        {
+            for (size_t block = 0; block < blockCount; ++block)
+            {
+                size_t& blockOffset = offsets[block * radixSize + digit];
+                size_t digitCount = blockOffset;
+                blockOffset = offset;
+                offset += digitCount;
+            }
+        }
+
+        // Scatter the values
+        parallelFor(0, blockCount, 1, [&](size_t blockBegin, size_t blockEnd)
+        {
+            for (size_t block = blockBegin; block < blockEnd; ++block)
+            {
+                size_t* blockOffsets = &offsets[block * radixSize];
+                size_t last = std::min((block + 1) * blockSize, count);
+                for (size_t i = block * blockSize; i < last; ++i)
+                {
+                    size_t digit = ((uint64_t)key(values[i]) >> shift) & (radixSize - 1);
+                    buffer[blockOffsets[digit]++] = std::move(values[i]);
+                }
+            }
+        });
+
+        values.swap(buffer);
+    }
+}
+
+template <typename Condition>
+void TaskPool::_waitUntil(Condition condition, bool helpWithCriticalTasks)
+{
+    const unsigned spinCount = 64;
+    const size_t criticalLane = (size_t)TaskPriority::Critical;
+
+    size_t workerIndex = _currentWorkerIndex();
+    bool helping = workerIndex < _workers.size();
+
+    Telemetry& telemetry = _telemetryFor(workerIndex);
+    if (!condition())
+    {
+        telemetry.waitCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    unsigned spin = 0;
+    while (!condition())
+    {
+        // Execute other tasks while waiting on a worker thread so the
+        // worker is not idle and the task being waited on cannot be stuck
+        // behind the waiter
+        Task::Data* otherData;
+        if (helping && _take(workerIndex, otherData))
+        {
+            _execute(otherData, workerIndex);
+            spin = 0;
+            continue;
+        }
+        else if (!helping && helpWithCriticalTasks && _takeFromLane(workerIndex, criticalLane, otherData))
+        {
+            _execute(otherData, workerIndex);
+            spin = 0;
+            continue;
+        }
+
+        // Spin for a short while since most waits are short
+        if (spin < spinCount)
+        {
+            if (spin >= spinCount / 2)
+            {
+                std::this_thread::yield();
+            }
+            ++spin;
+            continue;
+        }
+
+        // Block until the condition is met (or until a task is queued that
+        // a worker thread can help with)
+        int64_t blockStartTime = _timingEnabled ? _now() : 0;
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        ++_waitingThreadCount;
+        if (helping)
+        {
+            ++_sleepingThreadCount;
+            while (!condition() && !_stop && _queuedTaskCount == 0)
+            {
+                _condition.wait(lock);
+            }
+            --_sleepingThreadCount;
+        }
+        else
+        {
+            while (!condition())
+            {
+                _waitCondition.wait(lock);
+            }
+        }
+        --_waitingThreadCount;
+        spin = 0;
+
+        if (blockStartTime != 0)
+        {
+            telemetry.waitTime += _now() - blockStartTime;
+        }
+    }
+}
+
+template <typename Function>
+void TaskPool::_parallelChunks(size_t begin, size_t end, size_t grainSize, size_t participantCount, Function& function)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    // Process the entire range on the calling thread if there is nothing to
+    // share
+    if (participantCount <= 1)
+    {
+        function(0, begin, end);
+        return;
+    }
+
+    // The state is shared with the helping tasks since a helping task may
+    // not start until after all chunks are processed
+    std::shared_ptr<ParallelState> state(new ParallelState(begin, end, grainSize, participantCount));
+    TaskPriority priority = _currentPriority();
+    for (size_t participant = 1; participant < participantCount; ++participant)
+    {
+        enqueue([state, participant, &function]
+        {
+            ++state->activeCount;
+            _participate(*state, participant, function);
+            --state->activeCount;
+        }, priority);
+    }
+
+    // Process chunks on the calling thread as well
+    _participate(*state, 0, function);
+
+    // Wait for the chunks claimed by worker threads to finish (helping with
+    // other tasks if on a worker thread); the helping tasks notify waiting
+    // threads as they complete
+    _waitUntil([&state]
+    {
+        return state->activeCount == 0;
+    }, false);
+
+    if (state->errorOccurred)
+    {
+        throw state->error;
+    }
+}
+
+template <typename Function>
+void TaskPool::_participate(ParallelState& state, size_t participant, Function& function)
+{
+    size_t chunkBegin;
+    size_t chunkEnd;
+    while (!state.errorOccurred && _claimChunk(state, chunkBegin, chunkEnd))
+    {
+        try
+        {
+            function(participant, chunkBegin, chunkEnd);
+        }
+        catch (Error& error)
+        {
+            std::lock_guard<std::mutex> lock(state.errorMutex);
+            if (!state.errorOccurred)
+            {
+                state.error = error;
+                state.errorOccurred = true;
+            }
+        }
+    }
+}
+
+}
\ No newline at end of file
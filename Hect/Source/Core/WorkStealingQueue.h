@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A lock-free double-ended queue where one thread (the owner) pushes and
+/// pops items at the bottom and any thread may steal items from the top.
+///
+/// \remarks Based on the Chase-Lev deque.  The owner pops items in the
+/// reverse order they were pushed (keeping recently pushed data hot in its
+/// cache) while thieves take the oldest items.  The items must be trivially
+/// copyable (typically pointers).
+template <typename T>
+class WorkStealingQueue :
+    public Uncopyable
+{
+public:
+
+    ///
+    /// Constructs an empty queue.
+    ///
+    /// \param capacity The initial capacity (must be a power of two); the
+    /// queue grows as needed.
+    WorkStealingQueue(size_t capacity = 256);
+
+    ///
+    /// Destroys the queue.
+    ~WorkStealingQueue();
+
+    ///
+    /// Pushes an item to the bottom of the queue.
+    ///
+    /// \warning Must only be called from the owning thread.
+    ///
+    /// \param item The item to push.
+    void push(T item);
+
+    ///
+    /// Pops the most recently pushed item from the bottom of the queue.
+    ///
+    /// \warning Must only be called from the owning thread.
+    ///
+    /// \param item The popped item.
+    ///
+    /// \returns True if an item was popped; false if the queue was empty.
+    bool pop(T& item);
+
+    ///
+    /// Steals the least recently pushed item from the top of the queue.
+    ///
+    /// \remarks May fail spuriously if another thread takes an item at the
+    /// same time.
+    ///
+    /// \param item The stolen item.
+    ///
+    /// \returns True if an item was stolen; false otherwise.
+    bool steal(T& item);
+
+    ///
+    /// Returns whether the queue appears to be empty.
+    ///
+    /// \remarks The result may be stale by the time it is used.
+    bool empty() const;
+
+private:
+    class Buffer
+    {
+    public:
+        Buffer(size_t capacity);
+        ~Buffer();
+
+        size_t capacity() const;
+        T get(int64_t index) const;
+        void put(int64_t index, T item);
+
+    private:
+        size_t _capacity;
+        std::atomic<T>* _items;
+    };
+
+    Buffer* _grow(Buffer* buffer, int64_t top, int64_t bottom);
+
+    std::atomic<int64_t> _top;
+    std::atomic<int64_t> _bottom;
+    std::atomic<Buffer*> _buffer;
+
+    // Buffers replaced by larger ones; kept until destruction since thieves
+    // may still be reading from them
+    std::vector<Buffer*> _retiredBuffers;
+};
+
+}
+
+#include "WorkStealingQueue.inl"
\ No newline at end of file
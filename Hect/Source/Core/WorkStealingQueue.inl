@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+namespace hect
+{
+
+template <typename T>
+WorkStealingQueue<T>::Buffer::Buffer(size_t capacity) :
+    _capacity(capacity),
+    _items(new std::atomic<T>[capacity])
+{
+}
+
+template <typename T>
+WorkStealingQueue<T>::Buffer::~Buffer()
+{
+    delete[] _items;
+}
+
+template <typename T>
+size_t WorkStealingQueue<T>::Buffer::capacity() const
+{
+    return _capacity;
+}
+
+template <typename T>
+T WorkStealingQueue<T>::Buffer::get(int64_t index) const
+{
+    return _items[(size_t)index & (_capacity - 1)].load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void WorkStealingQueue<T>::Buffer::put(int64_t index, T item)
+{
+    _items[(size_t)index & (_capacity - 1)].store(item, std::memory_order_relaxed);
+}
+
+template <typename T>
+WorkStealingQueue<T>::WorkStealingQueue(size_t capacity) :
+    _top(0),
+    _bottom(0),
+    _buffer(new Buffer(capacity))
+{
+}
+
+template <typename T>
+WorkStealingQueue<T>::~WorkStealingQueue()
+{
+    delete _buffer.load();
+    for (Buffer* buffer : _retiredBuffers)
+    {
+        delete buffer;
+    }
+}
+
+template <typename T>
+void WorkStealingQueue<T>::push(T item)
+{
+    int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    int64_t top = _top.load(std::memory_order_acquire);
+    Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+
+    // Grow the buffer if it is full
+    if (bottom - top > (int64_t)buffer->capacity() - 1)
+    {
+        buffer = _grow(buffer, top, bottom);
+    }
+
+    buffer->put(bottom, item);
+
+    // Publish the item before making it visible to thieves
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool WorkStealingQueue<T>::pop(T& item)
+{
+    int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+
+    // Order the reservation of the bottom item before reading the top
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        // The queue was empty
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    item = buffer->get(bottom);
+    if (top == bottom)
+    {
+        // This is the last item so race against thieves for it
+        bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    return true;
+}
+
+template <typename T>
+bool WorkStealingQueue<T>::steal(T& item)
+{
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+    {
+        return false;
+    }
+
+    Buffer* buffer = _buffer.load(std::memory_order_acquire);
+    T stolenItem = buffer->get(top);
+
+    // Claim the item unless the owner or another thief took it first
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    item = stolenItem;
+    return true;
+}
+
+template <typename T>
+bool WorkStealingQueue<T>::empty() const
+{
+    int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    int64_t top = _top.load(std::memory_order_relaxed);
+    return top >= bottom;
+}
+
+template <typename T>
+typename WorkStealingQueue<T>::Buffer* WorkStealingQueue<T>::_grow(Buffer* buffer, int64_t top, int64_t bottom)
+{
+    Buffer* grownBuffer = new Buffer(buffer->capacity() * 2);
+    for (int64_t i = top; i < bottom; ++i)
+    {
+        grownBuffer->put(i, buffer->get(i));
+    }
+
+    _retiredBuffers.push_back(buffer);
+    _buffer.store(grownBuffer, std::memory_order_release);
+    return grownBuffer;
+}
+
+}
\ No newline at end of file
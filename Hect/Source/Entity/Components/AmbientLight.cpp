@@ -42,7 +42,7 @@ void AmbientLight::setColor(const Vector3<>& color)
 
 void AmbientLightSerializer::save(const AmbientLight& light, DataWriter& writer) const
 {
-    writer.writeVector3("color", light.color());
+    writer.writeVector3("color", light.color(), VectorPrecision::Single);
 }
 
 void AmbientLightSerializer::load(AmbientLight& light, DataReader& reader, AssetCache& assetCache) const
@@ -53,8 +53,8 @@ void DirectionalLight::setColor(const Vector3<>& color)
 
 void DirectionalLightSerializer::save(const DirectionalLight& light, DataWriter& writer) const
 {
-    writer.writeVector3("direction", light.direction());
-    writer.writeVector3("color", light.color());
+    writer.writeVector3("direction", light.direction(), VectorPrecision::Normalized);
+    writer.writeVector3("color", light.color(), VectorPrecision::Single);
 }
 
 void DirectionalLightSerializer::load(DirectionalLight& light, DataReader& reader, AssetCache& assetCache) const
@@ -112,8 +112,8 @@ void RigidBody::setMesh(const AssetHandle<Mesh>& mesh)
 void RigidBodySerializer::save(const RigidBody& rigidBody, DataWriter& writer) const
 {
     writer.writeDouble("mass", rigidBody.mass());
-    writer.writeVector3("linearVelocity", rigidBody.linearVelocity());
-    writer.writeVector3("angularVelocity", rigidBody.angularVelocity());
+    writer.writeVector3("linearVelocity", rigidBody.linearVelocity(), VectorPrecision::Single);
+    writer.writeVector3("angularVelocity", rigidBody.angularVelocity(), VectorPrecision::Single);
     writer.writeString("mesh", rigidBody.mesh().path().toString());
 }
 
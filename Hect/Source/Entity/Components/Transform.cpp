@@ -126,7 +126,7 @@ void TransformSerializer::save(const Transform& transform, DataWriter& writer) c
     writer.writeVector3("position", transform.position());
     writer.writeVector3("scale", transform.scale());
     writer.beginObject("rotation");
-    writer.writeVector3("axis", axis);
+    writer.writeVector3("axis", axis, VectorPrecision::Normalized);
     writer.writeDouble("angle", angle.degrees());
     writer.endObject();
 }
@@ -56,14 +56,14 @@ void Entity::save(DataValue& dataValue) const
     _scene->entitySerializer().save(*this, dataValue);
 }
 
-void Entity::save(WriteStream& stream) const
+void Entity::save(WriteStream& stream, BinaryDataProfile profile) const
 {
     if (!_scene)
     {
         throw Error("Entity is null");
     }
 
-    _scene->entitySerializer().save(*this, stream);
+    _scene->entitySerializer().save(*this, stream, profile);
 }
 
 void Entity::load(const DataValue& dataValue, AssetCache& assetCache) const
@@ -80,7 +80,7 @@ void Entity::load(const DataValue& dataValue, AssetCache& assetCache) const
     _scene->entitySerializer().load(*this, dataValue, assetCache);
 }
 
-void Entity::load(ReadStream& stream, AssetCache& assetCache) const
+void Entity::load(const DataDocumentValue& value, AssetCache& assetCache) const
 {
     if (!_scene)
     {
@@ -91,7 +91,21 @@ void Entity::load(ReadStream& stream, AssetCache& assetCache) const
         throw Error("Entity is activated");
     }
 
-    _scene->entitySerializer().load(*this, stream, assetCache);
+    _scene->entitySerializer().load(*this, value, assetCache);
+}
+
+void Entity::load(ReadStream& stream, AssetCache& assetCache, BinaryDataProfile profile) const
+{
+    if (!_scene)
+    {
+        throw Error("Entity is null");
+    }
+    else if (isActivated())
+    {
+        throw Error("Entity is activated");
+    }
+
+    _scene->entitySerializer().load(*this, stream, assetCache, profile);
 }
 
 void Entity::destroy() const
@@ -186,6 +200,16 @@ std::vector<BaseComponent*> Entity::components() const
     return resultingComponents;
 }
 
+size_t Entity::componentCount() const
+{
+    if (!_scene)
+    {
+        throw Error("Entity is null");
+    }
+
+    return _scene->_entityComponents[_id].size();
+}
+
 Entity::operator bool() const
 {
     return !isNull();
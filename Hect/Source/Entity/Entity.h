@@ -67,9 +67,10 @@ public:
     /// Serializes the entity's components to a binary stream.
     ///
     /// \param stream The stream to write to.
+    /// \param profile The binary data profile to write the components in.
     ///
     /// \throws Error If the entity is null.
-    void save(WriteStream& stream) const;
+    void save(WriteStream& stream, BinaryDataProfile profile = BinaryDataProfile::Standard) const;
 
     ///
     /// Deserializes and adds components to the entity from a data value.
@@ -80,14 +81,25 @@ public:
     /// \throws Error If the entity is null or activated.
     void load(const DataValue& dataValue, AssetCache& assetCache) const;
 
+    ///
+    /// Deserializes and adds components to the entity from a value within a
+    /// data document.
+    ///
+    /// \param value The value.
+    /// \param assetCache The asset cache to use to load referenced assets.
+    ///
+    /// \throws Error If the entity is null or activated.
+    void load(const DataDocumentValue& value, AssetCache& assetCache) const;
+
     ///
     /// Deserializes and adds components to the entity from a binary stream.
     ///
     /// \param stream The stream to read from.
     /// \param assetCache The asset cache to use to load referenced assets.
+    /// \param profile The binary data profile the components were written in.
     ///
     /// \throws Error If the entity is null or activated.
-    void load(ReadStream& stream, AssetCache& assetCache) const;
+    void load(ReadStream& stream, AssetCache& assetCache, BinaryDataProfile profile = BinaryDataProfile::Standard) const;
 
     ///
     /// Activates the entity, enqueuing it to be added to systems in the scene
@@ -177,6 +189,24 @@ public:
     /// Returns the components of the entity.
     std::vector<BaseComponent*> components() const;
 
+    ///
+    /// Invokes an action for each component of the entity.
+    ///
+    /// \remarks Unlike components(), no memory is allocated.
+    ///
+    /// \param action The action to invoke with a reference to each component
+    /// (e.g. a lambda taking a BaseComponent&).
+    ///
+    /// \throws Error If the entity is null.
+    template <typename T>
+    void forEachComponent(T action) const;
+
+    ///
+    /// Returns the number of components the entity has.
+    ///
+    /// \throws Error If the entity is null.
+    size_t componentCount() const;
+
     ///
     /// Returns true if the entity is not null; false otherwise.
     operator bool() const;
@@ -57,4 +57,18 @@ T& Entity::component() const
     return _scene->_component<T>(*this);
 }
 
+template <typename T>
+void Entity::forEachComponent(T action) const
+{
+    if (!_scene)
+    {
+        throw Error("Entity is null");
+    }
+
+    for (auto& pair : _scene->_entityComponents[_id])
+    {
+        action(*pair.second);
+    }
+}
+
 }
\ No newline at end of file
@@ -25,7 +25,27 @@
 
 using namespace hect;
 
-EntitySerializer::EntitySerializer()
+namespace
+{
+
+const ComponentTypeId invalidTypeId = (ComponentTypeId)-1;
+
+// FNV-1a seeded with the perfect hash seed
+uint32_t hashTypeName(const char* typeName, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ seed;
+    for (const char* c = typeName; *c; ++c)
+    {
+        hash ^= (uint8_t)*c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+}
+
+EntitySerializer::EntitySerializer() :
+    _nameTableSeed(0)
 {
     // Register all hect components
     registerComponent<Camera, CameraSerializer>("Camera");
@@ -46,23 +66,21 @@ void EntitySerializer::save(const Entity& entity, DataValue& dataValue)
     dataValue = DataValue(DataValueType::Object);
 
     // For each component in the entity
-    for (BaseComponent* component : entity.components())
+    entity.forEachComponent([&](BaseComponent& component)
     {
-        ComponentTypeId typeId = component->componentTypeId();
-        const std::string& typeName = _typeName(typeId);
-        const BaseComponentSerializer& serializer = _serializer(typeId);
+        const ComponentType& componentType = _componentType(component.componentTypeId());
 
         // Serialize
         DataValueWriter writer;
-        serializer.save(component, writer);
+        componentType.serializer->save(&component, writer);
 
         // Save the resulting data value from the writer to the member data
         // value
-        dataValue.addMember(typeName, writer.currentDataValue());
-    }
+        dataValue.addMember(componentType.name, writer.currentDataValue());
+    });
 }
 
-void EntitySerializer::save(const Entity& entity, WriteStream& stream)
+void EntitySerializer::save(const Entity& entity, WriteStream& stream, BinaryDataProfile profile)
 {
     if (!entity)
     {
@@ -70,22 +88,21 @@ void EntitySerializer::save(const Entity& entity, WriteStream& stream)
     }
 
     // Write the number of components as a byte
-    std::vector<BaseComponent*> components = entity.components();
-    stream.writeByte((uint8_t)components.size());
+    stream.writeByte((uint8_t)entity.componentCount());
 
     // For each component in the entity
-    for (BaseComponent* component : components)
+    BinaryDataWriter writer(stream, profile);
+    entity.forEachComponent([&](BaseComponent& component)
     {
-        ComponentTypeId typeId = component->componentTypeId();
-        const BaseComponentSerializer& serializer = _serializer(typeId);
+        ComponentTypeId typeId = component.componentTypeId();
+        const ComponentType& componentType = _componentType(typeId);
 
         // Write the type id as a byte
         stream.writeByte((uint8_t)typeId);
 
         // Serialize
-        BinaryDataWriter writer(stream);
-        serializer.save(component, writer);
-    }
+        componentType.serializer->save(&component, writer);
+    });
 }
 
 void EntitySerializer::load(const Entity& entity, const DataValue& dataValue, AssetCache& assetCache)
@@ -98,22 +115,45 @@ void EntitySerializer::load(const Entity& entity, const DataValue& dataValue, As
     // For each component type name
     for (const std::string& typeName : dataValue.memberNames())
     {
-        ComponentTypeId typeId = _typeId(typeName);
-        const BaseComponentSerializer& serializer = _serializer(typeId);
+        const ComponentType& componentType = _componentType(_typeId(typeName.c_str()));
 
         // Create component
-        BaseComponent* component = _constructComponent(typeId);
+        BaseComponent* component = componentType.constructor();
 
         // Deserialize
         DataValueReader reader(dataValue[typeName]);
-        serializer.load(component, reader, assetCache);
+        componentType.serializer->load(component, reader, assetCache);
+
+        // Add component
+        entity.addComponent(component);
+    }
+}
+
+void EntitySerializer::load(const Entity& entity, const DataDocumentValue& value, AssetCache& assetCache)
+{
+    if (!entity)
+    {
+        throw Error("Entity is null");
+    }
+
+    // For each component type name
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+        const ComponentType& componentType = _componentType(_typeId(value.memberName(i)));
+
+        // Create component
+        BaseComponent* component = componentType.constructor();
+
+        // Deserialize
+        DataDocumentReader reader(value.memberValue(i));
+        componentType.serializer->load(component, reader, assetCache);
 
         // Add component
         entity.addComponent(component);
     }
 }
 
-void EntitySerializer::load(const Entity& entity, ReadStream& stream, AssetCache& assetCache)
+void EntitySerializer::load(const Entity& entity, ReadStream& stream, AssetCache& assetCache, BinaryDataProfile profile)
 {
     if (!entity)
     {
@@ -124,59 +164,132 @@ void EntitySerializer::load(const Entity& entity, ReadStream& stream, AssetCache
     uint8_t componentCount = stream.readByte();
 
     // For each component
+    BinaryDataReader reader(stream, profile);
     for (uint8_t i = 0; i < componentCount; ++i)
     {
         ComponentTypeId typeId = stream.readByte();
-        const BaseComponentSerializer& serializer = _serializer(typeId);
+        const ComponentType& componentType = _componentType(typeId);
 
         // Create component
-        BaseComponent* component = _constructComponent(typeId);
+        BaseComponent* component = componentType.constructor();
 
         // Deserialize
-        BinaryDataReader reader(stream);
-        serializer.load(component, reader, assetCache);
+        componentType.serializer->load(component, reader, assetCache);
 
         // Add component
         entity.addComponent(component);
     }
 }
 
-ComponentTypeId EntitySerializer::_typeId(const std::string& typeName) const
+void EntitySerializer::_registerComponent(ComponentTypeId typeId, const std::string& typeName, BaseComponentSerializer* serializer, const std::function<BaseComponent*()>& constructor)
 {
-    auto it = _componentTypeIds.find(typeName);
-    if (it == _componentTypeIds.end())
+    BaseComponentSerializer::Ref serializerRef(serializer);
+
+    // Check that the type name is not already registered
+    if (_findTypeId(typeName.c_str()) != invalidTypeId)
+    {
+        throw Error(format("Component type '%s' is already registered", typeName.c_str()));
+    }
+
+    // Check that the type id is not already registered
+    if (typeId < _componentTypes.size() && _componentTypes[typeId].serializer)
+    {
+        throw Error(format("Component type id '%d' is already registered", typeId));
+    }
+
+    if (typeId >= _componentTypes.size())
     {
-        throw Error(format("No serializer registered for component type name '%s'", typeName.c_str()));
+        _componentTypes.resize(typeId + 1);
     }
-    return (*it).second;
+
+    ComponentType& componentType = _componentTypes[typeId];
+    componentType.name = typeName;
+    componentType.serializer = serializerRef;
+    componentType.constructor = constructor;
+
+    _buildNameTable();
 }
 
-const std::string& EntitySerializer::_typeName(ComponentTypeId typeId) const
+void EntitySerializer::_buildNameTable()
 {
-    auto it = _componentTypeNames.find(typeId);
-    if (it == _componentTypeNames.end())
+    size_t typeCount = 0;
+    for (const ComponentType& componentType : _componentTypes)
     {
-        throw Error(format("No serializer registered for component type id '%d'", typeId));
+        if (componentType.serializer)
+        {
+            ++typeCount;
+        }
+    }
+
+    // Start with a load factor of at most one half
+    size_t size = 1;
+    while (size < typeCount * 2)
+    {
+        size *= 2;
+    }
+
+    // Search for a seed which hashes every name to a unique slot, growing
+    // the table if none is found quickly
+    for (;;)
+    {
+        for (uint32_t seed = 0; seed < 64; ++seed)
+        {
+            std::vector<ComponentTypeId> table(size, invalidTypeId);
+
+            bool collision = false;
+            for (ComponentTypeId typeId = 0; typeId < _componentTypes.size() && !collision; ++typeId)
+            {
+                const ComponentType& componentType = _componentTypes[typeId];
+                if (componentType.serializer)
+                {
+                    ComponentTypeId& slot = table[hashTypeName(componentType.name.c_str(), seed) & (size - 1)];
+                    collision = slot != invalidTypeId;
+                    slot = typeId;
+                }
+            }
+
+            if (!collision)
+            {
+                _nameTable = std::move(table);
+                _nameTableSeed = seed;
+                return;
+            }
+        }
+
+        size *= 2;
     }
-    return (*it).second;
 }
 
-const BaseComponentSerializer& EntitySerializer::_serializer(ComponentTypeId typeId) const
+ComponentTypeId EntitySerializer::_findTypeId(const char* typeName) const
 {
-    auto it = _componentSerializers.find(typeId);
-    if (it == _componentSerializers.end())
+    if (_nameTable.empty())
     {
-        throw Error(format("No serializer registered for component type id '%d'", typeId));
+        return invalidTypeId;
+    }
+
+    ComponentTypeId typeId = _nameTable[hashTypeName(typeName, _nameTableSeed) & (_nameTable.size() - 1)];
+    if (typeId == invalidTypeId || _componentTypes[typeId].name != typeName)
+    {
+        return invalidTypeId;
+    }
+    return typeId;
+}
+
+ComponentTypeId EntitySerializer::_typeId(const char* typeName) const
+{
+    ComponentTypeId typeId = _findTypeId(typeName);
+    if (typeId == invalidTypeId)
+    {
+        throw Error(format("No serializer registered for component type name '%s'", typeName));
     }
-    return *(*it).second;
+    return typeId;
 }
 
-BaseComponent* EntitySerializer::_constructComponent(ComponentTypeId typeId) const
+const EntitySerializer::ComponentType& EntitySerializer::_componentType(ComponentTypeId typeId) const
 {
-    auto it = _componentConstructors.find(typeId);
-    if (it == _componentConstructors.end())
+    if (typeId >= _componentTypes.size() || !_componentTypes[typeId].serializer)
     {
         throw Error(format("No serializer registered for component type id '%d'", typeId));
     }
-    return (*it).second();
+    return _componentTypes[typeId];
 }
\ No newline at end of file
@@ -54,9 +54,10 @@ public:
     ///
     /// \param entity The entity.
     /// \param stream The stream to write to.
+    /// \param profile The binary data profile to write the components in.
     ///
     /// \throws Error If the entity is null.
-    void save(const Entity& entity, WriteStream& stream);
+    void save(const Entity& entity, WriteStream& stream, BinaryDataProfile profile = BinaryDataProfile::Standard);
 
     ///
     /// Deserializes and adds components to an entity from a data value.
@@ -68,15 +69,27 @@ public:
     /// \throws Error If the entity is null or activated.
     void load(const Entity& entity, const DataValue& dataValue, AssetCache& assetCache);
 
+    ///
+    /// Deserializes and adds components to an entity from a value within a
+    /// data document.
+    ///
+    /// \param entity The entity.
+    /// \param value The value.
+    /// \param assetCache The asset cache to use to load referenced assets.
+    ///
+    /// \throws Error If the entity is null or activated.
+    void load(const Entity& entity, const DataDocumentValue& value, AssetCache& assetCache);
+
     ///
     /// Deserializes and adds components to an entity from a binary stream.
     ///
     /// \param entity The entity.
     /// \param stream The stream to read from.
     /// \param assetCache The asset cache to use to load referenced assets.
+    /// \param profile The binary data profile the components were written in.
     ///
     /// \throws Error If the entity is null or activated.
-    void load(const Entity& entity, ReadStream& stream, AssetCache& assetCache);
+    void load(const Entity& entity, ReadStream& stream, AssetCache& assetCache, BinaryDataProfile profile = BinaryDataProfile::Standard);
 
     ///
     /// Registers a component with its serializer.
@@ -88,22 +101,27 @@ public:
     void registerComponent(const std::string& componentTypeName);
 
 private:
-    ComponentTypeId _typeId(const std::string& typeName) const;
-    const std::string& _typeName(ComponentTypeId typeId) const;
-    const BaseComponentSerializer& _serializer(ComponentTypeId typeId) const;
-    BaseComponent* _constructComponent(ComponentTypeId typeId) const;
-
-    // Component types mapped to component type names
-    std::map<ComponentTypeId, std::string> _componentTypeNames;
-
-    // Component type names mapped to component types
-    std::map<std::string, ComponentTypeId> _componentTypeIds;
-
-    // Component types mapped to registered component serializers
-    std::map<ComponentTypeId, BaseComponentSerializer::Ref> _componentSerializers;
-
-    // Component types mapped to component constructors
-    std::map<ComponentTypeId, std::function<BaseComponent*()>> _componentConstructors;
+    struct ComponentType
+    {
+        std::string name;
+        BaseComponentSerializer::Ref serializer;
+        std::function<BaseComponent*()> constructor;
+    };
+
+    void _registerComponent(ComponentTypeId typeId, const std::string& typeName, BaseComponentSerializer* serializer, const std::function<BaseComponent*()>& constructor);
+    void _buildNameTable();
+
+    ComponentTypeId _findTypeId(const char* typeName) const;
+    ComponentTypeId _typeId(const char* typeName) const;
+    const ComponentType& _componentType(ComponentTypeId typeId) const;
+
+    // Registered component types indexed by component type id (the
+    // serializer is null for unregistered ids)
+    std::vector<ComponentType> _componentTypes;
+
+    // Component type ids indexed by the perfect hash of their type names
+    std::vector<ComponentTypeId> _nameTable;
+    uint32_t _nameTableSeed;
 };
 
 }
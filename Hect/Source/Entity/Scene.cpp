@@ -165,8 +165,10 @@ void Scene::save(DataValue& dataValue) const
     dataValue.addMember("entities", entities);
 }
 
-void Scene::save(WriteStream& stream) const
+void Scene::save(WriteStream& stream, BinaryDataProfile profile) const
 {
+    BinaryDataFormat::writeHeader(stream, profile);
+
     // Serialize each activated entity to the stream
     for (Entity::Id id = 0; id < _entityData.size(); ++id)
     {
@@ -174,7 +176,7 @@ void Scene::save(WriteStream& stream) const
         if (entity && entity.isActivated() && entity.isSerializable())
         {
             // Serialize the entity
-            entity.save(stream);
+            entity.save(stream, profile);
         }
     }
 }
@@ -189,8 +191,8 @@ void Scene::load(const DataValue& dataValue, AssetCache& assetCache)
         if (entityValue.isString())
         {
             // Load the components using the referenced file
-            DataValue& value = assetCache.get<DataValue>(entityValue.asString());
-            entity.load(value, assetCache);
+            DataDocument& document = assetCache.get<DataDocument>(entityValue.asString());
+            entity.load(document.root(), assetCache);
         }
         else
         {
@@ -202,14 +204,39 @@ void Scene::load(const DataValue& dataValue, AssetCache& assetCache)
     }
 }
 
+void Scene::load(const DataDocumentValue& value, AssetCache& assetCache)
+{
+    // For each entity value
+    for (DataDocumentValue entityValue : value["entities"])
+    {
+        Entity entity = createEntity();
+
+        if (entityValue.isString())
+        {
+            // Load the components using the referenced file
+            DataDocument& document = assetCache.get<DataDocument>(entityValue.asString());
+            entity.load(document.root(), assetCache);
+        }
+        else
+        {
+            // Load the components using the inline value
+            entity.load(entityValue, assetCache);
+        }
+
+        entity.activate();
+    }
+}
+
 void Scene::load(ReadStream& stream, AssetCache& assetCache)
 {
+    BinaryDataProfile profile = BinaryDataFormat::readHeader(stream);
+
     // While there is still data in the stream
     while (!stream.endOfStream())
     {
         // Create an entity and load the components
         Entity entity = createEntity();
-        entity.load(stream, assetCache);
+        entity.load(stream, assetCache, profile);
         entity.activate();
     }
 }
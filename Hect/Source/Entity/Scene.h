@@ -88,8 +88,12 @@ public:
     ///
     /// Serializes all activated entities in the scene to a binary stream.
     ///
+    /// \remarks The entities are preceded by a header identifying the profile
+    /// and version of the data.
+    ///
     /// \param stream The stream to write to.
-    void save(WriteStream& stream) const;
+    /// \param profile The binary data profile to write the entities in.
+    void save(WriteStream& stream, BinaryDataProfile profile = BinaryDataProfile::Standard) const;
 
     ///
     /// Deserializes all entities from a data value and activates them in the
@@ -99,12 +103,22 @@ public:
     /// \param assetCache The asset cache to use to load referenced assets.
     void load(const DataValue& dataValue, AssetCache& assetCache);
 
+    ///
+    /// Deserializes all entities from a value within a data document and
+    /// activates them in the scene.
+    ///
+    /// \param value The value.
+    /// \param assetCache The asset cache to use to load referenced assets.
+    void load(const DataDocumentValue& value, AssetCache& assetCache);
+
     ///
     /// Deserializes all entities from a binary stream and activates them in
     /// the scene.
     ///
     /// \param stream The stream to read from.
     /// \param assetCache The asset cache to use to load referenced assets.
+    ///
+    /// \throws Error If the header of the data is invalid.
     void load(ReadStream& stream, AssetCache& assetCache);
     
     ///
@@ -36,6 +36,16 @@ Image::Image(unsigned width, unsigned height, PixelType pixelType, PixelFormat p
     _pixelData = RawPixelData(totalSize, 0);
 }
 
+Image::Image(const Image& image) :
+    _width(image._width),
+    _height(image._height),
+    _pixelType(image._pixelType),
+    _pixelFormat(image._pixelFormat),
+    _colorSpace(image._colorSpace),
+    _pixelData(image._pixelData)
+{
+}
+
 Image::Image(Image&& image) :
     _width(image._width),
     _height(image._height),
@@ -46,17 +56,45 @@ Image::Image(Image&& image) :
 {
 }
 
+Image& Image::operator=(const Image& image)
+{
+    _width = image._width;
+    _height = image._height;
+    _pixelType = image._pixelType;
+    _pixelFormat = image._pixelFormat;
+    _colorSpace = image._colorSpace;
+    _pixelData = image._pixelData;
+
+    return *this;
+}
+
+Image& Image::operator=(Image&& image)
+{
+    _width = image._width;
+    _height = image._height;
+    _pixelType = image._pixelType;
+    _pixelFormat = image._pixelFormat;
+    _colorSpace = image._colorSpace;
+    _pixelData = std::move(image._pixelData);
+
+    return *this;
+}
+
 void Image::flipVertical()
 {
+    _swapRows(0, _height / 2);
+}
+
+void Image::flipVertical(TaskPool& taskPool)
+{
+    // Swap at least 16 KB worth of rows in each chunk
     size_t bytesPerRow = bytesPerPixel() * _width;
-    RawPixelData newPixelData(_pixelData.size(), 0);
-    for (unsigned i = 0; i < _height; ++i)
+    size_t grainSize = std::max<size_t>(1, 16384 / std::max<size_t>(bytesPerRow, 1));
+
+    taskPool.parallelFor(0, _height / 2, grainSize, [this](size_t begin, size_t end)
     {
-        size_t sourceRowOffset = bytesPerRow * i;
-        size_t destRowOffset = bytesPerRow * (_height - i - 1);
-        std::memcpy(&newPixelData[sourceRowOffset], &_pixelData[destRowOffset], bytesPerRow);
-    }
-    _pixelData = std::move(newPixelData);
+        _swapRows((unsigned)begin, (unsigned)end);
+    });
 }
 
 Image::RawPixelData& Image::pixelData()
@@ -122,4 +160,26 @@ int Image::bytesPerPixel() const
     }
 
     return 0;
+}
+
+void Image::_swapRows(unsigned begin, unsigned end)
+{
+    // Swap each row in the top half with its mirror in the bottom half
+    size_t bytesPerRow = bytesPerPixel() * _width;
+    for (unsigned i = begin; i < end; ++i)
+    {
+        auto topRow = _pixelData.begin() + bytesPerRow * i;
+        auto bottomRow = _pixelData.begin() + bytesPerRow * (_height - i - 1);
+        std::swap_ranges(topRow, topRow + bytesPerRow, bottomRow);
+    }
+}
+
+namespace hect
+{
+
+size_t assetMemorySize(const Image& image)
+{
+    return sizeof(Image) + image.pixelData().size();
+}
+
 }
\ No newline at end of file
@@ -97,16 +97,44 @@ public:
     /// \param colorSpace The color space.
     Image(unsigned width = 1, unsigned height = 1, PixelType pixelType = PixelType::Byte, PixelFormat pixelFormat = PixelFormat::Rgba, ColorSpace colorSpace = ColorSpace::Linear);
 
+    ///
+    /// Constructs an image as a copy of another.
+    ///
+    /// \param image The image to copy.
+    Image(const Image& image);
+
     ///
     /// Constructs an image moved from another.
     ///
     /// \param image The image to move.
     Image(Image&& image);
 
+    ///
+    /// Replaces the image with a copy of another.
+    ///
+    /// \param image The image to copy.
+    ///
+    /// \returns A reference to the image.
+    Image& operator=(const Image& image);
+
+    ///
+    /// Replaces the image with one moved from another.
+    ///
+    /// \param image The image to move.
+    ///
+    /// \returns A reference to the image.
+    Image& operator=(Image&& image);
+
     ///
     /// Flips the image vertically.
     void flipVertical();
 
+    ///
+    /// Flips the image vertically, swapping rows in parallel.
+    ///
+    /// \param taskPool The task pool to swap the rows in.
+    void flipVertical(TaskPool& taskPool);
+
     ///
     /// Returns the raw pixel data.
     RawPixelData& pixelData();
@@ -140,6 +168,8 @@ public:
     int bytesPerPixel() const;
 
 private:
+    void _swapRows(unsigned begin, unsigned end);
+
     unsigned _width;
     unsigned _height;
 
@@ -151,4 +181,10 @@ private:
     RawPixelData _pixelData;
 };
 
+///
+/// Returns the approximate number of bytes of memory used by an image.
+///
+/// \param image The image.
+size_t assetMemorySize(const Image& image);
+
 }
\ No newline at end of file
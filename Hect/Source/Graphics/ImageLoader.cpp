@@ -28,5 +28,15 @@ using namespace hect;
 void AssetLoader<Image>::load(Image& image, const Path& assetPath, AssetCache& assetCache)
 {
     FileReadStream stream = assetCache.fileSystem().openFileForRead(assetPath);
-    ImagePngFormat().load(image, stream);
+
+    // Decode directly from the pack if the image is in one
+    const uint8_t* contents = stream.contents();
+    if (contents)
+    {
+        ImagePngFormat().load(image, contents, stream.length());
+    }
+    else
+    {
+        ImagePngFormat().load(image, stream);
+    }
 }
@@ -29,17 +29,22 @@ using namespace hect;
 
 void ImagePngFormat::load(Image& image, ReadStream& stream)
 {
-    image._pixelData.clear();
-
     // Load the PNG pixel data
     size_t length = stream.length();
     Image::RawPixelData encodedPixelData(length, 0);
     stream.readBytes(&encodedPixelData[0], length);
 
+    load(image, &encodedPixelData[0], length);
+}
+
+void ImagePngFormat::load(Image& image, const uint8_t* data, size_t length)
+{
+    image._pixelData.clear();
+
     // Decode the PNG pixel data
     unsigned width = 0;
     unsigned height = 0;
-    unsigned error = lodepng::decode(image._pixelData, width, height, encodedPixelData);
+    unsigned error = lodepng::decode(image._pixelData, width, height, data, length);
     if (error)
     {
         throw Error(format("Failed to decode PNG data: %s", lodepng_error_text(error)));
@@ -41,6 +41,16 @@ public:
     /// \param stream The stream containing the PNG data.
     void load(Image& image, ReadStream& stream);
 
+    ///
+    /// Loads an image from PNG data in memory.
+    ///
+    /// \remarks The resulting image will be 32-bit RGBA.
+    ///
+    /// \param image The image to load to (existing data is lost).
+    /// \param data A pointer to the PNG data.
+    /// \param length The length of the PNG data in bytes.
+    void load(Image& image, const uint8_t* data, size_t length);
+
     ///
     /// Saves an image as PNG data to a stream.
     ///
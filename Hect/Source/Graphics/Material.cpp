@@ -35,6 +35,38 @@ Material::Material(const std::string& name, const Technique::Array& techniques)
 {
 }
 
+Material::Material(const std::string& name, Technique::Array&& techniques) :
+    _name(name),
+    _techniques(std::move(techniques))
+{
+}
+
+Material::Material(const Material& material) :
+    _name(material._name),
+    _techniques(material._techniques)
+{
+}
+
+Material::Material(Material&& material) :
+    _name(std::move(material._name)),
+    _techniques(std::move(material._techniques))
+{
+}
+
+Material& Material::operator=(const Material& material)
+{
+    _name = material._name;
+    _techniques = material._techniques;
+    return *this;
+}
+
+Material& Material::operator=(Material&& material)
+{
+    _name = std::move(material._name);
+    _techniques = std::move(material._techniques);
+    return *this;
+}
+
 const std::string& Material::name() const
 {
     return _name;
@@ -43,6 +43,41 @@ public:
     /// \param techniques The techniques to include in the material.
     Material(const std::string& name, const Technique::Array& techniques);
 
+    ///
+    /// Constructs a material by moving the techniques into it.
+    ///
+    /// \param name The name of the material.
+    /// \param techniques The techniques to include in the material.
+    Material(const std::string& name, Technique::Array&& techniques);
+
+    ///
+    /// Constructs a material as a copy of another.
+    ///
+    /// \param material The material to copy.
+    Material(const Material& material);
+
+    ///
+    /// Constructs a material moved from another.
+    ///
+    /// \param material The material to move.
+    Material(Material&& material);
+
+    ///
+    /// Replaces the material with a copy of another.
+    ///
+    /// \param material The material to copy.
+    ///
+    /// \returns A reference to the material.
+    Material& operator=(const Material& material);
+
+    ///
+    /// Replaces the material with one moved from another.
+    ///
+    /// \param material The material to move.
+    ///
+    /// \returns A reference to the material.
+    Material& operator=(Material&& material);
+
     ///
     /// Returns the name.
     const std::string& name() const;
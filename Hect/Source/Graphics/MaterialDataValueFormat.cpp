@@ -41,10 +41,11 @@ void MaterialDataValueFormat::load(Material& material, const std::string& name,
     size_t techniqueIndex = 0;
     for (const DataValue& techniqueValue : dataValue["techniques"])
     {
+        // Take the passes of the technique being replaced without copying
         Pass::Array passes;
         if (techniqueIndex < techniques.size())
         {
-            passes = techniques[techniqueIndex].passes();
+            passes = std::move(techniques[techniqueIndex].passes());
         }
 
         // Passes
@@ -151,13 +152,13 @@ void MaterialDataValueFormat::load(Material& material, const std::string& name,
             // Append a new texture if needed
             if (passIndex >= passes.size())
             {
-                passes.push_back(Pass(renderMode, textures, shader, uniformValues));
+                passes.push_back(Pass(renderMode, std::move(textures), shader, std::move(uniformValues)));
             }
 
             // Otherwise replace the texture already existing at the index
             else
             {
-                passes[passIndex] = Pass(renderMode, textures, shader, uniformValues);
+                passes[passIndex] = Pass(renderMode, std::move(textures), shader, std::move(uniformValues));
             }
 
             ++passIndex;
@@ -165,17 +166,17 @@ void MaterialDataValueFormat::load(Material& material, const std::string& name,
 
         if (techniqueIndex < techniques.size())
         {
-            techniques[techniqueIndex] = Technique(passes);
+            techniques[techniqueIndex] = Technique(std::move(passes));
         }
         else
         {
-            techniques.push_back(Technique(passes));
+            techniques.push_back(Technique(std::move(passes)));
         }
 
         ++techniqueIndex;
     }
 
-    material = Material(name, techniques);
+    material = Material(name, std::move(techniques));
 }
 
 RenderState MaterialDataValueFormat::_parseState(const DataValue& dataValue)
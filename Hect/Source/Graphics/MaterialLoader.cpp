@@ -28,9 +28,6 @@ using namespace hect;
 void AssetLoader<Material>::load(Material& material, const Path& assetPath, AssetCache& assetCache)
 {
     DataValue dataValue;
-    {
-        FileReadStream stream = assetCache.fileSystem().openFileForRead(assetPath);
-        DataValueJsonFormat::load(dataValue, stream);
-    }
+    AssetLoader<DataValue>::load(dataValue, assetPath, assetCache);
     MaterialDataValueFormat::load(material, assetPath.toString(), dataValue, assetCache);
 }
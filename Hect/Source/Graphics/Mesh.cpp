@@ -56,6 +56,64 @@ Mesh::Mesh(const Mesh& mesh) :
 {
 }
 
+Mesh::Mesh(Mesh&& mesh) :
+    _name(std::move(mesh._name)),
+    _vertexLayout(std::move(mesh._vertexLayout)),
+    _primitiveType(mesh._primitiveType),
+    _indexType(mesh._indexType),
+    _vertexData(std::move(mesh._vertexData)),
+    _indexData(std::move(mesh._indexData)),
+    _vertexCount(mesh._vertexCount),
+    _indexCount(mesh._indexCount),
+    _boundingBox(mesh._boundingBox)
+{
+    mesh._vertexCount = 0;
+    mesh._indexCount = 0;
+}
+
+Mesh& Mesh::operator=(const Mesh& mesh)
+{
+    if (isUploaded())
+    {
+        throw Error("Attempt to assign to a mesh that is uploaded");
+    }
+
+    _name = mesh._name;
+    _vertexLayout = mesh._vertexLayout;
+    _primitiveType = mesh._primitiveType;
+    _indexType = mesh._indexType;
+    _vertexData = mesh._vertexData;
+    _indexData = mesh._indexData;
+    _vertexCount = mesh._vertexCount;
+    _indexCount = mesh._indexCount;
+    _boundingBox = mesh._boundingBox;
+
+    return *this;
+}
+
+Mesh& Mesh::operator=(Mesh&& mesh)
+{
+    if (isUploaded())
+    {
+        throw Error("Attempt to assign to a mesh that is uploaded");
+    }
+
+    _name = std::move(mesh._name);
+    _vertexLayout = std::move(mesh._vertexLayout);
+    _primitiveType = mesh._primitiveType;
+    _indexType = mesh._indexType;
+    _vertexData = std::move(mesh._vertexData);
+    _indexData = std::move(mesh._indexData);
+    _vertexCount = mesh._vertexCount;
+    _indexCount = mesh._indexCount;
+    _boundingBox = mesh._boundingBox;
+
+    mesh._vertexCount = 0;
+    mesh._indexCount = 0;
+
+    return *this;
+}
+
 const std::string& Mesh::name() const
 {
     return _name;
@@ -72,6 +130,17 @@ void Mesh::setVertexData(const VertexData& vertexData)
     _vertexCount = vertexData.size() / _vertexLayout.vertexSize();
 }
 
+void Mesh::setVertexData(VertexData&& vertexData)
+{
+    if (_vertexData.size() > 0)
+    {
+        throw Error("Attempt to set the vertex data of a mesh with vertex data");
+    }
+
+    _vertexData = std::move(vertexData);
+    _vertexCount = _vertexData.size() / _vertexLayout.vertexSize();
+}
+
 const Mesh::VertexData& Mesh::vertexData() const
 {
     return _vertexData;
@@ -93,6 +162,17 @@ void Mesh::setIndexData(const IndexData& indexData)
     _indexCount = indexData.size() / indexSize();
 }
 
+void Mesh::setIndexData(IndexData&& indexData)
+{
+    if (_indexData.size() > 0)
+    {
+        throw Error("Attempt to set the index data of a mesh with index data");
+    }
+
+    _indexData = std::move(indexData);
+    _indexCount = _indexData.size() / indexSize();
+}
+
 const Mesh::IndexData& Mesh::indexData() const
 {
     return _indexData;
@@ -140,4 +220,14 @@ AxisAlignedBox<float>& Mesh::boundingBox()
 const AxisAlignedBox<float>& Mesh::boundingBox() const
 {
     return _boundingBox;
+}
+
+namespace hect
+{
+
+size_t assetMemorySize(const Mesh& mesh)
+{
+    return sizeof(Mesh) + mesh.vertexData().size() + mesh.indexData().size();
+}
+
 }
\ No newline at end of file
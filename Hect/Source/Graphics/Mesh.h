@@ -82,6 +82,35 @@ public:
     /// \param mesh The mesh to copy from.
     Mesh(const Mesh& mesh);
 
+    ///
+    /// Constructs a mesh moved from another mesh.
+    ///
+    /// \remarks The vertex and index data is moved without being copied.
+    /// The mesh moved from is left without vertex or index data.
+    ///
+    /// \param mesh The mesh to move.
+    Mesh(Mesh&& mesh);
+
+    ///
+    /// Replaces the mesh with a copy of another mesh.
+    ///
+    /// \param mesh The mesh to copy from.
+    ///
+    /// \returns A reference to the mesh.
+    ///
+    /// \throws Error If the mesh is uploaded.
+    Mesh& operator=(const Mesh& mesh);
+
+    ///
+    /// Replaces the mesh with one moved from another mesh.
+    ///
+    /// \param mesh The mesh to move.
+    ///
+    /// \returns A reference to the mesh.
+    ///
+    /// \throws Error If the mesh is uploaded.
+    Mesh& operator=(Mesh&& mesh);
+
     ///
     /// Returns the name.
     const std::string& name() const;
@@ -95,6 +124,15 @@ public:
     /// \throws Error If the mesh has vertex data.
     void setVertexData(const VertexData& vertexData);
 
+    ///
+    /// Sets the raw vertex data by moving it into the mesh.
+    ///
+    /// \param vertexData The vertex data to move.  Assumed to conform to
+    /// the vertex layout.
+    ///
+    /// \throws Error If the mesh has vertex data.
+    void setVertexData(VertexData&& vertexData);
+
     ///
     /// Returns the raw vertex data.
     const VertexData& vertexData() const;
@@ -112,6 +150,15 @@ public:
     /// \throws Error If the mesh has vertex data.
     void setIndexData(const IndexData& indexData);
 
+    ///
+    /// Sets the raw index data by moving it into the mesh.
+    ///
+    /// \param indexData The index data to move.  Assumed to conform to the
+    /// index type.
+    ///
+    /// \throws Error If the mesh has index data.
+    void setIndexData(IndexData&& indexData);
+
     ///
     /// Returns the raw index data.
     const IndexData& indexData() const;
@@ -160,4 +207,10 @@ private:
     AxisAlignedBox<float> _boundingBox;
 };
 
+///
+/// Returns the approximate number of bytes of memory used by a mesh.
+///
+/// \param mesh The mesh.
+size_t assetMemorySize(const Mesh& mesh);
+
 }
\ No newline at end of file
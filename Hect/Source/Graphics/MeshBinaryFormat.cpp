@@ -70,9 +70,9 @@ void MeshBinaryFormat::load(Mesh& mesh, const std::string& name, ReadStream& str
     Mesh::IndexData indexData(indexDataSize);
     stream.readBytes(&indexData[0], indexDataSize);
     
-    // Set vertex/index data
-    mesh.setVertexData(vertexData);
-    mesh.setIndexData(indexData);
+    // Move the vertex/index data into the mesh
+    mesh.setVertexData(std::move(vertexData));
+    mesh.setIndexData(std::move(indexData));
 }
 
 void MeshBinaryFormat::save(const Mesh& mesh, WriteStream& stream)
@@ -36,6 +36,12 @@ void AssetLoader<Mesh>::load(Mesh& mesh, const Path& assetPath, AssetCache& asse
     {
         MeshBinaryFormat::load(mesh, assetPath.toString(), stream);
     }
+    else if (signature == DataValueBinaryFormat::Signature)
+    {
+        DataValue dataValue;
+        DataValueBinaryFormat::load(dataValue, stream);
+        MeshDataValueFormat::load(mesh, assetPath.toString(), dataValue);
+    }
     else
     {
         DataValue dataValue;
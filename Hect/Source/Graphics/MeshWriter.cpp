@@ -27,6 +27,14 @@ using namespace hect;
 
 MeshWriter::MeshWriter(Mesh& mesh) :
     _mesh(&mesh),
+    _boundingBox(&mesh.boundingBox()),
+    _vertexDataIndex(0)
+{
+}
+
+MeshWriter::MeshWriter(Mesh& mesh, AxisAlignedBox<float>& boundingBox) :
+    _mesh(&mesh),
+    _boundingBox(&boundingBox),
     _vertexDataIndex(0)
 {
 }
@@ -89,7 +97,7 @@ void MeshWriter::writeAttributeData(VertexAttributeSemantic semantic, const Vect
     // If this data is a position then expand the bounding box to include it
     if (semantic == VertexAttributeSemantic::Position)
     {
-        _mesh->boundingBox().expandToInclude(value);
+        _boundingBox->expandToInclude(value);
     }
 
     const VertexAttribute* attribute = _mesh->vertexLayout().attributeWithSemantic(semantic);
@@ -169,7 +177,6 @@ void MeshWriter::writeAttributeData(VertexAttributeSemantic semantic, const Vect
 
 void MeshWriter::addIndex(uint64_t value)
 {
-    IndexType indexType = _mesh->indexType();
     size_t indexSize = _mesh->indexSize();
 
     // Push back zeroed data for the added index
@@ -179,11 +186,18 @@ void MeshWriter::addIndex(uint64_t value)
         _mesh->_indexData.push_back(0);
     }
 
+    _setIndexValue(indexDataIndex, value);
+
+    ++_mesh->_indexCount;
+}
+
+void MeshWriter::_setIndexValue(size_t indexDataIndex, uint64_t value)
+{
     // Get the location of the index
     void* index = &_mesh->_indexData[indexDataIndex];
 
     // Set the index data based on the type
-    switch (indexType)
+    switch (_mesh->indexType())
     {
     case IndexType::UnsignedByte:
         *(uint8_t*)index = (uint8_t)value;
@@ -195,8 +209,6 @@ void MeshWriter::addIndex(uint64_t value)
         *(uint32_t*)index = (uint32_t)value;
         break;
     }
-
-    ++_mesh->_indexCount;
 }
 
 void MeshWriter::_setComponentValue(const VertexAttribute* attribute, unsigned index, float value)
@@ -81,13 +81,43 @@ public:
     /// Adds an index to the mesh.
     void addIndex(uint64_t value);
 
+    ///
+    /// Adds vertices to the mesh, writing their attribute data in parallel.
+    ///
+    /// \remarks The vertex data is allocated once for all of the added
+    /// vertices.
+    ///
+    /// \param taskPool The task pool to write the vertices in.
+    /// \param vertexCount The number of vertices to add.
+    /// \param writeVertex The function writing the attribute data of a
+    /// vertex, taking a mesh writer positioned at the vertex and the index of
+    /// the vertex among the added vertices.
+    ///
+    /// \returns The index of the first added vertex.
+    template <typename Function>
+    size_t addVertices(TaskPool& taskPool, size_t vertexCount, Function writeVertex);
+
+    ///
+    /// Adds indices to the mesh, computing their values in parallel.
+    ///
+    /// \param taskPool The task pool to compute the indices in.
+    /// \param indexCount The number of indices to add.
+    /// \param indexValue The function returning the value of an index given
+    /// its index among the added indices.
+    template <typename Function>
+    void addIndices(TaskPool& taskPool, size_t indexCount, Function indexValue);
+
 private:
+    MeshWriter(Mesh& mesh, AxisAlignedBox<float>& boundingBox);
+
+    void _setIndexValue(size_t indexDataIndex, uint64_t value);
     void _setComponentValue(const VertexAttribute* attribute, unsigned index, float value);
 
     template <typename T>
     void _writeAttributeData(const VertexAttribute& attribute, const T& value);
 
     Mesh* _mesh;
+    AxisAlignedBox<float>* _boundingBox;
     size_t _vertexDataIndex;
 };
 
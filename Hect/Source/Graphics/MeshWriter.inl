@@ -24,6 +24,67 @@
 namespace hect
 {
 
+template <typename Function>
+size_t MeshWriter::addVertices(TaskPool& taskPool, size_t vertexCount, Function writeVertex)
+{
+    size_t firstVertex = _mesh->_vertexCount;
+    if (vertexCount == 0)
+    {
+        return firstVertex;
+    }
+
+    // Allocate zeroed data for all of the added vertices at once
+    size_t vertexSize = _mesh->vertexLayout().vertexSize();
+    size_t firstVertexDataIndex = _mesh->_vertexData.size();
+    _mesh->_vertexData.resize(firstVertexDataIndex + vertexCount * vertexSize, 0);
+    _mesh->_vertexCount += vertexCount;
+
+    // Each chunk of vertices is written by its own writer which expands its
+    // own bounding box
+    Mesh& mesh = *_mesh;
+    AxisAlignedBox<float> boundingBox = taskPool.parallelReduce(0, vertexCount, 256, AxisAlignedBox<float>(), [&](size_t begin, size_t end)
+    {
+        AxisAlignedBox<float> chunkBoundingBox;
+        MeshWriter writer(mesh, chunkBoundingBox);
+        for (size_t i = begin; i < end; ++i)
+        {
+            writer._vertexDataIndex = firstVertexDataIndex + i * vertexSize;
+            writeVertex(writer, i);
+        }
+        return chunkBoundingBox;
+    }, [](const AxisAlignedBox<float>& a, const AxisAlignedBox<float>& b)
+    {
+        AxisAlignedBox<float> boundingBox(a);
+        boundingBox.expandToInclude(b);
+        return boundingBox;
+    });
+
+    _boundingBox->expandToInclude(boundingBox);
+
+    // Further writes apply to the last added vertex
+    _vertexDataIndex = firstVertexDataIndex + (vertexCount - 1) * vertexSize;
+
+    return firstVertex;
+}
+
+template <typename Function>
+void MeshWriter::addIndices(TaskPool& taskPool, size_t indexCount, Function indexValue)
+{
+    // Allocate zeroed data for all of the added indices at once
+    size_t indexSize = _mesh->indexSize();
+    size_t firstIndexDataIndex = _mesh->_indexData.size();
+    _mesh->_indexData.resize(firstIndexDataIndex + indexCount * indexSize, 0);
+    _mesh->_indexCount += indexCount;
+
+    taskPool.parallelFor(0, indexCount, 1024, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            _setIndexValue(firstIndexDataIndex + i * indexSize, indexValue(i));
+        }
+    });
+}
+
 template <typename T>
 void MeshWriter::_writeAttributeData(const VertexAttribute& attribute, const T& value)
 {
@@ -34,6 +34,55 @@ Pass::Pass(const RenderMode& renderMode, const AssetHandle<Texture>::Array& text
     _resolvePassUniformValues();
 }
 
+Pass::Pass(const RenderMode& renderMode, AssetHandle<Texture>::Array&& textures, const AssetHandle<Shader>& shader, PassUniformValue::Array&& uniformValues) :
+    _renderMode(renderMode),
+    _textures(std::move(textures)),
+    _shader(shader),
+    _uniformValues(std::move(uniformValues))
+{
+    _resolvePassUniformValues();
+}
+
+Pass::Pass(const Pass& pass) :
+    _renderMode(pass._renderMode),
+    _textures(pass._textures),
+    _shader(pass._shader),
+    _uniformValues(pass._uniformValues),
+    _resolvedUniformValues(pass._resolvedUniformValues)
+{
+}
+
+Pass::Pass(Pass&& pass) :
+    _renderMode(pass._renderMode),
+    _textures(std::move(pass._textures)),
+    _shader(std::move(pass._shader)),
+    _uniformValues(std::move(pass._uniformValues)),
+    _resolvedUniformValues(std::move(pass._resolvedUniformValues))
+{
+}
+
+Pass& Pass::operator=(const Pass& pass)
+{
+    _renderMode = pass._renderMode;
+    _textures = pass._textures;
+    _shader = pass._shader;
+    _uniformValues = pass._uniformValues;
+    _resolvedUniformValues = pass._resolvedUniformValues;
+
+    return *this;
+}
+
+Pass& Pass::operator=(Pass&& pass)
+{
+    _renderMode = pass._renderMode;
+    _textures = std::move(pass._textures);
+    _shader = std::move(pass._shader);
+    _uniformValues = std::move(pass._uniformValues);
+    _resolvedUniformValues = std::move(pass._resolvedUniformValues);
+
+    return *this;
+}
+
 void Pass::prepare(Renderer& renderer) const
 {
     // Bind the render mode
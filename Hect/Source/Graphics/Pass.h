@@ -48,6 +48,43 @@ public:
     /// \param uniformValues The values for the uniforms in the shader.
     Pass(const RenderMode& renderMode, const AssetHandle<Texture>::Array& textures, const AssetHandle<Shader>& shader, const PassUniformValue::Array& uniformValues);
 
+    ///
+    /// Constructs a pass by moving the textures and uniform values into it.
+    ///
+    /// \param renderMode The render mode that pass will bind.
+    /// \param textures The textures that the pass will bind.
+    /// \param shader The shader that the pass will bind.
+    /// \param uniformValues The values for the uniforms in the shader.
+    Pass(const RenderMode& renderMode, AssetHandle<Texture>::Array&& textures, const AssetHandle<Shader>& shader, PassUniformValue::Array&& uniformValues);
+
+    ///
+    /// Constructs a pass as a copy of another.
+    ///
+    /// \param pass The pass to copy.
+    Pass(const Pass& pass);
+
+    ///
+    /// Constructs a pass moved from another.
+    ///
+    /// \param pass The pass to move.
+    Pass(Pass&& pass);
+
+    ///
+    /// Replaces the pass with a copy of another.
+    ///
+    /// \param pass The pass to copy.
+    ///
+    /// \returns A reference to the pass.
+    Pass& operator=(const Pass& pass);
+
+    ///
+    /// Replaces the pass with one moved from another.
+    ///
+    /// \param pass The pass to move.
+    ///
+    /// \returns A reference to the pass.
+    Pass& operator=(Pass&& pass);
+
     ///
     /// Prepares a renderer to begin using this pass.
     ///
@@ -28,9 +28,6 @@ using namespace hect;
 void AssetLoader<Shader>::load(Shader& shader, const Path& assetPath, AssetCache& assetCache)
 {
     DataValue dataValue;
-    {
-        FileReadStream stream = assetCache.fileSystem().openFileForRead(assetPath);
-        DataValueJsonFormat::load(dataValue, stream);
-    }
+    AssetLoader<DataValue>::load(dataValue, assetPath, assetCache);
     ShaderDataValueFormat::load(shader, assetPath.toString(), dataValue, assetCache);
 }
@@ -34,6 +34,33 @@ Technique::Technique(const Pass::Array& passes) :
 {
 }
 
+Technique::Technique(Pass::Array&& passes) :
+    _passes(std::move(passes))
+{
+}
+
+Technique::Technique(const Technique& technique) :
+    _passes(technique._passes)
+{
+}
+
+Technique::Technique(Technique&& technique) :
+    _passes(std::move(technique._passes))
+{
+}
+
+Technique& Technique::operator=(const Technique& technique)
+{
+    _passes = technique._passes;
+    return *this;
+}
+
+Technique& Technique::operator=(Technique&& technique)
+{
+    _passes = std::move(technique._passes);
+    return *this;
+}
+
 Pass::Array& Technique::passes()
 {
     return _passes;
@@ -48,6 +48,40 @@ public:
     /// \param passes The passes to include in the technique.
     Technique(const Pass::Array& passes);
 
+    ///
+    /// Constructs a technique by moving the passes into it.
+    ///
+    /// \param passes The passes to include in the technique.
+    Technique(Pass::Array&& passes);
+
+    ///
+    /// Constructs a technique as a copy of another.
+    ///
+    /// \param technique The technique to copy.
+    Technique(const Technique& technique);
+
+    ///
+    /// Constructs a technique moved from another.
+    ///
+    /// \param technique The technique to move.
+    Technique(Technique&& technique);
+
+    ///
+    /// Replaces the technique with a copy of another.
+    ///
+    /// \param technique The technique to copy.
+    ///
+    /// \returns A reference to the technique.
+    Technique& operator=(const Technique& technique);
+
+    ///
+    /// Replaces the technique with one moved from another.
+    ///
+    /// \param technique The technique to move.
+    ///
+    /// \returns A reference to the technique.
+    Technique& operator=(Technique&& technique);
+
     ///
     /// Returns the passes.
     Pass::Array& passes();
@@ -86,6 +86,19 @@ Texture::Texture(const Texture& texture) :
     }
 }
 
+Texture::Texture(Texture&& texture) :
+    _width(0),
+    _height(0),
+    _pixelType(PixelType::Byte),
+    _pixelFormat(PixelFormat::Rgba),
+    _minFilter(TextureFilter::Linear),
+    _magFilter(TextureFilter::Linear),
+    _mipmapped(true),
+    _wrapped(false)
+{
+    *this = std::move(texture);
+}
+
 Texture::~Texture()
 {
     if (isUploaded())
@@ -94,6 +107,59 @@ Texture::~Texture()
     }
 }
 
+Texture& Texture::operator=(const Texture& texture)
+{
+    if (isUploaded())
+    {
+        throw Error("Attempt to assign to a texture that is uploaded");
+    }
+
+    _name = texture._name;
+    _image = texture._image;
+    _width = texture.width();
+    _height = texture.height();
+    _pixelType = texture.pixelType();
+    _pixelFormat = texture.pixelFormat();
+    _minFilter = texture.minFilter();
+    _magFilter = texture.magFilter();
+    _mipmapped = texture.isMipmapped();
+    _wrapped = texture.isWrapped();
+
+    if (texture.isUploaded())
+    {
+        _image = Image::Ref(new Image(texture.renderer()->downloadTextureImage(texture)));
+    }
+
+    return *this;
+}
+
+Texture& Texture::operator=(Texture&& texture)
+{
+    if (isUploaded())
+    {
+        throw Error("Attempt to assign to a texture that is uploaded");
+    }
+
+    // The texture on the GPU cannot be moved with the source image
+    if (texture.isUploaded())
+    {
+        throw Error("Attempt to move a texture that is uploaded");
+    }
+
+    _name = std::move(texture._name);
+    _image = std::move(texture._image);
+    _width = texture.width();
+    _height = texture.height();
+    _pixelType = texture.pixelType();
+    _pixelFormat = texture.pixelFormat();
+    _minFilter = texture.minFilter();
+    _magFilter = texture.magFilter();
+    _mipmapped = texture.isMipmapped();
+    _wrapped = texture.isWrapped();
+
+    return *this;
+}
+
 const std::string& Texture::name() const
 {
     return _name;
@@ -84,10 +84,40 @@ public:
     /// \param texture The texture to copy.
     Texture(const Texture& texture);
 
+    ///
+    /// Constructs a texture moved from another texture.
+    ///
+    /// \remarks The source image is moved without being copied.
+    ///
+    /// \param texture The texture to move.
+    ///
+    /// \throws Error If the texture to move is uploaded.
+    Texture(Texture&& texture);
+
     ///
     /// Destroys the texture on the GPU if it is uploaded.
     ~Texture();
 
+    ///
+    /// Replaces the texture with a copy of another texture.
+    ///
+    /// \param texture The texture to copy.
+    ///
+    /// \returns A reference to the texture.
+    ///
+    /// \throws Error If the texture is uploaded.
+    Texture& operator=(const Texture& texture);
+
+    ///
+    /// Replaces the texture with one moved from another texture.
+    ///
+    /// \param texture The texture to move.
+    ///
+    /// \returns A reference to the texture.
+    ///
+    /// \throws Error If either texture is uploaded.
+    Texture& operator=(Texture&& texture);
+
     ///
     /// Returns the name.
     const std::string& name() const;
@@ -27,8 +27,7 @@ using namespace hect;
 
 void AssetLoader<Texture>::load(Texture& texture, const Path& assetPath, AssetCache& assetCache)
 {
-    FileReadStream stream = assetCache.fileSystem().openFileForRead(assetPath);
     DataValue dataValue;
-    DataValueJsonFormat::load(dataValue, stream);
+    AssetLoader<DataValue>::load(dataValue, assetPath, assetCache);
     TextureDataValueFormat::load(texture, assetPath.toString(), dataValue, assetCache);
 }
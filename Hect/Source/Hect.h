@@ -23,6 +23,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <bitset>
 #include <condition_variable>
@@ -32,11 +33,15 @@
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <set>
 #include <vector>
 #include <sstream>
 #include <stack>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <cstdint>
 
 #ifdef _MSC_VER
@@ -60,6 +65,7 @@ const double pi = 3.14159265358979323846;
 }
 
 #include "Core/Format.h"
+#include "Core/Hash.h"
 #include "Core/Logging.h"
 #include "Core/Error.h"
 #include "Core/Uncopyable.h"
@@ -67,7 +73,15 @@ const double pi = 3.14159265358979323846;
 #include "Core/Memory.h"
 #include "Core/TimeSpan.h"
 #include "Core/Timer.h"
+#include "Core/CpuTopology.h"
+#include "Core/WorkStealingQueue.h"
+#include "Core/SpscQueue.h"
+#include "Core/MpscQueue.h"
+#include "Core/Channel.h"
+#include "Core/TaskFunction.h"
 #include "Core/TaskPool.h"
+#include "Core/TaskGraph.h"
+#include "Core/ActionQueue.h"
 #include "Core/IdPool.h"
 #include "Core/Listener.h"
 #include "Core/Dispatcher.h"
@@ -84,22 +98,31 @@ const double pi = 3.14159265358979323846;
 #include "Math/Plane.h"
 #include "Math/Frustum.h"
 
+#include "Core/DataValuePath.h"
 #include "Core/DataValue.h"
 
 #include "IO/Path.h"
 #include "IO/ReadStream.h"
 #include "IO/WriteStream.h"
+#include "IO/PackFile.h"
+#include "IO/PackFileWriter.h"
 #include "IO/FileReadStream.h"
 #include "IO/FileWriteStream.h"
 #include "IO/MemoryReadStream.h"
 #include "IO/MemoryWriteStream.h"
 #include "IO/FileSystem.h"
+#include "Core/DataDocument.h"
+#include "Core/DataValueBinaryFormat.h"
+#include "IO/BinaryDataFormat.h"
 #include "IO/DataReader.h"
 #include "IO/DataWriter.h"
 #include "Asset/AssetLoader.h"
 #include "Asset/AssetEntry.h"
 #include "Asset/AssetHandle.h"
+#include "Asset/AssetManifest.h"
+#include "Asset/AssetLoadProfile.h"
 #include "Asset/AssetCache.h"
+#include "Asset/AssetCooker.h"
 
 #include "Core/DataValueJsonFormat.h"
 
@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+const uint16_t BinaryDataFormat::Signature = 0xFE04;
+const uint8_t BinaryDataFormat::Version = 1;
+
+void BinaryDataFormat::writeHeader(WriteStream& stream, BinaryDataProfile profile)
+{
+    stream.writeUnsignedShort(Signature);
+    stream.writeUnsignedByte(Version);
+    stream.writeUnsignedByte((uint8_t)profile);
+}
+
+BinaryDataProfile BinaryDataFormat::readHeader(ReadStream& stream)
+{
+    if (stream.readUnsignedShort() != Signature)
+    {
+        throw Error("The data does not begin with a binary data header");
+    }
+
+    uint8_t version = stream.readUnsignedByte();
+    if (version != Version)
+    {
+        throw Error(format("Unsupported binary data version %d", version));
+    }
+
+    uint8_t profile = stream.readUnsignedByte();
+    if (profile > (uint8_t)BinaryDataProfile::Compact)
+    {
+        throw Error(format("Unknown binary data profile %d", profile));
+    }
+
+    return (BinaryDataProfile)profile;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A profile of the binary data written by BinaryDataWriter and read by
+/// BinaryDataReader.
+enum class BinaryDataProfile
+{
+
+    ///
+    /// Numbers and vectors are written as doubles and lengths/counts as
+    /// 32-bit integers.
+    Standard,
+
+    ///
+    /// Numbers and vectors are written in the smallest encoding which
+    /// represents them at the requested precision and lengths/counts as
+    /// variable length integers.
+    Compact
+};
+
+///
+/// The precision a vector is written with.
+///
+/// \remarks Only affects writers which support the precision (e.g. a
+/// BinaryDataWriter using the compact profile).
+enum class VectorPrecision
+{
+
+    ///
+    /// The vector is written without loss of precision.
+    Full,
+
+    ///
+    /// The vector is written with the precision of a 32-bit float.
+    Single,
+
+    ///
+    /// The vector components are within [-1, 1] and are quantized to 16 bits
+    /// (e.g. directions and rotation axes).
+    Normalized
+};
+
+///
+/// Provides the functionality for identifying the profile and version of
+/// binary data.
+class BinaryDataFormat
+{
+public:
+
+    ///
+    /// The encoding of a number or vector in the compact profile, written as
+    /// a byte preceding the value.
+    enum class Encoding
+    {
+
+        ///
+        /// Each component is a double.
+        Double,
+
+        ///
+        /// Each component is a float.
+        Float,
+
+        ///
+        /// The value is an integer stored as a zig-zag variable length
+        /// integer.
+        Integer,
+
+        ///
+        /// Each component is zero and no further data is stored.
+        Zero,
+
+        ///
+        /// Each component is a 16-bit signed normalized integer.
+        Normalized
+    };
+
+    ///
+    /// The number identifying binary data with a header.
+    static const uint16_t Signature;
+
+    ///
+    /// The current version of the binary data format.
+    static const uint8_t Version;
+
+    ///
+    /// Writes a header identifying the profile and the current version.
+    ///
+    /// \param stream The stream to write to.
+    /// \param profile The profile of the data following the header.
+    static void writeHeader(WriteStream& stream, BinaryDataProfile profile);
+
+    ///
+    /// Reads a header and returns the profile it identifies.
+    ///
+    /// \param stream The stream to read from.
+    ///
+    /// \throws Error If the header is invalid or of an unsupported version.
+    static BinaryDataProfile readHeader(ReadStream& stream);
+};
+
+}
\ No newline at end of file
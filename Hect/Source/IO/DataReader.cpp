@@ -192,7 +192,176 @@ const DataValue& DataValueReader::_read(const char* name)
     return top[name];
 }
 
-BinaryDataReader::BinaryDataReader(ReadStream& stream) :
+DataDocumentReader::DataDocumentReader(const DataDocumentValue& value) :
+    _elementIndex(0)
+{
+    _valueStack.push(value);
+}
+
+void DataDocumentReader::beginObject()
+{
+    DataDocumentValue top = _valueStack.top();
+    if (!top.isArray())
+    {
+        throw Error("Cannot begin an unnamed object when the current value is an object");
+    }
+
+    _valueStack.push(_read());
+}
+
+bool DataDocumentReader::beginObject(const char* name)
+{
+    DataDocumentValue top = _valueStack.top();
+    if (!top.isObject())
+    {
+        throw Error("Cannot begin a named object when the current value is an array");
+    }
+
+    DataDocumentValue value = top.member(name);
+    if (!value.isNull())
+    {
+        _valueStack.push(value);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void DataDocumentReader::endObject()
+{
+    DataDocumentValue top = _valueStack.top();
+    if (!top.isObject())
+    {
+        throw Error("Current value is not an object");
+    }
+
+    _valueStack.pop();
+}
+
+bool DataDocumentReader::beginArray(const char* name)
+{
+    DataDocumentValue top = _valueStack.top();
+    if (!top.isObject())
+    {
+        throw Error("Cannot begin a named array when the current value is an array");
+    }
+
+    DataDocumentValue value = top.member(name);
+    if (!value.isNull())
+    {
+        _elementIndex = 0;
+        _valueStack.push(value);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool DataDocumentReader::endArray()
+{
+    DataDocumentValue top = _valueStack.top();
+    if (!top.isArray())
+    {
+        throw Error("Current value is not an array");
+    }
+
+    if (_elementIndex >= top.size())
+    {
+        _valueStack.pop();
+        return true;
+    }
+    return false;
+}
+
+bool DataDocumentReader::hasMember(const char* name)
+{
+    return !_valueStack.top().member(name).isNull();
+}
+
+double DataDocumentReader::readDouble()
+{
+    return _read().asDouble();
+}
+
+double DataDocumentReader::readDouble(const char* name)
+{
+    return _read(name).asDouble();
+}
+
+std::string DataDocumentReader::readString()
+{
+    return _read().asString();
+}
+
+std::string DataDocumentReader::readString(const char* name)
+{
+    return _read(name).asString();
+}
+
+Vector2<> DataDocumentReader::readVector2()
+{
+    return _read().asVector2();
+}
+
+Vector2<> DataDocumentReader::readVector2(const char* name)
+{
+    return _read(name).asVector2();
+}
+
+Vector3<> DataDocumentReader::readVector3()
+{
+    return _read().asVector3();
+}
+
+Vector3<> DataDocumentReader::readVector3(const char* name)
+{
+    return _read(name).asVector3();
+}
+
+Vector4<> DataDocumentReader::readVector4()
+{
+    return _read().asVector4();
+}
+
+Vector4<> DataDocumentReader::readVector4(const char* name)
+{
+    return _read(name).asVector4();
+}
+
+DataDocumentValue DataDocumentReader::_read()
+{
+    DataDocumentValue top = _valueStack.top();
+    if (!top.isArray())
+    {
+        throw Error("Current value is not an array");
+    }
+
+    if (_elementIndex >= top.size())
+    {
+        throw Error("Attempt to read past the end of an array");
+    }
+
+    return top[_elementIndex++];
+}
+
+DataDocumentValue DataDocumentReader::_read(const char* name)
+{
+    DataDocumentValue top = _valueStack.top();
+    if (!top.isObject())
+    {
+        throw Error("Current value is not an object");
+    }
+
+    return top.member(name);
+}
+
+BinaryDataReader::BinaryDataReader(ReadStream& stream, BinaryDataProfile profile) :
+    _profile(profile),
+    _elementPending(false),
     _elementIndex(0),
     _elementCount(0),
     _stream(&stream)
@@ -201,7 +370,7 @@ BinaryDataReader::BinaryDataReader(ReadStream& stream) :
 
 void BinaryDataReader::beginObject()
 {
-    ++_elementIndex;
+    _beginElement();
 }
 
 bool BinaryDataReader::beginObject(const char* name)
@@ -217,14 +386,34 @@ void BinaryDataReader::endObject()
 bool BinaryDataReader::beginArray(const char* name)
 {
     name;
-    _elementCount = _stream->readUnsignedInt();
-    _elementIndex = 0;
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        _elementCount = _stream->readUnsignedInt();
+        _elementIndex = 0;
+    }
+    else
+    {
+        _elementPending = false;
+    }
     return true;
 }
 
 bool BinaryDataReader::endArray()
 {
-    return _elementIndex >= _elementCount;
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        return _elementIndex >= _elementCount;
+    }
+    else
+    {
+        // Read whether another element follows
+        if (!_elementPending)
+        {
+            _elementPending = _stream->readUnsignedByte() != 0;
+            return !_elementPending;
+        }
+        return false;
+    }
 }
 
 bool BinaryDataReader::hasMember(const char* name)
@@ -235,60 +424,157 @@ bool BinaryDataReader::hasMember(const char* name)
 
 double BinaryDataReader::readDouble()
 {
-    ++_elementIndex;
-    return _stream->readDouble();
+    _beginElement();
+    return _readNumber();
 }
 
 double BinaryDataReader::readDouble(const char* name)
 {
     name;
-    return _stream->readDouble();
+    return _readNumber();
 }
 
 std::string BinaryDataReader::readString()
 {
-    ++_elementIndex;
-    return _stream->readString();
+    _beginElement();
+    return readString(nullptr);
 }
 
 std::string BinaryDataReader::readString(const char* name)
 {
     name;
-    return _stream->readString();
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        return _stream->readString();
+    }
+    else
+    {
+        size_t byteCount = (size_t)_stream->readVarUnsignedInt();
+        std::string string(byteCount, ' ');
+        if (byteCount > 0)
+        {
+            _stream->readBytes((uint8_t*)&string[0], byteCount);
+        }
+        return string;
+    }
 }
 
 Vector2<> BinaryDataReader::readVector2()
 {
-    ++_elementIndex;
-    return _stream->readVector2();
+    _beginElement();
+    return readVector2(nullptr);
 }
 
 Vector2<> BinaryDataReader::readVector2(const char* name)
 {
     name;
-    return _stream->readVector2();
+    double components[2];
+    _readComponents(components, 2);
+    return Vector2<>(components[0], components[1]);
 }
 
 Vector3<> BinaryDataReader::readVector3()
 {
-    ++_elementIndex;
-    return _stream->readVector3();
+    _beginElement();
+    return readVector3(nullptr);
 }
 
 Vector3<> BinaryDataReader::readVector3(const char* name)
 {
     name;
-    return _stream->readVector3();
+    double components[3];
+    _readComponents(components, 3);
+    return Vector3<>(components[0], components[1], components[2]);
 }
 
 Vector4<> BinaryDataReader::readVector4()
 {
-    ++_elementIndex;
-    return _stream->readVector4();
+    _beginElement();
+    return readVector4(nullptr);
 }
 
 Vector4<> BinaryDataReader::readVector4(const char* name)
 {
     name;
-    return _stream->readVector4();
+    double components[4];
+    _readComponents(components, 4);
+    return Vector4<>(components[0], components[1], components[2], components[3]);
+}
+
+void BinaryDataReader::_beginElement()
+{
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        ++_elementIndex;
+    }
+    else
+    {
+        // Consume the element marker if endArray() has not already
+        if (!_elementPending)
+        {
+            _stream->readUnsignedByte();
+        }
+        _elementPending = false;
+    }
+}
+
+double BinaryDataReader::_readNumber()
+{
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        return _stream->readDouble();
+    }
+
+    BinaryDataFormat::Encoding encoding = (BinaryDataFormat::Encoding)_stream->readUnsignedByte();
+    switch (encoding)
+    {
+    case BinaryDataFormat::Encoding::Double:
+        return _stream->readDouble();
+    case BinaryDataFormat::Encoding::Float:
+        return (double)_stream->readFloat();
+    case BinaryDataFormat::Encoding::Integer:
+    {
+        uint64_t zigZag = _stream->readVarUnsignedInt();
+        int64_t integer = (int64_t)(zigZag >> 1) ^ -(int64_t)(zigZag & 1);
+        return (double)integer;
+    }
+    case BinaryDataFormat::Encoding::Zero:
+        return 0.0;
+    default:
+        throw Error(format("Invalid number encoding %d", (int)encoding));
+    }
+}
+
+void BinaryDataReader::_readComponents(double* components, unsigned count)
+{
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        for (unsigned i = 0; i < count; ++i)
+        {
+            components[i] = _stream->readDouble();
+        }
+        return;
+    }
+
+    BinaryDataFormat::Encoding encoding = (BinaryDataFormat::Encoding)_stream->readUnsignedByte();
+    for (unsigned i = 0; i < count; ++i)
+    {
+        switch (encoding)
+        {
+        case BinaryDataFormat::Encoding::Double:
+            components[i] = _stream->readDouble();
+            break;
+        case BinaryDataFormat::Encoding::Float:
+            components[i] = (double)_stream->readFloat();
+            break;
+        case BinaryDataFormat::Encoding::Zero:
+            components[i] = 0.0;
+            break;
+        case BinaryDataFormat::Encoding::Normalized:
+            components[i] = std::max(-1.0, (double)_stream->readShort() / 32767.0);
+            break;
+        default:
+            throw Error(format("Invalid vector encoding %d", (int)encoding));
+        }
+    }
 }
\ No newline at end of file
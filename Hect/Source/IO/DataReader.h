@@ -211,6 +211,45 @@ private:
     std::stack<DataValue> _valueStack;
 };
 
+///
+/// An implementation of DataReader for reading directly from a value within a
+/// data document.
+class DataDocumentReader :
+    public DataReader
+{
+public:
+
+    ///
+    /// Constructs the data document reader given the value to read.
+    ///
+    /// \param value The value to read.
+    DataDocumentReader(const DataDocumentValue& value);
+
+    void beginObject();
+    bool beginObject(const char* name);
+    void endObject();
+    bool beginArray(const char* name);
+    bool endArray();
+    bool hasMember(const char* name);
+    double readDouble();
+    double readDouble(const char* name);
+    std::string readString();
+    std::string readString(const char* name);
+    Vector2<> readVector2();
+    Vector2<> readVector2(const char* name);
+    Vector3<> readVector3();
+    Vector3<> readVector3(const char* name);
+    Vector4<> readVector4();
+    Vector4<> readVector4(const char* name);
+
+private:
+    DataDocumentValue _read();
+    DataDocumentValue _read(const char* name);
+
+    size_t _elementIndex;
+    std::stack<DataDocumentValue> _valueStack;
+};
+
 ///
 /// An implementation of DataReader for reading from a binary stream.
 ///
@@ -225,7 +264,8 @@ public:
     /// Constructs a binary data reader given the stream to read from.
     ///
     /// \param stream The stream to read from.
-    BinaryDataReader(ReadStream& stream);
+    /// \param profile The profile the data was written in.
+    BinaryDataReader(ReadStream& stream, BinaryDataProfile profile = BinaryDataProfile::Standard);
 
     void beginObject();
     bool beginObject(const char* name);
@@ -245,6 +285,12 @@ public:
     Vector4<> readVector4(const char* name);
 
 private:
+    void _beginElement();
+    double _readNumber();
+    void _readComponents(double* components, unsigned count);
+
+    BinaryDataProfile _profile;
+    bool _elementPending;
     unsigned _elementIndex;
     unsigned _elementCount;
     ReadStream* _stream;
@@ -126,33 +126,39 @@ void DataValueWriter::writeString(const char* name, const std::string& value)
     _write(name, value);
 }
 
-void DataValueWriter::writeVector2(const Vector2<>& value)
+void DataValueWriter::writeVector2(const Vector2<>& value, VectorPrecision precision)
 {
+    precision;
     _write(value);
 }
 
-void DataValueWriter::writeVector2(const char* name, const Vector2<>& value)
+void DataValueWriter::writeVector2(const char* name, const Vector2<>& value, VectorPrecision precision)
 {
+    precision;
     _write(name, value);
 }
 
-void DataValueWriter::writeVector3(const Vector3<>& value)
+void DataValueWriter::writeVector3(const Vector3<>& value, VectorPrecision precision)
 {
+    precision;
     _write(value);
 }
 
-void DataValueWriter::writeVector3(const char* name, const Vector3<>& value)
+void DataValueWriter::writeVector3(const char* name, const Vector3<>& value, VectorPrecision precision)
 {
+    precision;
     _write(name, value);
 }
 
-void DataValueWriter::writeVector4(const Vector4<>& value)
+void DataValueWriter::writeVector4(const Vector4<>& value, VectorPrecision precision)
 {
+    precision;
     _write(value);
 }
 
-void DataValueWriter::writeVector4(const char* name, const Vector4<>& value)
+void DataValueWriter::writeVector4(const char* name, const Vector4<>& value, VectorPrecision precision)
 {
+    precision;
     _write(name, value);
 }
 
@@ -176,7 +182,8 @@ void DataValueWriter::_write(const char* name, const DataValue& value)
     top.addMember(name, value);
 }
 
-BinaryDataWriter::BinaryDataWriter(WriteStream& stream) :
+BinaryDataWriter::BinaryDataWriter(WriteStream& stream, BinaryDataProfile profile) :
+    _profile(profile),
     _elementCountPosition(0),
     _elementCount(0),
     _stream(&stream)
@@ -185,7 +192,7 @@ BinaryDataWriter::BinaryDataWriter(WriteStream& stream) :
 
 void BinaryDataWriter::beginObject()
 {
-    ++_elementCount;
+    _beginElement();
 }
 
 void BinaryDataWriter::beginObject(const char* name)
@@ -200,75 +207,197 @@ void BinaryDataWriter::endObject()
 void BinaryDataWriter::beginArray(const char* name)
 {
     name;
-    _elementCount = 0;
-    _elementCountPosition = _stream->position();
-    _stream->writeUnsignedInt(0);
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        _elementCount = 0;
+        _elementCountPosition = _stream->position();
+        _stream->writeUnsignedInt(0);
+    }
 }
 
 void BinaryDataWriter::endArray()
 {
-    size_t currentPosition = _stream->position();
-    _stream->seek(_elementCountPosition);
-    _stream->writeUnsignedInt(_elementCount);
-    _stream->seek(currentPosition);
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        size_t currentPosition = _stream->position();
+        _stream->seek(_elementCountPosition);
+        _stream->writeUnsignedInt(_elementCount);
+        _stream->seek(currentPosition);
+    }
+    else
+    {
+        // Mark the end of the elements
+        _stream->writeUnsignedByte(0);
+    }
 }
 
 void BinaryDataWriter::writeDouble(double value)
 {
-    ++_elementCount;
-    _stream->writeDouble(value);
+    _beginElement();
+    _writeNumber(value);
 }
 
 void BinaryDataWriter::writeDouble(const char* name, double value)
 {
     name;
-    _stream->writeDouble(value);
+    _writeNumber(value);
 }
 
 void BinaryDataWriter::writeString(const std::string& value)
 {
-    ++_elementCount;
-    _stream->writeString(value);
+    _beginElement();
+    writeString(nullptr, value);
 }
 
 void BinaryDataWriter::writeString(const char* name, const std::string& value)
 {
     name;
-    _stream->writeString(value);
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        _stream->writeString(value);
+    }
+    else
+    {
+        _stream->writeVarUnsignedInt(value.size());
+        _stream->writeString(value, false);
+    }
 }
 
-void BinaryDataWriter::writeVector2(const Vector2<>& value)
+void BinaryDataWriter::writeVector2(const Vector2<>& value, VectorPrecision precision)
 {
-    ++_elementCount;
-    _stream->writeVector2(value);
+    _beginElement();
+    writeVector2(nullptr, value, precision);
 }
 
-void BinaryDataWriter::writeVector2(const char* name, const Vector2<>& value)
+void BinaryDataWriter::writeVector2(const char* name, const Vector2<>& value, VectorPrecision precision)
 {
     name;
-    _stream->writeVector2(value);
+    double components[2] = { value.x, value.y };
+    _writeComponents(components, 2, precision);
 }
 
-void BinaryDataWriter::writeVector3(const Vector3<>& value)
+void BinaryDataWriter::writeVector3(const Vector3<>& value, VectorPrecision precision)
 {
-    ++_elementCount;
-    _stream->writeVector3(value);
+    _beginElement();
+    writeVector3(nullptr, value, precision);
 }
 
-void BinaryDataWriter::writeVector3(const char* name, const Vector3<>& value)
+void BinaryDataWriter::writeVector3(const char* name, const Vector3<>& value, VectorPrecision precision)
 {
     name;
-    _stream->writeVector3(value);
+    double components[3] = { value.x, value.y, value.z };
+    _writeComponents(components, 3, precision);
 }
 
-void BinaryDataWriter::writeVector4(const Vector4<>& value)
+void BinaryDataWriter::writeVector4(const Vector4<>& value, VectorPrecision precision)
 {
-    ++_elementCount;
-    _stream->writeVector4(value);
+    _beginElement();
+    writeVector4(nullptr, value, precision);
 }
 
-void BinaryDataWriter::writeVector4(const char* name, const Vector4<>& value)
+void BinaryDataWriter::writeVector4(const char* name, const Vector4<>& value, VectorPrecision precision)
 {
     name;
-    _stream->writeVector4(value);
+    double components[4] = { value.x, value.y, value.z, value.w };
+    _writeComponents(components, 4, precision);
+}
+
+void BinaryDataWriter::_beginElement()
+{
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        ++_elementCount;
+    }
+    else
+    {
+        // Mark that another element follows
+        _stream->writeUnsignedByte(1);
+    }
+}
+
+void BinaryDataWriter::_writeNumber(double value)
+{
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        _stream->writeDouble(value);
+        return;
+    }
+
+    bool negativeZero = value == 0.0 && 1.0 / value < 0.0;
+    if (!negativeZero && value == std::floor(value) && std::abs(value) < 2147483648.0)
+    {
+        // Zig-zag encode so small negative integers are small
+        int64_t integer = (int64_t)value;
+        uint64_t zigZag = ((uint64_t)integer << 1) ^ (uint64_t)(integer >> 63);
+
+        _stream->writeUnsignedByte((uint8_t)BinaryDataFormat::Encoding::Integer);
+        _stream->writeVarUnsignedInt(zigZag);
+    }
+    else if ((double)(float)value == value)
+    {
+        _stream->writeUnsignedByte((uint8_t)BinaryDataFormat::Encoding::Float);
+        _stream->writeFloat((float)value);
+    }
+    else
+    {
+        _stream->writeUnsignedByte((uint8_t)BinaryDataFormat::Encoding::Double);
+        _stream->writeDouble(value);
+    }
+}
+
+void BinaryDataWriter::_writeComponents(const double* components, unsigned count, VectorPrecision precision)
+{
+    if (_profile == BinaryDataProfile::Standard)
+    {
+        for (unsigned i = 0; i < count; ++i)
+        {
+            _stream->writeDouble(components[i]);
+        }
+        return;
+    }
+
+    // Choose the smallest encoding that satisfies the precision
+    bool zero = true;
+    bool exactFloat = true;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        zero = zero && components[i] == 0.0;
+        exactFloat = exactFloat && (double)(float)components[i] == components[i];
+    }
+
+    BinaryDataFormat::Encoding encoding = BinaryDataFormat::Encoding::Double;
+    if (zero)
+    {
+        encoding = BinaryDataFormat::Encoding::Zero;
+    }
+    else if (precision == VectorPrecision::Normalized)
+    {
+        encoding = BinaryDataFormat::Encoding::Normalized;
+    }
+    else if (precision == VectorPrecision::Single || exactFloat)
+    {
+        encoding = BinaryDataFormat::Encoding::Float;
+    }
+
+    _stream->writeUnsignedByte((uint8_t)encoding);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        switch (encoding)
+        {
+        case BinaryDataFormat::Encoding::Double:
+            _stream->writeDouble(components[i]);
+            break;
+        case BinaryDataFormat::Encoding::Float:
+            _stream->writeFloat((float)components[i]);
+            break;
+        case BinaryDataFormat::Encoding::Normalized:
+        {
+            double component = std::max(-1.0, std::min(1.0, components[i]));
+            _stream->writeShort((int16_t)std::floor(component * 32767.0 + 0.5));
+            break;
+        }
+        default:
+            break;
+        }
+    }
 }
\ No newline at end of file
@@ -105,52 +105,58 @@ public:
     /// Writes an unnamed 2-dimensional vector.
     ///
     /// \param value The value to write.
+    /// \param precision The precision to write the vector with.
     ///
     /// \throws Error If the current value is not an array.
-    virtual void writeVector2(const Vector2<>& value) = 0;
+    virtual void writeVector2(const Vector2<>& value, VectorPrecision precision = VectorPrecision::Full) = 0;
 
     ///
     /// Writes an unnamed 2-dimensional vector.
     ///
     /// \param name The member name of the value to write.
     /// \param value The value to write.
+    /// \param precision The precision to write the vector with.
     ///
     /// \throws Error If the current value is not an object.
-    virtual void writeVector2(const char* name, const Vector2<>& value) = 0;
+    virtual void writeVector2(const char* name, const Vector2<>& value, VectorPrecision precision = VectorPrecision::Full) = 0;
 
     ///
     /// Writes an unnamed 3-dimensional vector.
     ///
     /// \param value The value to write.
+    /// \param precision The precision to write the vector with.
     ///
     /// \throws Error If the current value is not an array.
-    virtual void writeVector3(const Vector3<>& value) = 0;
+    virtual void writeVector3(const Vector3<>& value, VectorPrecision precision = VectorPrecision::Full) = 0;
 
     ///
     /// Writes an unnamed 3-dimensional vector.
     ///
     /// \param name The member name of the value to write.
     /// \param value The value to write.
+    /// \param precision The precision to write the vector with.
     ///
     /// \throws Error If the current value is not an object.
-    virtual void writeVector3(const char* name, const Vector3<>& value) = 0;
+    virtual void writeVector3(const char* name, const Vector3<>& value, VectorPrecision precision = VectorPrecision::Full) = 0;
 
     ///
     /// Writes an unnamed 4-dimensional vector.
     ///
     /// \param value The value to write.
+    /// \param precision The precision to write the vector with.
     ///
     /// \throws Error If the current value is not an array.
-    virtual void writeVector4(const Vector4<>& value) = 0;
+    virtual void writeVector4(const Vector4<>& value, VectorPrecision precision = VectorPrecision::Full) = 0;
 
     ///
     /// Writes an unnamed 4-dimensional vector.
     ///
     /// \param name The member name of the value to write.
     /// \param value The value to write.
+    /// \param precision The precision to write the vector with.
     ///
     /// \throws Error If the current value is not an object.
-    virtual void writeVector4(const char* name, const Vector4<>& value) = 0;
+    virtual void writeVector4(const char* name, const Vector4<>& value, VectorPrecision precision = VectorPrecision::Full) = 0;
 };
 
 ///
@@ -177,12 +183,12 @@ public:
     void writeDouble(const char* name, double value);
     void writeString(const std::string& value);
     void writeString(const char* name, const std::string& value);
-    void writeVector2(const Vector2<>& value);
-    void writeVector2(const char* name, const Vector2<>& value);
-    void writeVector3(const Vector3<>& value);
-    void writeVector3(const char* name, const Vector3<>& value);
-    void writeVector4(const Vector4<>& value);
-    void writeVector4(const char* name, const Vector4<>& value);
+    void writeVector2(const Vector2<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector2(const char* name, const Vector2<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector3(const Vector3<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector3(const char* name, const Vector3<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector4(const Vector4<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector4(const char* name, const Vector4<>& value, VectorPrecision precision = VectorPrecision::Full);
 
 private:
     void _write(const DataValue& value);
@@ -205,8 +211,12 @@ public:
     ///
     /// Constructs a binary data writer given the stream to write to.
     ///
+    /// \remarks No header is written; use BinaryDataFormat::writeHeader() to
+    /// identify the profile when it is not otherwise known by the reader.
+    ///
     /// \param stream The stream to write to.
-    BinaryDataWriter(WriteStream& stream);
+    /// \param profile The profile to write the data in.
+    BinaryDataWriter(WriteStream& stream, BinaryDataProfile profile = BinaryDataProfile::Standard);
 
     void beginObject();
     void beginObject(const char* name);
@@ -217,14 +227,19 @@ public:
     void writeDouble(const char* name, double value);
     void writeString(const std::string& value);
     void writeString(const char* name, const std::string& value);
-    void writeVector2(const Vector2<>& value);
-    void writeVector2(const char* name, const Vector2<>& value);
-    void writeVector3(const Vector3<>& value);
-    void writeVector3(const char* name, const Vector3<>& value);
-    void writeVector4(const Vector4<>& value);
-    void writeVector4(const char* name, const Vector4<>& value);
+    void writeVector2(const Vector2<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector2(const char* name, const Vector2<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector3(const Vector3<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector3(const char* name, const Vector3<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector4(const Vector4<>& value, VectorPrecision precision = VectorPrecision::Full);
+    void writeVector4(const char* name, const Vector4<>& value, VectorPrecision precision = VectorPrecision::Full);
 
 private:
+    void _beginElement();
+    void _writeNumber(double value);
+    void _writeComponents(const double* components, unsigned count, VectorPrecision precision);
+
+    BinaryDataProfile _profile;
     size_t _elementCountPosition;
     unsigned _elementCount;
     WriteStream* _stream;
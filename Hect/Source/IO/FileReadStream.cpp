@@ -29,6 +29,11 @@ using namespace hect;
 
 FileReadStream::~FileReadStream()
 {
+    if (_fileSystem)
+    {
+        _fileSystem->_addReadStatistics(_bytesRead, _readTime);
+    }
+
     if (_handle)
     {
         if (!PHYSFS_close((PHYSFS_File*)_handle))
@@ -40,38 +45,49 @@ FileReadStream::~FileReadStream()
 
 void FileReadStream::readBytes(uint8_t* bytes, size_t byteCount)
 {
-    assert(bytes);
-
-    size_t length = this->length();
-    size_t position = this->position();
-
-    if (position + byteCount >= length + 1)
+    // The contents of a file in a pack are measured when it is opened
+    if (_fileSystem && !_packFile)
     {
-        throw Error("Attempt to read past end of file");
+        Timer timer;
+        _readBytes(bytes, byteCount);
+        _readTime += timer.elapsed();
+        _bytesRead += byteCount;
     }
-
-    auto file = (PHYSFS_File*)_handle;
-    PHYSFS_sint64 result = PHYSFS_read(file, bytes, 1, (PHYSFS_uint32)byteCount);
-    if (result != (PHYSFS_sint64)byteCount)
+    else
     {
-        throw Error(format("Failed to read from file: %s", PHYSFS_getLastError()));
+        _readBytes(bytes, byteCount);
     }
 }
 
 bool FileReadStream::endOfStream() const
 {
+    if (_packFile)
+    {
+        return _position >= _length;
+    }
+
     auto file = (PHYSFS_File*)_handle;
     return PHYSFS_eof(file) != 0;
 }
 
 size_t FileReadStream::length() const
 {
+    if (_packFile)
+    {
+        return _length;
+    }
+
     auto file = (PHYSFS_File*)_handle;
     return (size_t)PHYSFS_fileLength(file);
 }
 
 size_t FileReadStream::position() const
 {
+    if (_packFile)
+    {
+        return _position;
+    }
+
     auto file = (PHYSFS_File*)_handle;
     return (size_t)PHYSFS_tell(file);
 }
@@ -85,6 +101,12 @@ void FileReadStream::seek(size_t position)
         throw Error("Attempt to seek past end of file");
     }
 
+    if (_packFile)
+    {
+        _position = position;
+        return;
+    }
+
     auto file = (PHYSFS_File*)_handle;
     if (!PHYSFS_seek(file, position))
     {
@@ -92,16 +114,71 @@ void FileReadStream::seek(size_t position)
     }
 }
 
-FileReadStream::FileReadStream(const Path& path) :
+const uint8_t* FileReadStream::contents() const
+{
+    return _packFile ? _contents : nullptr;
+}
+
+FileReadStream::FileReadStream(const Path& path, const FileSystem* fileSystem) :
     _path(path),
-    _handle(nullptr)
+    _handle(nullptr),
+    _fileSystem(fileSystem),
+    _bytesRead(0),
+    _contents(nullptr),
+    _length(0),
+    _position(0)
 {
     std::stringstream ss;
     ss << path;
 
+    Timer timer;
     _handle = PHYSFS_openRead(ss.str().c_str());
     if (!_handle)
     {
         throw Error(format("Failed to open file for reading: %s", PHYSFS_getLastError()));
     }
+    _readTime = timer.elapsed();
+}
+
+FileReadStream::FileReadStream(const Path& path, const std::shared_ptr<PackFile>& packFile, const FileSystem* fileSystem) :
+    _path(path),
+    _handle(nullptr),
+    _fileSystem(fileSystem),
+    _bytesRead(0),
+    _packFile(packFile),
+    _contents(nullptr),
+    _length(0),
+    _position(0)
+{
+    Timer timer;
+    _contents = packFile->fileContents(path, _buffer, _length);
+    _readTime = timer.elapsed();
+    _bytesRead = _length;
+}
+
+void FileReadStream::_readBytes(uint8_t* bytes, size_t byteCount)
+{
+    assert(bytes);
+
+    size_t length = this->length();
+    size_t position = this->position();
+
+    if (position + byteCount >= length + 1)
+    {
+        throw Error("Attempt to read past end of file");
+    }
+
+    if (_packFile)
+    {
+        std::memcpy(bytes, _contents + _position, byteCount);
+        _position += byteCount;
+        return;
+    }
+
+    auto file = (PHYSFS_File*)_handle;
+    PHYSFS_sint64 result = PHYSFS_read(file, bytes, 1, (PHYSFS_uint32)byteCount);
+    if (result != (PHYSFS_sint64)byteCount)
+    {
+        throw Error(format("Failed to read from file: %s", PHYSFS_getLastError()));
+    }
 }
\ No newline at end of file
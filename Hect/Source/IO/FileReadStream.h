@@ -26,6 +26,8 @@
 namespace hect
 {
 
+class FileSystem;
+
 ///
 /// Provides read access to a file.
 class FileReadStream :
@@ -59,11 +61,35 @@ public:
     /// \copydoc ReadStream::seek()
     void seek(size_t position);
 
+    ///
+    /// Returns a pointer to the entire contents of the file if the file is
+    /// read from a pack (null otherwise).
+    ///
+    /// \remarks Allows the contents of a file in a pack to be used without
+    /// copying them.  The contents are valid for as long as the stream is.
+    const uint8_t* contents() const;
+
 private:
-    FileReadStream(const Path& path);
+    FileReadStream(const Path& path, const FileSystem* fileSystem);
+    FileReadStream(const Path& path, const std::shared_ptr<PackFile>& packFile, const FileSystem* fileSystem);
+
+    void _readBytes(uint8_t* bytes, size_t byteCount);
 
     Path _path;
     void* _handle;
+
+    // The file system to account the bytes read and the time spent reading
+    // to (null if reads are not measured)
+    const FileSystem* _fileSystem;
+    size_t _bytesRead;
+    TimeSpan _readTime;
+
+    // The pack the file is read from (null if the file is not in a pack)
+    std::shared_ptr<PackFile> _packFile;
+    std::vector<uint8_t> _buffer;
+    const uint8_t* _contents;
+    size_t _length;
+    size_t _position;
 };
 
 }
\ No newline at end of file
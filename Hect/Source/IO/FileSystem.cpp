@@ -36,7 +36,13 @@ FileSystem* _fileSystem = nullptr;
 
 using namespace hect;
 
-FileSystem::FileSystem()
+FileSystem::ReadStatistics::ReadStatistics() :
+    bytesRead(0)
+{
+}
+
+FileSystem::FileSystem() :
+    _readTimingEnabled(false)
 {
     // Prevent multiple instances
     if (_fileSystem)
@@ -85,6 +91,12 @@ void FileSystem::setWriteDirectory(const Path& path)
 
 void FileSystem::addDataSource(const Path& path)
 {
+    if (path.extension() == "pack")
+    {
+        _packFiles.push_back(std::make_shared<PackFile>(path));
+        return;
+    }
+
     if (!PHYSFS_mount(path.toString().c_str(), NULL, 0))
     {
         throw Error(format("Failed to add data source: %s", PHYSFS_getLastError()));
@@ -93,7 +105,13 @@ void FileSystem::addDataSource(const Path& path)
 
 FileReadStream FileSystem::openFileForRead(const Path& path) const
 {
-    return FileReadStream(path);
+    std::shared_ptr<PackFile> packFile = _findPackFile(path);
+    if (packFile)
+    {
+        return FileReadStream(path, packFile, _readTimingEnabled ? this : nullptr);
+    }
+
+    return FileReadStream(path, _readTimingEnabled ? this : nullptr);
 }
 
 FileWriteStream FileSystem::openFileForWrite(const Path& path)
@@ -119,7 +137,54 @@ void FileSystem::remove(const Path& path)
 
 bool FileSystem::exists(const Path& path) const
 {
-    return PHYSFS_exists(path.toString().c_str()) != 0;
+    return _findPackFile(path) || PHYSFS_exists(path.toString().c_str()) != 0;
+}
+
+bool FileSystem::isDirectory(const Path& path) const
+{
+    return PHYSFS_isDirectory(path.toString().c_str()) != 0;
+}
+
+std::vector<Path> FileSystem::directoryContents(const Path& path) const
+{
+    std::vector<Path> contents;
+
+    char** names = PHYSFS_enumerateFiles(path.toString().c_str());
+    if (!names)
+    {
+        throw Error(format("Failed to list directory: %s", PHYSFS_getLastError()));
+    }
+
+    for (char** name = names; *name; ++name)
+    {
+        contents.push_back(path + *name);
+    }
+    PHYSFS_freeList(names);
+
+    return contents;
+}
+
+int64_t FileSystem::lastModifiedTime(const Path& path) const
+{
+    if (_findPackFile(path))
+    {
+        return 0;
+    }
+
+    return PHYSFS_getLastModTime(path.toString().c_str());
+}
+
+void FileSystem::setReadTimingEnabled(bool enabled)
+{
+    _readTimingEnabled = enabled;
+}
+
+FileSystem::ReadStatistics FileSystem::threadReadStatistics() const
+{
+    std::unique_lock<std::mutex> lock(_readStatisticsMutex);
+
+    auto it = _readStatistics.find(std::this_thread::get_id());
+    return it != _readStatistics.end() ? it->second : ReadStatistics();
 }
 
 Path FileSystem::_convertPath(const char* rawPath) const
@@ -135,4 +200,26 @@ Path FileSystem::_convertPath(const char* rawPath) const
     }
 
     return Path(string);
+}
+
+std::shared_ptr<PackFile> FileSystem::_findPackFile(const Path& path) const
+{
+    // The most recently added pack takes precedence
+    for (auto it = _packFiles.rbegin(); it != _packFiles.rend(); ++it)
+    {
+        if ((*it)->contains(path))
+        {
+            return *it;
+        }
+    }
+    return std::shared_ptr<PackFile>();
+}
+
+void FileSystem::_addReadStatistics(size_t bytesRead, TimeSpan readTime) const
+{
+    std::unique_lock<std::mutex> lock(_readStatisticsMutex);
+
+    ReadStatistics& statistics = _readStatistics[std::this_thread::get_id()];
+    statistics.bytesRead += bytesRead;
+    statistics.readTime += readTime;
 }
\ No newline at end of file
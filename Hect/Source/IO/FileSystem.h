@@ -33,8 +33,21 @@ namespace hect
 class FileSystem :
     public Uncopyable
 {
+    friend class FileReadStream;
 public:
 
+    /// The measurements of the files read on a thread.
+    struct ReadStatistics
+    {
+        ReadStatistics();
+
+        /// The number of bytes read.
+        size_t bytesRead;
+
+        /// The time spent opening and reading files.
+        TimeSpan readTime;
+    };
+
     ///
     /// Constructs the file system.
     ///
@@ -62,11 +75,15 @@ public:
     ///
     /// Adds a data source to be accessible for reading.
     ///
-    /// \remarks A data source can be a directory or an archive.  Any file
-    /// with the same path as a file in a previously added data source will
-    /// be overriden by the file in the most recently added data source.
+    /// \remarks A data source can be a directory, an archive, or a pack
+    /// (a file with the "pack" extension; see PackFile).  Any file with the
+    /// same path as a file in a previously added data source will be
+    /// overriden by the file in the most recently added data source.  Files
+    /// in packs override files in directories and archives regardless of
+    /// the order they were added in.
     ///
-    /// \param path Path to the directory or archive to add for reading.
+    /// \param path Path to the directory, archive, or pack to add for
+    /// reading.
     void addDataSource(const Path& path);
 
     ///
@@ -119,8 +136,46 @@ public:
     /// \param path The path to check the existence of.
     bool exists(const Path& path) const;
 
+    ///
+    /// Returns whether there is a directory at the given path.
+    ///
+    /// \param path The path to check.
+    bool isDirectory(const Path& path) const;
+
+    ///
+    /// Returns the paths of the files and directories in a directory.
+    ///
+    /// \remarks Files in packs are not included.
+    ///
+    /// \param path The path to the directory.
+    std::vector<Path> directoryContents(const Path& path) const;
+
+    /// Returns the time the file at the given path was last modified.
+    /// \remarks Files in packs are never modified while the pack is added.
+    /// \param path The path to the file.
+    /// \returns The modification time in seconds since the epoch (zero for
+    /// a file in a pack and -1 if the file does not exist).
+    int64_t lastModifiedTime(const Path& path) const;
+
+    /// Sets whether the files read are measured.
+    /// \remarks Only the files opened while enabled are measured.  A file
+    /// is accounted for once it is closed.
+    /// \param enabled Whether the files read are measured.
+    void setReadTimingEnabled(bool enabled);
+
+    /// Returns the measurements of the files read on the calling thread.
+    ReadStatistics threadReadStatistics() const;
+
 private:
     Path _convertPath(const char* rawPath) const;
+    std::shared_ptr<PackFile> _findPackFile(const Path& path) const;
+    void _addReadStatistics(size_t bytesRead, TimeSpan readTime) const;
+
+    std::vector<std::shared_ptr<PackFile>> _packFiles;
+
+    std::atomic<bool> _readTimingEnabled;
+    mutable std::mutex _readStatisticsMutex;
+    mutable std::map<std::thread::id, ReadStatistics> _readStatistics;
 };
 
 }
\ No newline at end of file
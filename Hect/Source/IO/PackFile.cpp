@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+#include <cstring>
+#include <zlib123/zlib.h>
+
+#ifdef HECT_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace hect;
+
+const char PackFile::_magic[8] = { 'H', 'E', 'C', 'T', 'P', 'A', 'C', 'K' };
+
+template <typename T>
+T PackFile::_read(size_t offset) const
+{
+    T value;
+    std::memcpy(&value, _data + offset, sizeof(T));
+    return value;
+}
+
+PackFile::PackFile(const Path& path) :
+    _path(path),
+    _fileHandle(nullptr),
+    _mappingHandle(nullptr),
+    _data(nullptr),
+    _size(0),
+    _fileCount(0),
+    _tableOffset(0),
+    _pathsOffset(0)
+{
+    const std::string& nativePath = path.toString();
+
+#ifdef HECT_WINDOWS
+    HANDLE file = CreateFile(nativePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw Error(format("Failed to open pack '%s'", nativePath.c_str()));
+    }
+    _fileHandle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)_headerSize)
+    {
+        _unmap();
+        throw Error(format("Pack '%s' is not a valid pack", nativePath.c_str()));
+    }
+
+    if ((uint64_t)size.QuadPart > SIZE_MAX)
+    {
+        _unmap();
+        throw Error(format("Pack '%s' is too large to map", nativePath.c_str()));
+    }
+    _size = (size_t)size.QuadPart;
+
+    HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        _unmap();
+        throw Error(format("Failed to map pack '%s'", nativePath.c_str()));
+    }
+    _mappingHandle = mapping;
+
+    _data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!_data)
+    {
+        _unmap();
+        throw Error(format("Failed to map pack '%s'", nativePath.c_str()));
+    }
+#else
+    int file = open(nativePath.c_str(), O_RDONLY);
+    if (file == -1)
+    {
+        throw Error(format("Failed to open pack '%s'", nativePath.c_str()));
+    }
+
+    struct stat status;
+    if (fstat(file, &status) == -1 || status.st_size < (off_t)_headerSize)
+    {
+        close(file);
+        throw Error(format("Pack '%s' is not a valid pack", nativePath.c_str()));
+    }
+
+    if ((uint64_t)status.st_size > SIZE_MAX)
+    {
+        close(file);
+        throw Error(format("Pack '%s' is too large to map", nativePath.c_str()));
+    }
+    _size = (size_t)status.st_size;
+
+    // The mapping remains valid after the file is closed
+    void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        throw Error(format("Failed to map pack '%s'", nativePath.c_str()));
+    }
+    _data = (const uint8_t*)data;
+#endif
+
+    // Verify the header
+    if (std::memcmp(_data, _magic, sizeof(_magic)) != 0 || _read<uint32_t>(8) != _version)
+    {
+        _unmap();
+        throw Error(format("Pack '%s' is not a valid pack", nativePath.c_str()));
+    }
+
+    // Compare by subtraction so corrupt values cannot overflow past the
+    // checks (an offset within the size also fits in a size_t)
+    uint64_t tableOffset = _read<uint64_t>(16);
+    uint64_t pathsOffset = _read<uint64_t>(24);
+    _fileCount = _read<uint32_t>(12);
+    if (tableOffset > _size || pathsOffset > _size || _fileCount > (_size - (size_t)tableOffset) / _entrySize)
+    {
+        _unmap();
+        throw Error(format("Pack '%s' is truncated", nativePath.c_str()));
+    }
+    _tableOffset = (size_t)tableOffset;
+    _pathsOffset = (size_t)pathsOffset;
+}
+
+PackFile::~PackFile()
+{
+    _unmap();
+}
+
+size_t PackFile::fileCount() const
+{
+    return _fileCount;
+}
+
+bool PackFile::contains(const Path& path) const
+{
+    Entry entry;
+    return _findEntry(path, entry);
+}
+
+const uint8_t* PackFile::fileContents(const Path& path, std::vector<uint8_t>& buffer, size_t& size) const
+{
+    Entry entry;
+    if (!_findEntry(path, entry))
+    {
+        throw Error(format("Pack '%s' does not contain '%s'", _path.toString().c_str(), path.toString().c_str()));
+    }
+
+    if (entry.offset > _size || entry.storedSize > _size - entry.offset)
+    {
+        throw Error(format("Pack '%s' is truncated", _path.toString().c_str()));
+    }
+
+    const uint8_t* storedData = _data + (size_t)entry.offset;
+
+    if (!(entry.flags & _compressedFlag))
+    {
+        // The contents are read in place so must be the size stored
+        if (entry.size != entry.storedSize)
+        {
+            throw Error(format("Pack '%s' is corrupt", _path.toString().c_str()));
+        }
+
+        size = (size_t)entry.size;
+        return storedData;
+    }
+
+    if (entry.size > SIZE_MAX)
+    {
+        throw Error(format("File '%s' in pack '%s' is too large to decompress", path.toString().c_str(), _path.toString().c_str()));
+    }
+    size = (size_t)entry.size;
+
+    buffer.resize(size);
+    uLongf decompressedSize = (uLongf)size;
+    if (size > 0)
+    {
+        if (uncompress(&buffer[0], &decompressedSize, storedData, (uLong)entry.storedSize) != Z_OK || decompressedSize != size)
+        {
+            throw Error(format("Failed to decompress '%s' in pack '%s'", path.toString().c_str(), _path.toString().c_str()));
+        }
+    }
+
+    return buffer.empty() ? nullptr : &buffer[0];
+}
+
+uint64_t PackFile::hashPath(const Path& path)
+{
+    return path.hash();
+}
+
+bool PackFile::_findEntry(const Path& path, Entry& entry) const
+{
+    uint64_t hash = hashPath(path);
+
+    // Find the first entry with the hash
+    size_t begin = 0;
+    size_t end = _fileCount;
+    while (begin < end)
+    {
+        size_t middle = begin + (end - begin) / 2;
+        if (_read<uint64_t>(_tableOffset + middle * _entrySize) < hash)
+        {
+            begin = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+
+    // Compare the paths of the entries with the hash
+    const std::string& rawPath = path.toString();
+    for (size_t index = begin; index < _fileCount; ++index)
+    {
+        entry = _readEntry(index);
+        if (entry.hash != hash)
+        {
+            break;
+        }
+
+        if (entry.pathLength == rawPath.size() && entry.pathOffset <= _size - _pathsOffset && entry.pathLength <= _size - _pathsOffset - entry.pathOffset &&
+            std::memcmp(_data + _pathsOffset + entry.pathOffset, rawPath.data(), rawPath.size()) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+PackFile::Entry PackFile::_readEntry(size_t index) const
+{
+    size_t offset = _tableOffset + index * _entrySize;
+
+    Entry entry;
+    entry.hash = _read<uint64_t>(offset);
+    entry.offset = _read<uint64_t>(offset + 8);
+    entry.storedSize = _read<uint64_t>(offset + 16);
+    entry.size = _read<uint64_t>(offset + 24);
+    entry.pathOffset = _read<uint32_t>(offset + 32);
+    entry.pathLength = _read<uint32_t>(offset + 36);
+    entry.flags = _read<uint32_t>(offset + 40);
+    return entry;
+}
+
+void PackFile::_unmap()
+{
+#ifdef HECT_WINDOWS
+    if (_data)
+    {
+        UnmapViewOfFile(_data);
+    }
+
+    if (_mappingHandle)
+    {
+        CloseHandle((HANDLE)_mappingHandle);
+    }
+
+    if (_fileHandle)
+    {
+        CloseHandle((HANDLE)_fileHandle);
+    }
+#else
+    if (_data)
+    {
+        munmap((void*)_data, _size);
+    }
+#endif
+
+    _data = nullptr;
+    _mappingHandle = nullptr;
+    _fileHandle = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// A read-only pack of files mapped into memory.
+///
+/// \remarks A pack begins with a header followed by the contents of each
+/// file aligned to 64 bytes, then a table of contents sorted by the hash of
+/// each file's path, then the paths themselves.  The contents of a file may
+/// be compressed.  Packs are written using PackFileWriter.
+class PackFile :
+    public Uncopyable
+{
+    friend class PackFileWriter;
+public:
+
+    ///
+    /// Maps a pack into memory.
+    ///
+    /// \param path The native path to the pack.
+    ///
+    /// \throws Error If the pack cannot be opened or is not a valid pack.
+    PackFile(const Path& path);
+
+    ///
+    /// Unmaps the pack.
+    ~PackFile();
+
+    ///
+    /// Returns the number of files in the pack.
+    size_t fileCount() const;
+
+    ///
+    /// Returns whether the pack contains a file.
+    ///
+    /// \param path The path to the file.
+    bool contains(const Path& path) const;
+
+    ///
+    /// Returns the contents of a file in the pack.
+    ///
+    /// \remarks The contents of an uncompressed file are read directly from
+    /// the mapped pack and are valid for as long as the pack is.  The
+    /// contents of a compressed file are decompressed to the given buffer.
+    ///
+    /// \param path The path to the file.
+    /// \param buffer The buffer to decompress to.
+    /// \param size Set to the size of the contents in bytes.
+    ///
+    /// \returns A pointer to the contents.
+    ///
+    /// \throws Error If the file is not in the pack, its entry is corrupt, or
+    /// it fails to decompress.
+    const uint8_t* fileContents(const Path& path, std::vector<uint8_t>& buffer, size_t& size) const;
+
+    ///
+    /// Returns the hash of a path as stored in the table of contents.
+    ///
+    /// \param path The path.
+    static uint64_t hashPath(const Path& path);
+
+private:
+    static const char _magic[8];
+    static const uint32_t _version = 1;
+    static const size_t _alignment = 64;
+    static const size_t _headerSize = 64;
+    static const size_t _entrySize = 48;
+
+    static const uint32_t _compressedFlag = 1;
+
+    struct Entry
+    {
+        uint64_t hash;
+        uint64_t offset;
+        uint64_t storedSize;
+        uint64_t size;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        uint32_t flags;
+    };
+
+    bool _findEntry(const Path& path, Entry& entry) const;
+    Entry _readEntry(size_t index) const;
+
+    template <typename T>
+    T _read(size_t offset) const;
+
+    void _unmap();
+
+    Path _path;
+
+    void* _fileHandle;
+    void* _mappingHandle;
+    const uint8_t* _data;
+    size_t _size;
+
+    size_t _fileCount;
+    size_t _tableOffset;
+    size_t _pathsOffset;
+};
+
+}
\ No newline at end of file
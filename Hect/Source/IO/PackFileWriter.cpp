@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+#include <zlib123/zlib.h>
+
+using namespace hect;
+
+void PackFileWriter::addFile(const Path& path, const std::vector<uint8_t>& data, bool compress)
+{
+    if (_paths.find(path) != _paths.end())
+    {
+        throw Error(format("Pack already contains '%s'", path.toString().c_str()));
+    }
+    _paths.insert(path);
+
+    File file;
+    file.path = path;
+    file.hash = PackFile::hashPath(path);
+    file.size = data.size();
+    file.compressed = false;
+
+    if (compress && !data.empty())
+    {
+        uLongf compressedSize = compressBound((uLong)data.size());
+        file.storedData.resize(compressedSize);
+        if (compress2(&file.storedData[0], &compressedSize, &data[0], (uLong)data.size(), Z_BEST_COMPRESSION) != Z_OK)
+        {
+            throw Error(format("Failed to compress '%s'", path.toString().c_str()));
+        }
+
+        // Only keep the compressed contents if they are smaller
+        if (compressedSize < data.size())
+        {
+            file.storedData.resize(compressedSize);
+            file.compressed = true;
+        }
+    }
+
+    if (!file.compressed)
+    {
+        file.storedData = data;
+    }
+
+    _files.push_back(std::move(file));
+}
+
+size_t PackFileWriter::fileCount() const
+{
+    return _files.size();
+}
+
+void PackFileWriter::save(WriteStream& stream) const
+{
+    const size_t alignment = PackFile::_alignment;
+
+    // Sort the files by the hash of their path for the table of contents
+    std::vector<const File*> files;
+    for (const File& file : _files)
+    {
+        files.push_back(&file);
+    }
+    std::sort(files.begin(), files.end(), [](const File* a, const File* b)
+    {
+        return a->hash < b->hash || (a->hash == b->hash && a->path < b->path);
+    });
+
+    // Lay out the contents of each file aligned after the header
+    std::vector<size_t> offsets;
+    size_t offset = PackFile::_headerSize;
+    for (const File* file : files)
+    {
+        offset = (offset + alignment - 1) / alignment * alignment;
+        offsets.push_back(offset);
+        offset += file->storedData.size();
+    }
+    size_t tableOffset = (offset + alignment - 1) / alignment * alignment;
+    size_t pathsOffset = tableOffset + files.size() * PackFile::_entrySize;
+
+    // Header
+    stream.writeBytes((const uint8_t*)PackFile::_magic, sizeof(PackFile::_magic));
+    stream.writeUnsignedInt(PackFile::_version);
+    stream.writeUnsignedInt((uint32_t)files.size());
+    stream.writeUnsignedLong(tableOffset);
+    stream.writeUnsignedLong(pathsOffset);
+    _writePadding(stream, PackFile::_headerSize - 32);
+
+    // Contents
+    size_t position = PackFile::_headerSize;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        _writePadding(stream, offsets[i] - position);
+        if (!files[i]->storedData.empty())
+        {
+            stream.writeBytes(&files[i]->storedData[0], files[i]->storedData.size());
+        }
+        position = offsets[i] + files[i]->storedData.size();
+    }
+    _writePadding(stream, tableOffset - position);
+
+    // Table of contents
+    uint32_t pathOffset = 0;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        const File& file = *files[i];
+        uint32_t pathLength = (uint32_t)file.path.toString().size();
+
+        stream.writeUnsignedLong(file.hash);
+        stream.writeUnsignedLong(offsets[i]);
+        stream.writeUnsignedLong(file.storedData.size());
+        stream.writeUnsignedLong(file.size);
+        stream.writeUnsignedInt(pathOffset);
+        stream.writeUnsignedInt(pathLength);
+        stream.writeUnsignedInt(file.compressed ? PackFile::_compressedFlag : 0);
+        stream.writeUnsignedInt(0);
+
+        pathOffset += pathLength;
+    }
+
+    // Paths
+    for (const File* file : files)
+    {
+        stream.writeString(file->path.toString(), false);
+    }
+}
+
+void PackFileWriter::_writePadding(WriteStream& stream, size_t byteCount)
+{
+    static const uint8_t zeros[PackFile::_alignment] = { 0 };
+    while (byteCount > 0)
+    {
+        size_t count = std::min(byteCount, sizeof(zeros));
+        stream.writeBytes(zeros, count);
+        byteCount -= count;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace hect
+{
+
+///
+/// Builds a pack of files to be read using PackFile.
+class PackFileWriter :
+    public Uncopyable
+{
+public:
+
+    ///
+    /// Adds a file to the pack.
+    ///
+    /// \param path The path of the file in the pack.
+    /// \param data The contents of the file.
+    /// \param compress Whether to compress the contents (the contents are
+    /// stored uncompressed if compressing does not make them smaller).
+    ///
+    /// \throws Error If a file with the same path was already added.
+    void addFile(const Path& path, const std::vector<uint8_t>& data, bool compress = false);
+
+    ///
+    /// Returns the number of files added.
+    size_t fileCount() const;
+
+    ///
+    /// Writes the pack to a stream.
+    ///
+    /// \param stream The stream to write to.
+    void save(WriteStream& stream) const;
+
+private:
+    struct File
+    {
+        Path path;
+        uint64_t hash;
+        uint64_t size;
+        bool compressed;
+        std::vector<uint8_t> storedData;
+    };
+
+    static void _writePadding(WriteStream& stream, size_t byteCount);
+
+    std::vector<File> _files;
+    std::set<Path> _paths;
+};
+
+}
\ No newline at end of file
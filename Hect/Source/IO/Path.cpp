@@ -25,101 +25,204 @@
 
 using namespace hect;
 
-const char pathDelimiter = '/';
+namespace
+{
 
-Path::Path() { }
+const char pathDelimiter = '/';
+const char* const trimmedCharacters = " /";
 
-Path::Path(const char* path)
-{
-    _setRawPath(path);
 }
 
-Path::Path(const std::string& path)
+// Interned paths are never freed, so a path is always safe to copy and
+// compare without holding a reference count
+struct Path::Interned
 {
-    _setRawPath(path.c_str());
-}
+    std::string rawPath;
+    std::string extension;
+    uint64_t hash;
+    const Interned* next;
+};
 
-std::string Path::extension() const
+struct Path::InternTables
 {
+    static const size_t shardCount = 16;
 
-    // Find the position of the first '.' starting from the right
-    size_t i = _rawPath.size();
-    for (; i > 0; --i)
+    InternTables()
     {
-        if (_rawPath[i] == '.')
-        {
-            break;
-        }
+        empty.hash = emptyHash;
+        empty.next = nullptr;
     }
 
-    // Never found a '.' so there is no file extension
-    if (i == 0)
-    {
-        return "";
-    }
+    std::mutex mutexes[shardCount];
+    std::unordered_map<uint64_t, const Interned*> tables[shardCount];
+    Interned empty;
+};
+
+// Zero-initialized before any dynamic initialization, so the tables are
+// available to paths constructed during static initialization
+std::atomic<Path::InternTables*> Path::_internTablesInstance;
+
+Path::Path() :
+    _interned(&_internTables().empty)
+{
+}
 
-    // Return the extension
-    return _rawPath.substr(i + 1, _rawPath.size() - i - 1);
+Path::Path(const char* path)
+{
+    _setRawPath(path, std::strlen(path));
 }
 
-Path Path::operator+(const Path& path) const
+Path::Path(const std::string& path)
 {
-    Path result(*this);
+    _setRawPath(path.c_str(), path.size());
+}
+
+const std::string& Path::extension() const
+{
+    return _interned->extension;
+}
 
+Path Path::operator+(const Path& path) const
+{
     // Only add if the right-hand side is not empty
-    if (!path._rawPath.empty())
+    if (path._interned->rawPath.empty())
     {
+        return *this;
+    }
 
-        // Don't add the delimiter if the left-hand side is empty
-        if (!result._rawPath.empty())
-        {
-            result._rawPath += pathDelimiter;
-        }
-        result._rawPath.append(path._rawPath);
+    // Don't add the delimiter if the left-hand side is empty
+    if (_interned->rawPath.empty())
+    {
+        return path;
     }
+
+    std::string rawPath;
+    rawPath.reserve(_interned->rawPath.size() + path._interned->rawPath.size() + 1);
+    rawPath.append(_interned->rawPath);
+    rawPath += pathDelimiter;
+    rawPath.append(path._interned->rawPath);
+
+    Path result;
+    result._interned = _intern(rawPath.c_str(), rawPath.size());
     return result;
 }
 
 Path& Path::operator+=(const Path& path)
 {
-    // Only add if the right-hand side is not empty
-    if (!path._rawPath.empty())
-    {
-
-        // Don't add the delimiter if this path is empty
-        if (!_rawPath.empty())
-        {
-            _rawPath += pathDelimiter;
-        }
-        _rawPath.append(path._rawPath);
-    }
+    *this = *this + path;
     return *this;
 }
 
 const std::string& Path::toString() const
 {
-    return _rawPath;
+    return _interned->rawPath;
+}
+
+uint64_t Path::hash() const
+{
+    return _interned->hash;
 }
 
 bool Path::operator<(const Path& path) const
 {
-    return _rawPath < path._rawPath;
+    return _interned != path._interned && _interned->rawPath < path._interned->rawPath;
+}
+
+bool Path::operator==(const Path& path) const
+{
+    return _interned == path._interned;
 }
 
-void Path::_setRawPath(const char* rawPath)
+bool Path::operator!=(const Path& path) const
 {
-    _rawPath = std::string(rawPath);
-    std::string delimiter(" /");
+    return _interned != path._interned;
+}
 
+void Path::_setRawPath(const char* rawPath, size_t length)
+{
     // Trim leading/trailing delimiters
-    size_t begin = _rawPath.find_first_not_of(delimiter);
-    if (begin != std::string::npos)
+    size_t begin = 0;
+    while (begin < length && std::strchr(trimmedCharacters, rawPath[begin]))
+    {
+        ++begin;
+    }
+
+    size_t end = length;
+    while (end > begin && std::strchr(trimmedCharacters, rawPath[end - 1]))
+    {
+        --end;
+    }
+
+    _interned = _intern(rawPath + begin, end - begin);
+}
+
+const Path::Interned* Path::_intern(const char* rawPath, size_t length)
+{
+    InternTables& internTables = _internTables();
+    if (length == 0)
+    {
+        return &internTables.empty;
+    }
+
+    uint64_t hash = hashBytes(reinterpret_cast<const uint8_t*>(rawPath), length);
+    size_t shard = (size_t)((hash >> 32) % InternTables::shardCount);
+
+    std::lock_guard<std::mutex> lock(internTables.mutexes[shard]);
+    std::unordered_map<uint64_t, const Interned*>& table = internTables.tables[shard];
+
+    // Look for the path among the paths with the same hash
+    const Interned* first = nullptr;
+    auto it = table.find(hash);
+    if (it != table.end())
+    {
+        first = it->second;
+        for (const Interned* interned = first; interned; interned = interned->next)
+        {
+            if (interned->rawPath.size() == length && std::memcmp(interned->rawPath.c_str(), rawPath, length) == 0)
+            {
+                return interned;
+            }
+        }
+    }
+
+    Interned* interned = new Interned();
+    interned->rawPath.assign(rawPath, length);
+    interned->hash = hash;
+    interned->next = first;
+
+    // Find the position of the first '.' starting from the right
+    for (size_t i = length - 1; i > 0; --i)
     {
-        size_t end = _rawPath.find_last_not_of(delimiter);
-        size_t range = end - begin + 1;
+        if (rawPath[i] == '.')
+        {
+            interned->extension.assign(rawPath + i + 1, length - i - 1);
+            break;
+        }
+    }
 
-        _rawPath = _rawPath.substr(begin, range);
+    table[hash] = interned;
+    return interned;
+}
+
+Path::InternTables& Path::_internTables()
+{
+    InternTables* internTables = _internTablesInstance.load(std::memory_order_acquire);
+    if (!internTables)
+    {
+        // Like the interned paths, the tables are never freed so paths
+        // remain valid during static destruction
+        InternTables* createdTables = new InternTables();
+        if (_internTablesInstance.compare_exchange_strong(internTables, createdTables, std::memory_order_acq_rel))
+        {
+            internTables = createdTables;
+        }
+        else
+        {
+            // Another thread created the tables first
+            delete createdTables;
+        }
     }
+    return *internTables;
 }
 
 namespace hect
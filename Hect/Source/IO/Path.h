@@ -28,6 +28,11 @@ namespace hect
 
 ///
 /// A path to a file or directory.
+///
+/// \remarks The raw string of every path is interned along with its hash
+/// and extension, so copying, hashing, and comparing paths for equality
+/// never touch the string itself.  The intern tables are created on first
+/// use, so paths may be constructed during static initialization.
 class Path
 {
 public:
@@ -52,7 +57,7 @@ public:
 
     ///
     /// Returns the file extension of the path.
-    std::string extension() const;
+    const std::string& extension() const;
 
     ///
     /// Returns the concatenation of the path and another path.
@@ -70,14 +75,34 @@ public:
     /// Returns the raw path.
     const std::string& toString() const;
 
+    ///
+    /// Returns the hash of the raw path.
+    uint64_t hash() const;
+
     ///
     /// Returns true if the path is less than the given path.
     bool operator<(const Path& path) const;
 
+    ///
+    /// Returns true if the path is equal to the given path.
+    bool operator==(const Path& path) const;
+
+    ///
+    /// Returns true if the path is not equal to the given path.
+    bool operator!=(const Path& path) const;
+
 private:
-    void _setRawPath(const char* rawPath);
+    struct Interned;
+    struct InternTables;
+
+    void _setRawPath(const char* rawPath, size_t length);
+
+    static const Interned* _intern(const char* rawPath, size_t length);
+    static InternTables& _internTables();
 
-    std::string _rawPath;
+    static std::atomic<InternTables*> _internTablesInstance;
+
+    const Interned* _interned;
 };
 
 ///
@@ -87,4 +112,20 @@ private:
 /// \param path the path to output.
 std::ostream& operator<<(std::ostream& os, const Path& path);
 
+}
+
+namespace std
+{
+
+///
+/// Hashes a path using its precomputed hash.
+template <>
+struct hash<hect::Path>
+{
+    size_t operator()(const hect::Path& path) const
+    {
+        return (size_t)path.hash();
+    }
+};
+
 }
\ No newline at end of file
@@ -97,6 +97,22 @@ uint64_t ReadStream::readUnsignedLong()
     return value;
 }
 
+uint64_t ReadStream::readVarUnsignedInt()
+{
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte = readUnsignedByte();
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return value;
+        }
+    }
+
+    throw Error("Variable length integer is too long");
+}
+
 float ReadStream::readFloat()
 {
     float value = 0;
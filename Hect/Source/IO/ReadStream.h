@@ -80,6 +80,13 @@ public:
     /// Reads an unsigned 64-bit integer.
     uint64_t readUnsignedLong();
 
+    ///
+    /// Reads an unsigned integer written using as few bytes as needed
+    /// (LEB128).
+    ///
+    /// \throws Error If the encoded value is longer than 64 bits.
+    uint64_t readVarUnsignedInt();
+
     ///
     /// Reads a 32-bit float.
     float readFloat();
@@ -75,6 +75,26 @@ void WriteStream::writeUnsignedLong(uint64_t value)
     writeBytes((const uint8_t*)&value, 8);
 }
 
+void WriteStream::writeVarUnsignedInt(uint64_t value)
+{
+    // Write 7 bits at a time with the high bit set on all but the last byte
+    uint8_t bytes[10];
+    size_t byteCount = 0;
+    do
+    {
+        uint8_t byte = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        if (value)
+        {
+            byte |= 0x80;
+        }
+        bytes[byteCount++] = byte;
+    }
+    while (value);
+
+    writeBytes(bytes, byteCount);
+}
+
 void WriteStream::writeFloat(float value)
 {
     writeBytes((const uint8_t*)&value, 4);
@@ -96,6 +96,14 @@ public:
     /// \param value The value to write.
     void writeUnsignedLong(uint64_t value);
 
+    ///
+    /// Writes an unsigned integer using as few bytes as needed (LEB128).
+    ///
+    /// \remarks Values less than 128 are written as a single byte.
+    ///
+    /// \param value The value to write.
+    void writeVarUnsignedInt(uint64_t value);
+
     ///
     /// Writes a 32-bit float.
     ///
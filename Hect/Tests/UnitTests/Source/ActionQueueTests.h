@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+void countActionQueueCall(std::atomic<unsigned>& callCount)
+{
+    ++callCount;
+}
+
+SUITE(ActionQueue)
+{
+    TEST(Enqueue)
+    {
+        ActionQueue actionQueue;
+
+        std::vector<int> order;
+        actionQueue.enqueue([&order] { order.push_back(0); });
+        actionQueue.enqueue([&order] { order.push_back(1); });
+        CHECK_EQUAL(2u, actionQueue.pendingCount());
+        CHECK(order.empty());
+
+        CHECK_EQUAL(2u, actionQueue.execute());
+        CHECK_EQUAL(0u, actionQueue.pendingCount());
+        CHECK_EQUAL(2u, order.size());
+        CHECK_EQUAL(0, order[0]);
+        CHECK_EQUAL(1, order[1]);
+    }
+
+    TEST(EnqueueFromAction)
+    {
+        ActionQueue actionQueue;
+
+        bool executed = false;
+        actionQueue.enqueue([&actionQueue, &executed]
+        {
+            actionQueue.enqueue([&executed] { executed = true; });
+        });
+
+        // The action enqueued while executing waits for the next call
+        CHECK_EQUAL(1u, actionQueue.execute());
+        CHECK(!executed);
+        CHECK_EQUAL(1u, actionQueue.execute());
+        CHECK(executed);
+    }
+
+    TEST(EnqueueWhenDone)
+    {
+        TaskPool taskPool(2);
+        ActionQueue actionQueue;
+
+        std::atomic<bool> release(false);
+        Task task = taskPool.enqueue([&release]
+        {
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        });
+
+        std::thread::id executingThreadId;
+        actionQueue.enqueueWhenDone(task, [&executingThreadId]
+        {
+            executingThreadId = std::this_thread::get_id();
+        });
+
+        CHECK_EQUAL(0u, actionQueue.execute());
+
+        release = true;
+        task.wait();
+
+        CHECK_EQUAL(1u, actionQueue.execute());
+        CHECK(executingThreadId == std::this_thread::get_id());
+    }
+
+    TEST(EnqueueAfter)
+    {
+        ActionQueue actionQueue;
+
+        bool executed = false;
+        actionQueue.enqueueAfter(TimeSpan::fromMilliseconds(20), [&executed] { executed = true; });
+
+        CHECK_EQUAL(0u, actionQueue.execute());
+        CHECK(!executed);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+        CHECK_EQUAL(1u, actionQueue.execute());
+        CHECK(executed);
+    }
+
+    TEST(ExecuteWithBudget)
+    {
+        ActionQueue actionQueue;
+
+        std::vector<int> order;
+        actionQueue.enqueue([&order]
+        {
+            order.push_back(0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        });
+        actionQueue.enqueueAfter(TimeSpan::fromSeconds(60), [&order] { order.push_back(-1); });
+        actionQueue.enqueue([&order] { order.push_back(1); });
+        actionQueue.enqueue([&order] { order.push_back(2); });
+
+        // The actions left over when the budget is spent keep their order
+        CHECK_EQUAL(1u, actionQueue.execute(TimeSpan::fromMilliseconds(1)));
+        CHECK_EQUAL(3u, actionQueue.pendingCount());
+        CHECK_EQUAL(2u, actionQueue.execute());
+        CHECK_EQUAL(1u, actionQueue.pendingCount());
+
+        CHECK_EQUAL(3u, order.size());
+        CHECK_EQUAL(0, order[0]);
+        CHECK_EQUAL(1, order[1]);
+        CHECK_EQUAL(2, order[2]);
+    }
+
+    TEST(EnqueueFromManyThreads)
+    {
+        ActionQueue actionQueue;
+        std::atomic<unsigned> callCount(0);
+
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            threads.push_back(std::thread([&actionQueue, &callCount]
+            {
+                for (unsigned j = 0; j < 100; ++j)
+                {
+                    actionQueue.enqueue(std::bind(countActionQueueCall, std::ref(callCount)));
+                }
+            }));
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        CHECK_EQUAL(400u, actionQueue.execute());
+        CHECK_EQUAL(400u, callCount.load());
+    }
+
+    TEST(ErrorInAction)
+    {
+        ActionQueue actionQueue;
+
+        bool executed = false;
+        actionQueue.enqueue([] { throw Error("Test"); });
+        actionQueue.enqueue([&executed] { executed = true; });
+
+        CHECK_THROW(actionQueue.execute(), Error);
+        CHECK(!executed);
+
+        CHECK_EQUAL(1u, actionQueue.execute());
+        CHECK(executed);
+    }
+
+    TEST(EmptyAction)
+    {
+        ActionQueue actionQueue;
+        CHECK_THROW(actionQueue.enqueue(TaskFunction()), Error);
+    }
+}
\ No newline at end of file
@@ -21,6 +21,64 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 ///////////////////////////////////////////////////////////////////////////////
+namespace hect
+{
+
+// An asset which loads without reading from the file system
+class LoadCountingAsset
+{
+public:
+    LoadCountingAsset() :
+        loaded(false)
+    {
+    }
+
+    bool loaded;
+
+    static std::atomic<unsigned> loadCount;
+    static std::atomic<bool> failLoads;
+};
+
+std::atomic<unsigned> LoadCountingAsset::loadCount(0);
+std::atomic<bool> LoadCountingAsset::failLoads(false);
+
+template <>
+void AssetLoader<LoadCountingAsset>::load(LoadCountingAsset& asset, const Path& assetPath, AssetCache& assetCache)
+{
+    assetCache;
+
+    ++LoadCountingAsset::loadCount;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    if (assetPath.toString() == "Fail" || LoadCountingAsset::failLoads)
+    {
+        throw Error("Failed on purpose");
+    }
+
+    asset.loaded = true;
+}
+
+size_t assetMemorySize(const LoadCountingAsset& asset)
+{
+    asset;
+    return 100;
+}
+
+// An asset which depends on a load counting asset
+class DependentAsset
+{
+public:
+    LoadCountingAsset* dependency;
+};
+
+template <>
+void AssetLoader<DependentAsset>::load(DependentAsset& asset, const Path& assetPath, AssetCache& assetCache)
+{
+    asset.dependency = &assetCache.get<LoadCountingAsset>(assetPath.toString() + ".Dependency");
+}
+
+}
+
 SUITE(AssetCache)
 {
     TEST(GetAsset)
@@ -83,4 +141,700 @@ SUITE(AssetCache)
         CHECK(ShaderModuleType::Vertex == a.get().type());
         CHECK(ShaderModuleType::Pixel == b.get().type());
     }
+
+    TEST(LoadAsync)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(2);
+        AssetCache assetCache(fileSystem, taskPool);
+
+        LoadCountingAsset::loadCount = 0;
+
+        AssetHandle<LoadCountingAsset> a = assetCache.loadAsync<LoadCountingAsset>("A");
+        AssetHandle<LoadCountingAsset> b = assetCache.loadAsync<LoadCountingAsset>("A");
+        a.wait();
+
+        CHECK(a.isReady());
+        CHECK(b.isReady());
+        CHECK(a.get().loaded);
+        CHECK_EQUAL(&a.get(), &b.get());
+        CHECK_EQUAL(1u, LoadCountingAsset::loadCount.load());
+    }
+
+    TEST(GetWhileLoadingAsync)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(1);
+        AssetCache assetCache(fileSystem, taskPool);
+
+        LoadCountingAsset::loadCount = 0;
+
+        assetCache.loadAsync<LoadCountingAsset>("A");
+        CHECK(assetCache.get<LoadCountingAsset>("A").loaded);
+        CHECK_EQUAL(1u, LoadCountingAsset::loadCount.load());
+    }
+
+    TEST(GetInTaskWhileLoadingAsync)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(1);
+        AssetCache assetCache(fileSystem, taskPool);
+
+        LoadCountingAsset::loadCount = 0;
+
+        // Each get runs on the only worker thread while the asynchronous
+        // load of the same asset is being enqueued, so the get must help
+        // with the load rather than block the worker
+        for (unsigned i = 0; i < 20; ++i)
+        {
+            Path path(format("Asset%u", i));
+
+            std::atomic<bool> loading(false);
+            Task task = taskPool.enqueue([&assetCache, &loading, path]
+            {
+                while (!loading)
+                {
+                    std::this_thread::yield();
+                }
+                CHECK(assetCache.get<LoadCountingAsset>(path).loaded);
+            });
+
+            loading = true;
+            assetCache.loadAsync<LoadCountingAsset>(path);
+            task.wait();
+        }
+
+        CHECK_EQUAL(20u, LoadCountingAsset::loadCount.load());
+    }
+
+    TEST(LoadAsyncWithoutTaskPool)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+
+        AssetHandle<LoadCountingAsset> a = assetCache.loadAsync<LoadCountingAsset>("A");
+        CHECK(a.isReady());
+        CHECK(a.get().loaded);
+    }
+
+    TEST(LoadAsyncWithoutThreads)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(0);
+        AssetCache assetCache(fileSystem, taskPool);
+
+        AssetHandle<LoadCountingAsset> a = assetCache.loadAsync<LoadCountingAsset>("A");
+        CHECK(a.isReady());
+        CHECK(a.get().loaded);
+
+        bool loaded = false;
+        a.onReady([a, &loaded]
+        {
+            loaded = a.get().loaded;
+        });
+        assetCache.finalizeLoads(TimeSpan::fromSeconds(1));
+        CHECK(loaded);
+    }
+
+    TEST(LoadAsyncWithError)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(2);
+        AssetCache assetCache(fileSystem, taskPool);
+
+        AssetHandle<LoadCountingAsset> a = assetCache.loadAsync<LoadCountingAsset>("Fail");
+        CHECK_THROW(a.wait(), Error);
+        CHECK(a.isReady());
+        CHECK_THROW(a.get(), Error);
+    }
+
+    TEST(OnReady)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(2);
+        AssetCache assetCache(fileSystem, taskPool);
+
+        AssetHandle<LoadCountingAsset> a = assetCache.loadAsync<LoadCountingAsset>("A");
+
+        bool loaded = false;
+        a.onReady([a, &loaded]
+        {
+            loaded = a.get().loaded;
+        });
+        a.wait();
+
+        // The action is executed when loads are finalized
+        CHECK(!loaded);
+        CHECK_EQUAL(1u, assetCache.finalizeLoads(TimeSpan::fromSeconds(1)));
+        CHECK(loaded);
+
+        // An action for an asset which is already ready is executed on the
+        // next finalization
+        bool executed = false;
+        a.onReady([&executed] { executed = true; });
+        CHECK(!executed);
+        assetCache.finalizeLoads(TimeSpan::fromSeconds(1));
+        CHECK(executed);
+    }
+
+    TEST(FinalizationBudget)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            assetCache.enqueueFinalization([]
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            });
+        }
+
+        // At least one action is executed even if it exceeds the budget
+        CHECK_EQUAL(1u, assetCache.finalizeLoads(TimeSpan::fromMilliseconds(1)));
+        CHECK_EQUAL(2u, assetCache.finalizeLoads(TimeSpan::fromSeconds(1)));
+    }
+
+    TEST(ConcurrentRequestsShareOneLoad)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(2);
+        AssetCache assetCache(fileSystem, taskPool);
+
+        LoadCountingAsset::loadCount = 0;
+
+        const unsigned pathCount = 8;
+
+        // Request every asset from several threads at once, both
+        // synchronously and asynchronously
+        std::atomic<bool> allLoaded(true);
+        std::vector<std::thread> threads;
+        for (unsigned threadIndex = 0; threadIndex < 4; ++threadIndex)
+        {
+            threads.push_back(std::thread([&assetCache, &allLoaded, threadIndex, pathCount]
+            {
+                for (unsigned i = 0; i < pathCount; ++i)
+                {
+                    Path path(format("Asset%d", (i + threadIndex) % pathCount));
+                    if (threadIndex % 2 == 0)
+                    {
+                        allLoaded = allLoaded && assetCache.get<LoadCountingAsset>(path).loaded;
+                    }
+                    else
+                    {
+                        AssetHandle<LoadCountingAsset> handle = assetCache.loadAsync<LoadCountingAsset>(path);
+                        handle.wait();
+                        allLoaded = allLoaded && handle.get().loaded;
+                    }
+                }
+            }));
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        CHECK(allLoaded.load());
+        CHECK_EQUAL(pathCount, LoadCountingAsset::loadCount.load());
+    }
+
+    TEST(MemoryAccounting)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+
+        assetCache.get<LoadCountingAsset>("A");
+        assetCache.get<LoadCountingAsset>("B");
+
+        AssetCache::Statistics statistics = assetCache.statistics();
+        CHECK_EQUAL(200u, statistics.memoryUsage);
+        CHECK_EQUAL(200u, statistics.memoryUsageByType[typeid(LoadCountingAsset).name()]);
+
+        assetCache.clear();
+
+        CHECK_EQUAL(0u, assetCache.statistics().memoryUsage);
+    }
+
+    TEST(EvictLeastRecentlyUsed)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+        assetCache.setMemoryBudget(250);
+
+        LoadCountingAsset::loadCount = 0;
+
+        assetCache.get<LoadCountingAsset>("A");
+        assetCache.get<LoadCountingAsset>("B");
+        assetCache.get<LoadCountingAsset>("C");
+        assetCache.get<LoadCountingAsset>("A");
+
+        CHECK_EQUAL(100u, assetCache.trim());
+
+        AssetCache::Statistics statistics = assetCache.statistics();
+        CHECK_EQUAL(200u, statistics.memoryUsage);
+        CHECK_EQUAL(1u, statistics.evictionCount);
+        CHECK_EQUAL(0u, statistics.reloadCount);
+
+        // A is still resident
+        assetCache.get<LoadCountingAsset>("A");
+        CHECK_EQUAL(3u, LoadCountingAsset::loadCount.load());
+
+        // B was evicted and is loaded again
+        CHECK(assetCache.get<LoadCountingAsset>("B").loaded);
+        CHECK_EQUAL(4u, LoadCountingAsset::loadCount.load());
+        CHECK_EQUAL(1u, assetCache.statistics().reloadCount);
+    }
+
+    TEST(EvictWithoutBudget)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+
+        assetCache.get<LoadCountingAsset>("A");
+        assetCache.get<LoadCountingAsset>("B");
+
+        CHECK_EQUAL(0u, assetCache.trim());
+        CHECK_EQUAL(200u, assetCache.statistics().memoryUsage);
+    }
+
+    TEST(PinnedAssetNotEvicted)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+        assetCache.setMemoryBudget(150);
+
+        assetCache.getHandle<LoadCountingAsset>("A").setPinned(true);
+        assetCache.get<LoadCountingAsset>("A");
+        assetCache.get<LoadCountingAsset>("B");
+
+        CHECK_EQUAL(100u, assetCache.trim());
+
+        LoadCountingAsset::loadCount = 0;
+        assetCache.get<LoadCountingAsset>("A");
+        CHECK_EQUAL(0u, LoadCountingAsset::loadCount.load());
+    }
+
+    TEST(ReferencedAssetNotEvicted)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+        assetCache.setMemoryBudget(50);
+
+        AssetHandle<LoadCountingAsset> a = assetCache.getHandle<LoadCountingAsset>("A");
+        a.get();
+        assetCache.get<LoadCountingAsset>("B");
+
+        CHECK_EQUAL(100u, assetCache.trim());
+        CHECK_EQUAL(100u, assetCache.statistics().memoryUsage);
+        CHECK(a.get().loaded);
+    }
+
+    TEST(FinalizeLoadsTrims)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+
+        assetCache.get<LoadCountingAsset>("A");
+        assetCache.get<LoadCountingAsset>("B");
+        assetCache.setMemoryBudget(100);
+
+        assetCache.finalizeLoads(TimeSpan::fromMilliseconds(1));
+
+        CHECK_EQUAL(100u, assetCache.statistics().memoryUsage);
+    }
+
+    TEST(FinalizeLoadsTrimsOnError)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+
+        assetCache.get<LoadCountingAsset>("A");
+        assetCache.get<LoadCountingAsset>("B");
+        assetCache.setMemoryBudget(100);
+
+        assetCache.enqueueFinalization([]
+        {
+            throw Error("Failed on purpose");
+        });
+        CHECK_THROW(assetCache.finalizeLoads(TimeSpan::fromMilliseconds(1)), Error);
+
+        CHECK_EQUAL(100u, assetCache.statistics().memoryUsage);
+    }
+
+    TEST(RecordManifest)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+        assetCache.registerAssetType<LoadCountingAsset>("LoadCountingAsset");
+        assetCache.registerAssetType<DependentAsset>("DependentAsset");
+
+        assetCache.startRecording();
+        assetCache.get<DependentAsset>("A");
+        assetCache.get<LoadCountingAsset>("B");
+        assetCache.get<DependentAsset>("A");
+        AssetManifest manifest = assetCache.stopRecording();
+
+        // Not recorded after recording stopped
+        assetCache.get<LoadCountingAsset>("C");
+
+        const std::vector<AssetManifest::Entry>& entries = manifest.entries();
+        CHECK_EQUAL(3u, entries.size());
+        CHECK_EQUAL("A", entries[0].path.toString());
+        CHECK_EQUAL("DependentAsset", entries[0].typeName);
+        CHECK_EQUAL(1u, entries[0].dependencies.size());
+        CHECK_EQUAL("A.Dependency", entries[0].dependencies[0].toString());
+        CHECK_EQUAL("A.Dependency", entries[1].path.toString());
+        CHECK_EQUAL("LoadCountingAsset", entries[1].typeName);
+        CHECK_EQUAL(0u, entries[1].dependencies.size());
+        CHECK_EQUAL("B", entries[2].path.toString());
+
+        // Dependencies are loaded first
+        std::vector<const AssetManifest::Entry*> loadOrder = manifest.loadOrder();
+        CHECK_EQUAL(3u, loadOrder.size());
+        CHECK_EQUAL("A.Dependency", loadOrder[0]->path.toString());
+        CHECK_EQUAL("A", loadOrder[1]->path.toString());
+        CHECK_EQUAL("B", loadOrder[2]->path.toString());
+    }
+
+    TEST(SaveAndLoadManifest)
+    {
+        AssetManifest manifest;
+        manifest.addAsset("A", "DependentAsset");
+        manifest.addAsset("A.Dependency", "LoadCountingAsset");
+        manifest.addDependency("A", "A.Dependency");
+
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            manifest.save(stream);
+        }
+
+        AssetManifest loadedManifest;
+        {
+            MemoryReadStream stream(data);
+            loadedManifest.load(stream);
+        }
+
+        const std::vector<AssetManifest::Entry>& entries = loadedManifest.entries();
+        CHECK_EQUAL(2u, entries.size());
+        CHECK_EQUAL("A", entries[0].path.toString());
+        CHECK_EQUAL("DependentAsset", entries[0].typeName);
+        CHECK_EQUAL(1u, entries[0].dependencies.size());
+        CHECK_EQUAL("A.Dependency", entries[0].dependencies[0].toString());
+        CHECK_EQUAL("A.Dependency", entries[1].path.toString());
+        CHECK_EQUAL("LoadCountingAsset", entries[1].typeName);
+    }
+
+    TEST(Prefetch)
+    {
+        AssetManifest manifest;
+        manifest.addAsset("A", "DependentAsset");
+        manifest.addAsset("A.Dependency", "LoadCountingAsset");
+        manifest.addDependency("A", "A.Dependency");
+        manifest.addAsset("B", "UnregisteredAsset");
+
+        FileSystem fileSystem;
+        TaskPool taskPool(2);
+        AssetCache assetCache(fileSystem, taskPool);
+        assetCache.registerAssetType<LoadCountingAsset>("LoadCountingAsset");
+        assetCache.registerAssetType<DependentAsset>("DependentAsset");
+
+        LoadCountingAsset::loadCount = 0;
+
+        CHECK_EQUAL(2u, assetCache.prefetch(manifest));
+
+        AssetHandle<DependentAsset> a = assetCache.getHandle<DependentAsset>("A");
+        a.wait();
+        CHECK(a.isReady());
+        CHECK(a.get().dependency->loaded);
+        CHECK_EQUAL(1u, LoadCountingAsset::loadCount.load());
+    }
+
+    TEST(ProfileLoads)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+        assetCache.registerAssetType<DependentAsset>("DependentAsset");
+
+        assetCache.startProfiling();
+        assetCache.get<DependentAsset>("A");
+        AssetLoadProfile profile = assetCache.stopProfiling();
+
+        const std::vector<AssetLoadProfile::Load>& loads = profile.loads();
+        CHECK_EQUAL(2u, loads.size());
+        CHECK_EQUAL("A.Dependency", loads[0].path.toString());
+        CHECK_EQUAL("A", loads[0].parentPath.toString());
+        CHECK_EQUAL(100u, loads[0].memorySize);
+        CHECK_EQUAL("A", loads[1].path.toString());
+        CHECK_EQUAL("DependentAsset", loads[1].typeName);
+        CHECK_EQUAL("", loads[1].parentPath.toString());
+
+        // The time of the dependency is not part of the cost of the asset
+        TimeSpan dependencyTime = loads[0].totalTime;
+        TimeSpan time = loads[1].totalTime;
+        TimeSpan cost = loads[1].cost();
+        CHECK(dependencyTime.microseconds() >= 5000);
+        CHECK(time.microseconds() >= dependencyTime.microseconds());
+        CHECK(cost.microseconds() < dependencyTime.microseconds());
+
+        std::vector<const AssetLoadProfile::Load*> loadsByCost = profile.loadsByCost();
+        CHECK_EQUAL("A.Dependency", loadsByCost[0]->path.toString());
+    }
+
+    TEST(ProfileParentIsRequestingAsset)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(1);
+        AssetCache assetCache(fileSystem, taskPool);
+        assetCache.registerAssetType<DependentAsset>("DependentAsset");
+
+        assetCache.startProfiling();
+
+        // Hold the only worker thread until the loads are queued
+        std::atomic<bool> queued(false);
+        taskPool.enqueue([&queued]
+        {
+            while (!queued)
+            {
+                std::this_thread::yield();
+            }
+        }, TaskPriority::Low);
+
+        // While loading "A" the worker waits for its dependency, executing
+        // the unrelated load of "B" queued before the dependency
+        AssetHandle<DependentAsset> a = assetCache.loadAsync<DependentAsset>("A");
+        assetCache.loadAsync<LoadCountingAsset>("B");
+        assetCache.loadAsync<LoadCountingAsset>("A.Dependency");
+        queued = true;
+
+        while (!a.isReady())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        AssetLoadProfile profile = assetCache.stopProfiling();
+
+        // Every load was first requested from this thread, so none has a
+        // parent even though "B" was loaded in the middle of loading "A"
+        const std::vector<AssetLoadProfile::Load>& loads = profile.loads();
+        CHECK_EQUAL(3u, loads.size());
+        for (const AssetLoadProfile::Load& load : loads)
+        {
+            CHECK_EQUAL("", load.parentPath.toString());
+        }
+    }
+
+    TEST(ProfileFileReads)
+    {
+        FileSystem fileSystem;
+        fileSystem.addDataSource("Data");
+
+        AssetCache assetCache(fileSystem);
+
+        size_t length = 0;
+        {
+            FileReadStream stream = fileSystem.openFileForRead("IndexType.mesh");
+            length = stream.length();
+        }
+
+        assetCache.startProfiling();
+        assetCache.get<DataValue>("IndexType.mesh");
+        AssetLoadProfile profile = assetCache.stopProfiling();
+
+        // The loader reads the signature of the file before the rest of it
+        CHECK_EQUAL(1u, profile.loads().size());
+        CHECK(profile.loads()[0].bytesRead >= length);
+        CHECK_EQUAL(fileSystem.threadReadStatistics().bytesRead, profile.loads()[0].bytesRead);
+    }
+
+    TEST(ProfileFinalization)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(1);
+        AssetCache assetCache(fileSystem, taskPool);
+
+        assetCache.startProfiling();
+
+        AssetHandle<LoadCountingAsset> a = assetCache.loadAsync<LoadCountingAsset>("A");
+        a.onReady([]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        });
+        a.wait();
+        assetCache.finalizeLoads(TimeSpan::fromSeconds(1));
+
+        AssetLoadProfile profile = assetCache.stopProfiling();
+
+        CHECK_EQUAL(1u, profile.loads().size());
+        TimeSpan finalizeTime = profile.loads()[0].finalizeTime;
+        CHECK(finalizeTime.microseconds() >= 5000);
+    }
+
+    TEST(SaveProfile)
+    {
+        AssetLoadProfile profile;
+
+        AssetLoadProfile::Load parent;
+        parent.path = "A";
+        parent.decodeTime = TimeSpan::fromMicroseconds(10);
+        profile.addLoad(parent);
+
+        AssetLoadProfile::Load child;
+        child.path = "B";
+        child.parentPath = "A";
+        child.readTime = TimeSpan::fromMicroseconds(20);
+        child.bytesRead = 30;
+        profile.addLoad(child);
+
+        profile.addFinalizeTime("A", TimeSpan::fromMicroseconds(40));
+
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            profile.save(stream);
+        }
+
+        DataValue report;
+        DataValueJsonFormat::load(report, std::string(data.begin(), data.end()));
+        CHECK_EQUAL(70, report["totalCost"].asInt());
+        CHECK_EQUAL(2u, report["loads"].size());
+        CHECK_EQUAL("A", report["loads"][0]["path"].asString());
+        CHECK_EQUAL(50, report["loads"][0]["cost"].asInt());
+        CHECK_EQUAL("B", report["loads"][1]["path"].asString());
+        CHECK_EQUAL(30, report["loads"][1]["bytesRead"].asInt());
+
+        data.clear();
+        {
+            MemoryWriteStream stream(data);
+            profile.saveFoldedStacks(stream);
+        }
+        CHECK_EQUAL("A 50\nA;B 20\n", std::string(data.begin(), data.end()));
+    }
+
+    TEST(ReloadWithDependents)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+        assetCache.setHotReloadEnabled(true);
+
+        LoadCountingAsset::loadCount = 0;
+
+        AssetHandle<DependentAsset> a = assetCache.getHandle<DependentAsset>("A");
+        AssetHandle<LoadCountingAsset> b = assetCache.getHandle<LoadCountingAsset>("B");
+        std::shared_ptr<DependentAsset> previousA = a.getShared();
+        b.get();
+        CHECK_EQUAL(2u, LoadCountingAsset::loadCount.load());
+
+        // Reloading the dependency reloads the asset which depends on it
+        CHECK_EQUAL(2u, assetCache.reload("A.Dependency"));
+        CHECK_EQUAL(3u, LoadCountingAsset::loadCount.load());
+        CHECK(previousA != a.getShared());
+        CHECK_EQUAL(&assetCache.get<LoadCountingAsset>("A.Dependency"), a.get().dependency);
+        CHECK_EQUAL(2u, assetCache.statistics().reloadCount);
+
+        // The previous version remains valid until finalized
+        CHECK(previousA->dependency->loaded);
+        previousA.reset();
+        assetCache.finalizeLoads(TimeSpan::fromSeconds(1));
+
+        // Not reloaded since nothing depends on it
+        CHECK_EQUAL(1u, assetCache.reload("B"));
+        CHECK_EQUAL(4u, LoadCountingAsset::loadCount.load());
+        CHECK_EQUAL(0u, assetCache.reload("C"));
+    }
+
+    TEST(ReloadAsync)
+    {
+        FileSystem fileSystem;
+        TaskPool taskPool(2);
+        AssetCache assetCache(fileSystem, taskPool);
+        assetCache.setHotReloadEnabled(true);
+
+        AssetHandle<DependentAsset> a = assetCache.getHandle<DependentAsset>("A");
+        std::shared_ptr<DependentAsset> previousA = a.getShared();
+
+        CHECK_EQUAL(2u, assetCache.reload("A.Dependency"));
+
+        // Wait for the reload to complete in the task pool
+        for (int i = 0; i < 100 && previousA == a.getShared(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        CHECK(previousA != a.getShared());
+        CHECK(a.get().dependency->loaded);
+    }
+
+    TEST(ReloadWithError)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+        assetCache.setHotReloadEnabled(true);
+
+        AssetHandle<LoadCountingAsset> a = assetCache.getHandle<LoadCountingAsset>("A");
+        std::shared_ptr<LoadCountingAsset> previousA = a.getShared();
+
+        // The previous version is kept if the reload fails
+        LoadCountingAsset::failLoads = true;
+        assetCache.reload("A");
+        LoadCountingAsset::failLoads = false;
+
+        CHECK_EQUAL(previousA, a.getShared());
+        CHECK(a.get().loaded);
+        CHECK_EQUAL(0u, assetCache.statistics().reloadCount);
+    }
+
+    TEST(ReloadChanged)
+    {
+        FileSystem fileSystem;
+        Path workingDirectory = fileSystem.workingDirectory();
+        fileSystem.addDataSource(workingDirectory);
+        fileSystem.setWriteDirectory(workingDirectory);
+
+        Path path("Changed.txt");
+        {
+            FileWriteStream stream = fileSystem.openFileForWrite(path);
+            stream.writeString("A");
+        }
+
+        AssetCache assetCache(fileSystem);
+        assetCache.setHotReloadEnabled(true);
+
+        LoadCountingAsset::loadCount = 0;
+
+        assetCache.get<LoadCountingAsset>(path);
+        CHECK_EQUAL(0u, assetCache.reloadChanged());
+
+        // Modification times have a resolution of a second
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        {
+            FileWriteStream stream = fileSystem.openFileForWrite(path);
+            stream.writeString("B");
+        }
+
+        CHECK_EQUAL(1u, assetCache.reloadChanged());
+        CHECK_EQUAL(2u, LoadCountingAsset::loadCount.load());
+        CHECK_EQUAL(0u, assetCache.reloadChanged());
+
+        fileSystem.remove(path);
+    }
+
+    TEST(RegisterAssetTypeTwice)
+    {
+        FileSystem fileSystem;
+        AssetCache assetCache(fileSystem);
+        assetCache.registerAssetType<LoadCountingAsset>("LoadCountingAsset");
+
+        bool errorThrown = false;
+        try
+        {
+            assetCache.registerAssetType<DependentAsset>("LoadCountingAsset");
+        }
+        catch (Error&)
+        {
+            errorThrown = true;
+        }
+        CHECK(errorThrown);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,230 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+void writeCookSource(const Path& path, const std::string& contents)
+{
+    FileSystem fileSystem;
+    fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+
+    fileSystem.createDirectory("CookSource");
+    FileWriteStream stream = fileSystem.openFileForWrite(Path("CookSource") + path);
+    stream.writeBytes(reinterpret_cast<const uint8_t*>(contents.c_str()), contents.size());
+}
+
+void removeCookFiles()
+{
+    FileSystem fileSystem;
+    fileSystem.addDataSource(fileSystem.workingDirectory());
+    fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+
+    if (fileSystem.exists("CookSource"))
+    {
+        for (const Path& path : fileSystem.directoryContents("CookSource"))
+        {
+            fileSystem.remove(path);
+        }
+        fileSystem.remove("CookSource");
+    }
+
+    if (fileSystem.exists("Cooked.pack"))
+    {
+        fileSystem.remove("Cooked.pack");
+    }
+}
+
+AssetCooker::Result cookSource(const Path& previousPackPath = Path())
+{
+    AssetCooker::Result result;
+    PackFileWriter writer;
+
+    {
+        FileSystem fileSystem;
+        fileSystem.addDataSource(fileSystem.workingDirectory() + "CookSource");
+
+        std::unique_ptr<PackFile> previousPack;
+        if (!previousPackPath.toString().empty())
+        {
+            previousPack.reset(new PackFile(fileSystem.workingDirectory() + previousPackPath));
+        }
+
+        TaskPool taskPool(2);
+        AssetCooker cooker(fileSystem, taskPool);
+        result = cooker.cook(Path(), writer, previousPack.get());
+    }
+
+    FileSystem fileSystem;
+    fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+
+    FileWriteStream stream = fileSystem.openFileForWrite("Cooked.pack");
+    writer.save(stream);
+
+    return result;
+}
+
+std::vector<uint8_t> cookedContents(const Path& path)
+{
+    FileSystem fileSystem;
+    PackFile packFile(fileSystem.workingDirectory() + "Cooked.pack");
+
+    std::vector<uint8_t> buffer;
+    size_t size = 0;
+    const uint8_t* contents = packFile.fileContents(path, buffer, size);
+    return std::vector<uint8_t>(contents, contents + size);
+}
+
+SUITE(AssetCooker)
+{
+    TEST(CookDataValue)
+    {
+        removeCookFiles();
+        writeCookSource("Test.material", "{ \"name\" : \"Test\", \"value\" : 5 }");
+
+        AssetCooker::Result result = cookSource();
+        CHECK(result.errors.empty());
+        CHECK_EQUAL(1u, result.cookedCount);
+        CHECK_EQUAL(0u, result.copiedCount);
+
+        std::vector<uint8_t> cooked = cookedContents("Test.material");
+        DataValue dataValue;
+        DataValueBinaryFormat::load(dataValue, &cooked[0], cooked.size());
+        CHECK_EQUAL("Test", dataValue["name"].asString());
+        CHECK_EQUAL(5, dataValue["value"].asInt());
+
+        removeCookFiles();
+    }
+
+    TEST(CookMesh)
+    {
+        removeCookFiles();
+        writeCookSource("Test.mesh",
+            "{ \"vertices\" : [ "
+            "[ { \"semantic\" : \"Position\", \"data\" : [ 0, 0, 0 ] } ], "
+            "[ { \"semantic\" : \"Position\", \"data\" : [ 1, 0, 0 ] } ], "
+            "[ { \"semantic\" : \"Position\", \"data\" : [ 0, 1, 0 ] } ] ], "
+            "\"indices\" : [ 0, 1, 2 ] }");
+
+        AssetCooker::Result result = cookSource();
+        CHECK(result.errors.empty());
+        CHECK_EQUAL(1u, result.cookedCount);
+
+        std::vector<uint8_t> cooked = cookedContents("Test.mesh");
+        MemoryReadStream stream(cooked);
+        CHECK_EQUAL(MeshBinaryFormat::Signature, stream.readUnsignedInt());
+
+        removeCookFiles();
+    }
+
+    TEST(CopyOtherFiles)
+    {
+        removeCookFiles();
+        std::string json = "{ \"value\" : 5 }";
+        writeCookSource("Settings.json", json);
+
+        AssetCooker::Result result = cookSource();
+        CHECK(result.errors.empty());
+        CHECK_EQUAL(0u, result.cookedCount);
+        CHECK_EQUAL(1u, result.copiedCount);
+
+        std::vector<uint8_t> cooked = cookedContents("Settings.json");
+        CHECK(std::vector<uint8_t>(json.begin(), json.end()) == cooked);
+
+        removeCookFiles();
+    }
+
+    TEST(ReuseUnchangedFiles)
+    {
+        removeCookFiles();
+        writeCookSource("A.material", "{ \"value\" : 1 }");
+        writeCookSource("B.material", "{ \"value\" : 2 }");
+
+        AssetCooker::Result result = cookSource();
+        CHECK_EQUAL(2u, result.cookedCount);
+
+        writeCookSource("B.material", "{ \"value\" : 3 }");
+
+        {
+            FileSystem fileSystem;
+            fileSystem.addDataSource(fileSystem.workingDirectory());
+            fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+
+            FileReadStream stream = fileSystem.openFileForRead("Cooked.pack");
+            std::vector<uint8_t> data(stream.length());
+            stream.readBytes(&data[0], data.size());
+
+            FileWriteStream copy = fileSystem.openFileForWrite("Previous.pack");
+            copy.writeBytes(&data[0], data.size());
+        }
+
+        result = cookSource("Previous.pack");
+
+        CHECK(result.errors.empty());
+        CHECK_EQUAL(1u, result.cookedCount);
+        CHECK_EQUAL(1u, result.reusedCount);
+
+        std::vector<uint8_t> cooked = cookedContents("B.material");
+        DataValue dataValue;
+        DataValueBinaryFormat::load(dataValue, &cooked[0], cooked.size());
+        CHECK_EQUAL(3, dataValue["value"].asInt());
+
+        {
+            FileSystem fileSystem;
+            fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+            fileSystem.remove("Previous.pack");
+        }
+
+        removeCookFiles();
+    }
+
+    TEST(MissingReference)
+    {
+        removeCookFiles();
+        writeCookSource("A.material", "{ \"value\" : 1 }");
+        writeCookSource("Test.scene", "{ \"materials\" : [ \"A.material\", \"Missing.material\" ], \"name\" : \"Test\" }");
+
+        AssetCooker::Result result = cookSource();
+        CHECK_EQUAL(1u, result.errors.size());
+        CHECK_EQUAL(2u, result.cookedCount);
+
+        removeCookFiles();
+    }
+
+    TEST(FailedCook)
+    {
+        removeCookFiles();
+        writeCookSource("A.material", "{ \"value\" : 1 }");
+        writeCookSource("B.material", "{ \"value\" : ");
+
+        AssetCooker::Result result = cookSource();
+        CHECK_EQUAL(1u, result.errors.size());
+        CHECK_EQUAL(1u, result.cookedCount);
+
+        {
+            FileSystem fileSystem;
+            PackFile packFile(fileSystem.workingDirectory() + "Cooked.pack");
+            CHECK(packFile.contains("A.material"));
+            CHECK(!packFile.contains("B.material"));
+        }
+
+        removeCookFiles();
+    }
+}
\ No newline at end of file
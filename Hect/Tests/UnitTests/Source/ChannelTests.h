@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+SUITE(Channel)
+{
+    TEST(SendAndReceive)
+    {
+        Channel<int> channel(4);
+
+        CHECK(channel.trySend(1));
+        CHECK(channel.send(2));
+
+        int item;
+        CHECK(channel.tryReceive(item));
+        CHECK_EQUAL(1, item);
+        CHECK(channel.receive(item));
+        CHECK_EQUAL(2, item);
+        CHECK(!channel.tryReceive(item));
+    }
+
+    TEST(TrySendWhenFull)
+    {
+        Channel<int> channel(2);
+
+        int items[] = { 1, 2, 3 };
+        CHECK_EQUAL(2u, channel.trySend(items, 3));
+        CHECK(!channel.trySend(4));
+    }
+
+    TEST(ReceiveWaitsForSender)
+    {
+        Channel<int> channel;
+
+        std::thread sender([&channel]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            channel.send(7);
+        });
+
+        int item = 0;
+        CHECK(channel.receive(item));
+        CHECK_EQUAL(7, item);
+
+        sender.join();
+    }
+
+    TEST(ReceiveWithTimeout)
+    {
+        Channel<int> channel;
+
+        int items[4];
+        CHECK_EQUAL(0u, channel.receive(items, 4, TimeSpan::fromMilliseconds(5)));
+
+        channel.send(1);
+        channel.send(2);
+        CHECK_EQUAL(2u, channel.receive(items, 4, TimeSpan::fromMilliseconds(5)));
+        CHECK_EQUAL(1, items[0]);
+        CHECK_EQUAL(2, items[1]);
+    }
+
+    TEST(Close)
+    {
+        Channel<int> channel;
+        channel.send(1);
+
+        std::thread closer([&channel]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            channel.close();
+        });
+
+        // Items sent before closing are still received
+        int item;
+        CHECK(channel.receive(item));
+        CHECK_EQUAL(1, item);
+
+        // Then the receiver is woken up by the close
+        CHECK(!channel.receive(item));
+        CHECK(channel.isClosed());
+        CHECK(!channel.send(2));
+
+        closer.join();
+    }
+
+    TEST(Stress)
+    {
+        const size_t senderCount = 4;
+        const size_t itemCount = 50000;
+
+        Channel<size_t> channel(64);
+
+        std::vector<std::thread> senders;
+        for (size_t senderIndex = 0; senderIndex < senderCount; ++senderIndex)
+        {
+            senders.push_back(std::thread([&channel, itemCount]
+            {
+                for (size_t i = 0; i < itemCount; ++i)
+                {
+                    channel.send(i);
+                }
+            }));
+        }
+
+        // Close the channel once every sender is done
+        std::thread closer([&channel, &senders]
+        {
+            for (std::thread& sender : senders)
+            {
+                sender.join();
+            }
+            channel.close();
+        });
+
+        size_t receivedCount = 0;
+        size_t total = 0;
+        size_t batch[32];
+        while (!channel.isClosed() || receivedCount < senderCount * itemCount)
+        {
+            size_t count = channel.receive(batch, 32, TimeSpan::fromMilliseconds(1));
+            for (size_t i = 0; i < count; ++i)
+            {
+                total += batch[i];
+            }
+            receivedCount += count;
+        }
+
+        closer.join();
+
+        CHECK_EQUAL(senderCount * itemCount, receivedCount);
+        CHECK_EQUAL(senderCount * (itemCount * (itemCount - 1) / 2), total);
+    }
+}
\ No newline at end of file
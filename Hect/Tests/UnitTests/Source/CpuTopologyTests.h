@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+CpuTopology createTestTopology()
+{
+    // Two nodes each with two cache domains of two cores with two hardware
+    // threads each
+    CpuTopology topology;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        CpuTopology::Processor processor;
+        processor.index = i;
+        processor.core = i / 2;
+        processor.cacheDomain = i / 4;
+        processor.node = i / 8;
+        topology.addProcessor(processor);
+    }
+    return topology;
+}
+
+SUITE(CpuTopology)
+{
+    TEST(Detect)
+    {
+        CpuTopology topology = CpuTopology::detect();
+        CHECK(!topology.processors().empty());
+        CHECK(topology.coreCount() >= 1);
+        CHECK(topology.coreCount() <= topology.processors().size());
+        CHECK(topology.nodeCount() >= 1);
+    }
+
+    TEST(Counts)
+    {
+        CpuTopology topology = createTestTopology();
+        CHECK_EQUAL((size_t)16, topology.processors().size());
+        CHECK_EQUAL((size_t)8, topology.coreCount());
+        CHECK_EQUAL((size_t)4, topology.cacheDomainCount());
+        CHECK_EQUAL((size_t)2, topology.nodeCount());
+    }
+
+    TEST(WorkersOnSeparateCores)
+    {
+        CpuTopology topology = createTestTopology();
+        TaskPool taskPool(topology, 8);
+
+        // Each worker is on a core of its own
+        std::vector<unsigned> cores;
+        for (size_t i = 0; i < taskPool.threadCount(); ++i)
+        {
+            cores.push_back(taskPool.workerProcessor(i).core);
+        }
+        std::sort(cores.begin(), cores.end());
+        CHECK(std::unique(cores.begin(), cores.end()) == cores.end());
+
+        // The workers are grouped by node and cache domain
+        bool grouped = true;
+        for (size_t i = 1; i < taskPool.threadCount(); ++i)
+        {
+            const CpuTopology::Processor& previous = taskPool.workerProcessor(i - 1);
+            const CpuTopology::Processor& current = taskPool.workerProcessor(i);
+            grouped = grouped && (previous.node < current.node || (previous.node == current.node && previous.cacheDomain <= current.cacheDomain));
+        }
+        CHECK(grouped);
+
+        CHECK_THROW(taskPool.workerProcessor(8), Error);
+    }
+
+    TEST(MoreWorkersThanProcessors)
+    {
+        CpuTopology topology = createTestTopology();
+        TaskPool taskPool(topology, 20, true);
+        CHECK_EQUAL((size_t)20, taskPool.threadCount());
+
+        std::atomic<unsigned> callCount(0);
+        taskPool.parallelFor(0, 1000, 1, [&callCount](size_t begin, size_t end)
+        {
+            callCount += (unsigned)(end - begin);
+        });
+        CHECK_EQUAL(1000u, callCount.load());
+    }
+
+    TEST(DefaultTaskPool)
+    {
+        TaskPool taskPool;
+        CHECK_EQUAL(CpuTopology::detect().processors().size(), taskPool.threadCount());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+DataValue createDocumentTestValue()
+{
+    DataValue array(DataValueType::Array);
+    array.addElement(true);
+    array.addElement(5.0);
+    array.addElement("Testing");
+
+    DataValue value(DataValueType::Object);
+    value.addMember("someArray", array);
+    value.addMember("someNumber", 2.5);
+    value.addMember("someString", "Testing");
+    value.addMember("someVector", Vector3<>(1, 2, 3));
+    return value;
+}
+
+void checkDocumentTestValue(const DataDocumentValue& value)
+{
+    CHECK(value.isObject());
+    CHECK_EQUAL(4, value.size());
+
+    DataDocumentValue array = value["someArray"];
+    CHECK(array.isArray());
+    CHECK_EQUAL(3, array.size());
+    CHECK(array[0].isBool());
+    CHECK(array[0].asBool());
+    CHECK(array[1].isNumber());
+    CHECK_EQUAL(5.0, array[1].asDouble());
+    CHECK(array[2].isString());
+    CHECK_EQUAL("Testing", std::string(array[2].asString()));
+    CHECK(array[3].isNull());
+
+    CHECK_EQUAL(2.5, value["someNumber"].asDouble());
+    CHECK_EQUAL("Testing", std::string(value["someString"].asString()));
+
+    Vector3<> vector = value["someVector"].asVector3();
+    CHECK_EQUAL(1.0, vector.x);
+    CHECK_EQUAL(2.0, vector.y);
+    CHECK_EQUAL(3.0, vector.z);
+
+    CHECK(value["doesNotExist"].isNull());
+}
+
+SUITE(DataDocument)
+{
+    TEST(Empty)
+    {
+        DataDocument document;
+        CHECK(document.root().isNull());
+        CHECK_EQUAL(0, document.root().size());
+    }
+
+    TEST(BuildFromDataValue)
+    {
+        DataDocument document(createDocumentTestValue());
+        checkDocumentTestValue(document.root());
+    }
+
+    TEST(MemberNamesAreSorted)
+    {
+        DataDocument document(createDocumentTestValue());
+        DataDocumentValue root = document.root();
+
+        CHECK_EQUAL("someArray", std::string(root.memberName(0)));
+        CHECK_EQUAL("someNumber", std::string(root.memberName(1)));
+        CHECK_EQUAL("someString", std::string(root.memberName(2)));
+        CHECK_EQUAL("someVector", std::string(root.memberName(3)));
+        CHECK_EQUAL("", std::string(root.memberName(4)));
+    }
+
+    TEST(IterateElements)
+    {
+        DataDocument document(createDocumentTestValue());
+
+        size_t count = 0;
+        for (DataDocumentValue element : document.root()["someVector"])
+        {
+            CHECK_EQUAL((double)++count, element.asDouble());
+        }
+        CHECK_EQUAL(3, count);
+    }
+
+    TEST(ToDataValue)
+    {
+        DataDocument document(createDocumentTestValue());
+        DataValue value = document.root().toDataValue();
+
+        DataDocument rebuiltDocument(value);
+        checkDocumentTestValue(rebuiltDocument.root());
+    }
+
+    TEST(SaveAndLoad)
+    {
+        std::vector<uint8_t> data;
+        {
+            DataDocument document(createDocumentTestValue());
+            MemoryWriteStream stream(data);
+            document.save(stream);
+        }
+
+        DataDocument document;
+        {
+            MemoryReadStream stream(data);
+            document.load(stream);
+            CHECK(stream.endOfStream());
+        }
+
+        checkDocumentTestValue(document.root());
+    }
+
+    TEST(LoadInvalid)
+    {
+        std::vector<uint8_t> data;
+        {
+            DataDocument document(createDocumentTestValue());
+            MemoryWriteStream stream(data);
+            document.save(stream);
+        }
+
+        // Corrupt the offset of the root value
+        data[24] = 0xFF;
+        data[25] = 0xFF;
+
+        bool errorThrown = false;
+        DataDocument document;
+        try
+        {
+            MemoryReadStream stream(data);
+            document.load(stream);
+        }
+        catch (Error&)
+        {
+            errorThrown = true;
+        }
+
+        CHECK(errorThrown);
+        CHECK(document.root().isNull());
+    }
+}
\ No newline at end of file
@@ -90,6 +90,22 @@ SUITE(DataReaderWriter)
         }
     }
 
+    TEST(SimpleBinaryCompact)
+    {
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            BinaryDataWriter writer(stream, BinaryDataProfile::Compact);
+            writeSimple(writer);
+        }
+
+        {
+            MemoryReadStream stream(data);
+            BinaryDataReader reader(stream, BinaryDataProfile::Compact);
+            readSimple(reader);
+        }
+    }
+
     void writeObject(DataWriter& writer)
     {
         writer.writeString("String", "Testing 1 2 3");
@@ -163,6 +179,22 @@ SUITE(DataReaderWriter)
         }
     }
 
+    TEST(ObjectBinaryCompact)
+    {
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            BinaryDataWriter writer(stream, BinaryDataProfile::Compact);
+            writeObject(writer);
+        }
+
+        {
+            MemoryReadStream stream(data);
+            BinaryDataReader reader(stream, BinaryDataProfile::Compact);
+            readObject(reader);
+        }
+    }
+
     void writeArray(DataWriter& writer)
     {
         writer.writeString("String", "Testing 1 2 3");
@@ -239,6 +271,22 @@ SUITE(DataReaderWriter)
         }
     }
 
+    TEST(ArrayBinaryCompact)
+    {
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            BinaryDataWriter writer(stream, BinaryDataProfile::Compact);
+            writeArray(writer);
+        }
+
+        {
+            MemoryReadStream stream(data);
+            BinaryDataReader reader(stream, BinaryDataProfile::Compact);
+            readArray(reader);
+        }
+    }
+
     void writeArrayWithUnnamedObject(DataWriter& writer)
     {
         writer.beginArray("Array");
@@ -291,4 +339,126 @@ SUITE(DataReaderWriter)
             readArrayWithUnnamedObject(reader);
         }
     }
+
+    TEST(ArrayWithUnnamedObjectBinaryCompact)
+    {
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            BinaryDataWriter writer(stream, BinaryDataProfile::Compact);
+            writeArrayWithUnnamedObject(writer);
+        }
+
+        {
+            MemoryReadStream stream(data);
+            BinaryDataReader reader(stream, BinaryDataProfile::Compact);
+            readArrayWithUnnamedObject(reader);
+        }
+    }
+
+    void writeSnapshot(DataWriter& writer)
+    {
+        writer.beginArray("Entities");
+        for (int i = 0; i < 10; ++i)
+        {
+            writer.beginObject();
+            writer.writeDouble("Id", i);
+            writer.writeVector3("Position", Vector3<>(i, 0, 1.5));
+            writer.writeVector3("Direction", Vector3<>(0, 0, -1), VectorPrecision::Normalized);
+            writer.endObject();
+        }
+        writer.endArray();
+    }
+
+    TEST(BinaryCompactIsSmaller)
+    {
+        std::vector<uint8_t> standardData;
+        {
+            MemoryWriteStream stream(standardData);
+            BinaryDataWriter writer(stream);
+            writeSnapshot(writer);
+        }
+
+        std::vector<uint8_t> compactData;
+        {
+            MemoryWriteStream stream(compactData);
+            BinaryDataWriter writer(stream, BinaryDataProfile::Compact);
+            writeSnapshot(writer);
+        }
+
+        CHECK(compactData.size() * 2 < standardData.size());
+    }
+
+    TEST(BinaryCompactNumbers)
+    {
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            BinaryDataWriter writer(stream, BinaryDataProfile::Compact);
+            writer.writeDouble("Zero", 0);
+            writer.writeDouble("Negative", -300);
+            writer.writeDouble("Float", 0.5);
+            writer.writeDouble("Double", 0.1);
+        }
+
+        MemoryReadStream stream(data);
+        BinaryDataReader reader(stream, BinaryDataProfile::Compact);
+        CHECK_EQUAL(0, reader.readDouble("Zero"));
+        CHECK_EQUAL(-300, reader.readDouble("Negative"));
+        CHECK_EQUAL(0.5, reader.readDouble("Float"));
+        CHECK_EQUAL(0.1, reader.readDouble("Double"));
+    }
+
+    TEST(BinaryCompactVectorPrecision)
+    {
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            BinaryDataWriter writer(stream, BinaryDataProfile::Compact);
+            writer.writeVector3("Full", Vector3<>(0.1, 0.2, 0.3));
+            writer.writeVector3("Single", Vector3<>(0.1, 0.2, 0.3), VectorPrecision::Single);
+            writer.writeVector3("Normalized", Vector3<>(0, -1, 0.5), VectorPrecision::Normalized);
+            writer.writeVector3("Zero", Vector3<>());
+        }
+
+        // Tag and components for each vector
+        CHECK_EQUAL((1u + 24u) + (1u + 12u) + (1u + 6u) + 1u, data.size());
+
+        MemoryReadStream stream(data);
+        BinaryDataReader reader(stream, BinaryDataProfile::Compact);
+
+        Vector3<> full = reader.readVector3("Full");
+        CHECK_EQUAL(0.1, full.x);
+        CHECK_EQUAL(0.3, full.z);
+
+        Vector3<> single = reader.readVector3("Single");
+        CHECK_CLOSE(0.1, single.x, 1e-6);
+        CHECK_CLOSE(0.3, single.z, 1e-6);
+
+        Vector3<> normalized = reader.readVector3("Normalized");
+        CHECK_CLOSE(0.0, normalized.x, 1e-4);
+        CHECK_CLOSE(-1.0, normalized.y, 1e-4);
+        CHECK_CLOSE(0.5, normalized.z, 1e-4);
+
+        Vector3<> zero = reader.readVector3("Zero");
+        CHECK_EQUAL(0, zero.x);
+        CHECK_EQUAL(0, zero.y);
+        CHECK_EQUAL(0, zero.z);
+    }
+
+    TEST(BinaryHeader)
+    {
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            BinaryDataFormat::writeHeader(stream, BinaryDataProfile::Compact);
+        }
+
+        MemoryReadStream stream(data);
+        CHECK(BinaryDataFormat::readHeader(stream) == BinaryDataProfile::Compact);
+
+        data[2] = BinaryDataFormat::Version + 1;
+        MemoryReadStream invalidStream(data);
+        CHECK_THROW(BinaryDataFormat::readHeader(invalidStream), Error);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+DataValue createBinaryTestValue()
+{
+    DataValue array(DataValueType::Array);
+    array.addElement(true);
+    array.addElement(5.0);
+    array.addElement("Testing");
+    array.addElement(DataValue());
+
+    DataValue numbers(DataValueType::Array);
+    numbers.addElement(-1.0);
+    numbers.addElement(300.0);
+    numbers.addElement(-70000.0);
+    numbers.addElement(0.1);
+    numbers.addElement(-0.0);
+
+    DataValue value(DataValueType::Object);
+    value.addMember("someArray", array);
+    value.addMember("someNumber", 2.5);
+    value.addMember("someNumbers", numbers);
+    value.addMember("someString", "Testing");
+    value.addMember("someVector", Vector3<>(1, 2, 3));
+    return value;
+}
+
+std::vector<uint8_t> saveBinaryTestValue(const DataValue& value, bool keyDictionary)
+{
+    std::vector<uint8_t> data;
+    MemoryWriteStream stream(data);
+    DataValueBinaryFormat::save(value, stream, keyDictionary);
+    return data;
+}
+
+void checkBinaryTestValue(const DataValueBinaryView& value)
+{
+    CHECK(value.isObject());
+    CHECK_EQUAL(5u, value.size());
+
+    DataValueBinaryView array = value["someArray"];
+    CHECK(array.isArray());
+    CHECK_EQUAL(4u, array.size());
+    CHECK(array[0].isBool());
+    CHECK(array[0].asBool());
+    CHECK(array[1].isNumber());
+    CHECK_EQUAL(5.0, array[1].asDouble());
+    CHECK(array[2].isString());
+    CHECK_EQUAL("Testing", array[2].asString());
+    CHECK(array[3].isNull());
+    CHECK(array[4].isNull());
+
+    DataValueBinaryView numbers = value["someNumbers"];
+    CHECK_EQUAL(-1.0, numbers[0].asDouble());
+    CHECK_EQUAL(300.0, numbers[1].asDouble());
+    CHECK_EQUAL(-70000.0, numbers[2].asDouble());
+    CHECK_EQUAL(0.1, numbers[3].asDouble());
+    CHECK(1.0 / numbers[4].asDouble() < 0.0);
+
+    CHECK_EQUAL(2.5, value["someNumber"].asDouble());
+    CHECK_EQUAL("Testing", value["someString"].asString());
+
+    DataValueBinaryView vector = value["someVector"];
+    CHECK_EQUAL(1.0, vector[0].asDouble());
+    CHECK_EQUAL(2.0, vector[1].asDouble());
+    CHECK_EQUAL(3.0, vector[2].asDouble());
+
+    CHECK(value["doesNotExist"].isNull());
+}
+
+SUITE(DataValueBinaryFormat)
+{
+    TEST(ViewWithKeyDictionary)
+    {
+        std::vector<uint8_t> data = saveBinaryTestValue(createBinaryTestValue(), true);
+        checkBinaryTestValue(DataValueBinaryView(&data[0], data.size()));
+    }
+
+    TEST(ViewWithoutKeyDictionary)
+    {
+        std::vector<uint8_t> data = saveBinaryTestValue(createBinaryTestValue(), false);
+        checkBinaryTestValue(DataValueBinaryView(&data[0], data.size()));
+    }
+
+    TEST(MemberNames)
+    {
+        std::vector<uint8_t> data = saveBinaryTestValue(createBinaryTestValue(), true);
+        DataValueBinaryView root(&data[0], data.size());
+
+        CHECK_EQUAL("someArray", root.memberName(0));
+        CHECK_EQUAL("someVector", root.memberName(4));
+        CHECK_EQUAL("", root.memberName(5));
+        CHECK_EQUAL(2.5, root.memberValue(1).asDouble());
+    }
+
+    TEST(IterateElements)
+    {
+        std::vector<uint8_t> data = saveBinaryTestValue(createBinaryTestValue(), true);
+        DataValueBinaryView root(&data[0], data.size());
+
+        double sum = 0.0;
+        for (DataValueBinaryView element : root["someVector"])
+        {
+            sum += element.asDouble();
+        }
+        CHECK_EQUAL(6.0, sum);
+    }
+
+    TEST(RoundTrip)
+    {
+        DataValue value = createBinaryTestValue();
+        std::vector<uint8_t> data = saveBinaryTestValue(value, true);
+
+        DataValue loadedValue;
+        {
+            MemoryReadStream stream(data);
+            DataValueBinaryFormat::load(loadedValue, stream);
+        }
+
+        CHECK_EQUAL(value.size(), loadedValue.size());
+        CHECK_EQUAL(300.0, loadedValue["someNumbers"][1].asDouble());
+        CHECK_EQUAL("Testing", loadedValue["someString"].asString());
+        CHECK_EQUAL(3.0, loadedValue["someVector"].asVector3().z);
+    }
+
+    TEST(SmallIntegersAreOneByte)
+    {
+        DataValue value(DataValueType::Array);
+        for (int i = 0; i < 100; ++i)
+        {
+            value.addElement(i);
+        }
+
+        std::vector<uint8_t> data = saveBinaryTestValue(value, false);
+
+        // Header (6 bytes), array tag, encoded size (4 bytes), count, and one
+        // byte per element
+        CHECK_EQUAL(6u + 1u + 4u + 1u + 100u, data.size());
+    }
+
+    TEST(SkipNestedContainers)
+    {
+        DataValue value(DataValueType::Array);
+        for (int i = 0; i < 10; ++i)
+        {
+            DataValue inner(DataValueType::Object);
+            inner.addMember("index", i);
+            inner.addMember("elements", createBinaryTestValue());
+            value.addElement(inner);
+        }
+
+        std::vector<uint8_t> data = saveBinaryTestValue(value, true);
+        DataValueBinaryView root(&data[0], data.size());
+
+        CHECK_EQUAL(9, root[9]["index"].asInt());
+        CHECK_EQUAL("Testing", root[9]["elements"]["someString"].asString());
+        CHECK(root[10].isNull());
+
+        int count = 0;
+        for (DataValueBinaryView element : root)
+        {
+            CHECK_EQUAL(count++, element["index"].asInt());
+        }
+        CHECK_EQUAL(10, count);
+    }
+
+    TEST(InvalidSignature)
+    {
+        std::vector<uint8_t> data(16, 0);
+        CHECK_THROW(DataValueBinaryView(&data[0], data.size()), Error);
+    }
+
+    TEST(Truncated)
+    {
+        std::vector<uint8_t> data = saveBinaryTestValue(createBinaryTestValue(), false);
+        data.resize(data.size() / 2);
+
+        DataValue loadedValue;
+        CHECK_THROW(DataValueBinaryFormat::load(loadedValue, &data[0], data.size()), Error);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+DataValue createPathTestValue()
+{
+    DataValue transform(DataValueType::Object);
+    transform.addMember("position", Vector3<>(1, 2, 3));
+
+    DataValue entity(DataValueType::Object);
+    entity.addMember("Transform", transform);
+    entity.addMember("a/b", 1);
+    entity.addMember("c~d", 2);
+    entity.addMember("10", 3);
+
+    DataValue entities(DataValueType::Array);
+    entities.addElement(DataValue(DataValueType::Object));
+    entities.addElement(entity);
+
+    DataValue value(DataValueType::Object);
+    value.addMember("entities", entities);
+    return value;
+}
+
+SUITE(DataValuePath)
+{
+    TEST(Empty)
+    {
+        DataValuePath path("");
+        CHECK_EQUAL(0u, path.size());
+        CHECK_EQUAL("", path.toString());
+    }
+
+    TEST(Segments)
+    {
+        DataValuePath path("/entities/12/Transform");
+        CHECK_EQUAL(3u, path.size());
+        CHECK_EQUAL("entities", path.name(0));
+        CHECK(!path.isIndex(0));
+        CHECK_EQUAL("12", path.name(1));
+        CHECK(path.isIndex(1));
+        CHECK_EQUAL(12u, path.index(1));
+        CHECK_EQUAL("Transform", path.name(2));
+        CHECK(!path.isIndex(2));
+    }
+
+    TEST(LeadingZeroIsNotIndex)
+    {
+        DataValuePath path("/0/01");
+        CHECK(path.isIndex(0));
+        CHECK(!path.isIndex(1));
+    }
+
+    TEST(OverflowingIndexIsNotIndex)
+    {
+        // Wraps around to 1 if accumulated in 64 bits without a check
+        DataValuePath path("/1844674407370955161600001");
+        CHECK(!path.isIndex(0));
+        CHECK_EQUAL("1844674407370955161600001", path.name(0));
+
+        DataValue value = createPathTestValue();
+        CHECK(value.at("/entities/1844674407370955161600001/Transform").isNull());
+    }
+
+    TEST(EscapeSequences)
+    {
+        DataValuePath path("/a~1b/c~0d");
+        CHECK_EQUAL("a/b", path.name(0));
+        CHECK_EQUAL("c~d", path.name(1));
+        CHECK_EQUAL("/a~1b/c~0d", path.toString());
+    }
+
+    TEST(Invalid)
+    {
+        CHECK_THROW(DataValuePath("entities"), Error);
+        CHECK_THROW(DataValuePath("/a~2"), Error);
+    }
+
+    TEST(DataValueAt)
+    {
+        DataValue value = createPathTestValue();
+
+        Vector3<> position = value.at("/entities/1/Transform/position").asVector3();
+        CHECK_EQUAL(1.0, position.x);
+        CHECK_EQUAL(2.0, position.y);
+        CHECK_EQUAL(3.0, position.z);
+
+        CHECK_EQUAL(3.0, value.at("/entities/1/Transform/position/2").asDouble());
+        CHECK_EQUAL(1, value.at("/entities/1/a~1b").asInt());
+        CHECK_EQUAL(2, value.at("/entities/1/c~0d").asInt());
+        CHECK_EQUAL(3, value.at("/entities/1/10").asInt());
+        CHECK(value.at("").isObject());
+    }
+
+    TEST(DataValueAtMissing)
+    {
+        DataValue value = createPathTestValue();
+
+        CHECK(value.at("/entities/2/Transform").isNull());
+        CHECK(value.at("/entities/1/Missing/position").isNull());
+        CHECK(value.at("/entities/first").isNull());
+    }
+
+    TEST(DataDocumentAt)
+    {
+        DataDocument document(createPathTestValue());
+
+        CHECK_EQUAL(3.0, document.root().at("/entities/1/Transform/position/2").asDouble());
+        CHECK_EQUAL(1, document.root().at("/entities/1/a~1b").asInt());
+        CHECK(document.root().at("/entities/2/Transform").isNull());
+    }
+
+    TEST(DataValueBinaryViewAt)
+    {
+        std::vector<uint8_t> data;
+        {
+            MemoryWriteStream stream(data);
+            DataValueBinaryFormat::save(createPathTestValue(), stream);
+        }
+
+        DataValueBinaryView root(&data[0], data.size());
+        CHECK_EQUAL(3.0, root.at("/entities/1/Transform/position/2").asDouble());
+        CHECK_EQUAL(2, root.at("/entities/1/c~0d").asInt());
+        CHECK(root.at("/entities/2/Transform").isNull());
+    }
+}
\ No newline at end of file
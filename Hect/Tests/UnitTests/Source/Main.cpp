@@ -35,10 +35,17 @@ using namespace hect;
 
 const double epsilon = 0.0001;
 
+#include "ActionQueueTests.h"
 #include "AngleTests.h"
 #include "AnyTests.h"
 #include "AssetCacheTests.h"
+#include "AssetCookerTests.h"
+#include "ChannelTests.h"
+#include "CpuTopologyTests.h"
+#include "DataDocumentTests.h"
+#include "DataValueBinaryFormatTests.h"
 #include "DataValueJsonFormatTests.h"
+#include "DataValuePathTests.h"
 #include "DataReaderWriterTests.h"
 #include "DataValueTests.h"
 #include "EntityTests.h"
@@ -49,15 +56,20 @@ const double epsilon = 0.0001;
 #include "MaterialDataFormatTests.h"
 #include "Matrix4Tests.h"
 #include "MemoryStreamTests.h"
+#include "MpscQueueTests.h"
 #include "MeshDataFormatTests.h"
 #include "MeshTests.h"
 #include "MeshWriterTests.h"
 #include "MeshReaderTests.h"
 #include "NetworkTests.h"
+#include "PackFileTests.h"
 #include "PathTests.h"
 #include "PlaneTests.h"
 #include "QuaternionTests.h"
 #include "SceneTests.h"
+#include "SpscQueueTests.h"
+#include "TaskFunctionTests.h"
+#include "TaskGraphTests.h"
 #include "TaskPoolTests.h"
 #include "TimeSpanTests.h"
 #include "Vector2Tests.h"
@@ -160,4 +160,69 @@ SUITE(Mesh)
         CHECK_EQUAL(3, indexData[4]);
         CHECK_EQUAL(0, indexData[5]);
     }
+
+    TEST(SetVertexDataByMove)
+    {
+        VertexAttribute::Array attributes;
+        attributes.push_back(VertexAttribute(VertexAttributeSemantic::Position, VertexAttributeType::Float, 3));
+
+        VertexLayout vertexLayout(attributes);
+
+        Mesh mesh("Test", vertexLayout, PrimitiveType::Triangles, IndexType::UnsignedByte);
+
+        std::vector<uint8_t> vertexData(sizeof(float) * 9, 0);
+        const uint8_t* data = &vertexData[0];
+
+        mesh.setVertexData(std::move(vertexData));
+
+        CHECK_EQUAL(3, mesh.vertexCount());
+        CHECK_EQUAL(data, &mesh.vertexData()[0]);
+    }
+
+    TEST(MoveConstructor)
+    {
+        VertexAttribute::Array attributes;
+        attributes.push_back(VertexAttribute(VertexAttributeSemantic::Position, VertexAttributeType::Float, 3));
+
+        VertexLayout vertexLayout(attributes);
+
+        Mesh mesh("Test", vertexLayout, PrimitiveType::Triangles, IndexType::UnsignedByte);
+        mesh.setVertexData(std::vector<uint8_t>(sizeof(float) * 9, 0));
+        mesh.setIndexData(std::vector<uint8_t>(3, 0));
+
+        const uint8_t* vertexData = &mesh.vertexData()[0];
+        const uint8_t* indexData = &mesh.indexData()[0];
+
+        Mesh movedMesh(std::move(mesh));
+
+        CHECK_EQUAL("Test", movedMesh.name());
+        CHECK_EQUAL(3, movedMesh.vertexCount());
+        CHECK_EQUAL(3, movedMesh.indexCount());
+        CHECK_EQUAL(vertexData, &movedMesh.vertexData()[0]);
+        CHECK_EQUAL(indexData, &movedMesh.indexData()[0]);
+        CHECK_EQUAL(0, mesh.vertexCount());
+        CHECK_EQUAL(0, mesh.indexCount());
+    }
+
+    TEST(MoveAssignment)
+    {
+        VertexAttribute::Array attributes;
+        attributes.push_back(VertexAttribute(VertexAttributeSemantic::Position, VertexAttributeType::Float, 3));
+
+        VertexLayout vertexLayout(attributes);
+
+        Mesh mesh("Test", vertexLayout, PrimitiveType::Triangles, IndexType::UnsignedByte);
+        mesh.setVertexData(std::vector<uint8_t>(sizeof(float) * 9, 0));
+
+        const uint8_t* vertexData = &mesh.vertexData()[0];
+
+        Mesh movedMesh;
+        movedMesh = std::move(mesh);
+
+        CHECK_EQUAL("Test", movedMesh.name());
+        CHECK(IndexType::UnsignedByte == movedMesh.indexType());
+        CHECK_EQUAL(3, movedMesh.vertexCount());
+        CHECK_EQUAL(vertexData, &movedMesh.vertexData()[0]);
+        CHECK_EQUAL(0, mesh.vertexCount());
+    }
 }
\ No newline at end of file
@@ -164,4 +164,46 @@ SUITE(MeshWriter)
         CHECK_EQUAL(2, indexData[2]);
         CHECK_EQUAL(0, indexData[3]);
     }
+
+    TEST(AddVerticesInParallel)
+    {
+        TaskPool taskPool(4);
+
+        Mesh mesh("Test", createVetexLayout(), PrimitiveType::Points, IndexType::UnsignedInt);
+        MeshWriter meshWriter(mesh);
+        meshWriter.addVertex();
+        meshWriter.writeAttributeData(VertexAttributeSemantic::Position, Vector3<float>(-1.0f, 0.0f, 0.0f));
+
+        const size_t vertexCount = 10000;
+        size_t firstVertex = meshWriter.addVertices(taskPool, vertexCount, [](MeshWriter& writer, size_t index)
+        {
+            writer.writeAttributeData(VertexAttributeSemantic::Position, Vector3<float>((float)index, 1.0f, 2.0f));
+            writer.writeAttributeData(VertexAttributeSemantic::Normal, Vector3<float>(0.0f, 0.0f, 1.0f));
+        });
+        meshWriter.addIndices(taskPool, vertexCount + 1, [](size_t index)
+        {
+            return (uint64_t)index;
+        });
+
+        CHECK_EQUAL(1, firstVertex);
+        CHECK_EQUAL(vertexCount + 1, mesh.vertexCount());
+        CHECK_EQUAL(vertexCount + 1, mesh.indexCount());
+
+        const float* vertexData = (const float*)&mesh.vertexData()[0];
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            CHECK_EQUAL((float)i, vertexData[(i + 1) * 6]);
+            CHECK_EQUAL(1.0f, vertexData[(i + 1) * 6 + 5]);
+        }
+
+        const uint32_t* indexData = (const uint32_t*)&mesh.indexData()[0];
+        for (size_t i = 0; i <= vertexCount; ++i)
+        {
+            CHECK_EQUAL(i, indexData[i]);
+        }
+
+        CHECK_EQUAL(-1.0f, mesh.boundingBox().minimum().x);
+        CHECK_EQUAL((float)(vertexCount - 1), mesh.boundingBox().maximum().x);
+        CHECK_EQUAL(2.0f, mesh.boundingBox().maximum().z);
+    }
 }
\ No newline at end of file
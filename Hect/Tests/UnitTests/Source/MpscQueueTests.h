@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+SUITE(MpscQueue)
+{
+    TEST(PushAndPop)
+    {
+        MpscQueue<int> queue(4);
+        CHECK_EQUAL(4u, queue.capacity());
+        CHECK(queue.empty());
+
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.push(i));
+        }
+        CHECK(!queue.push(4));
+
+        int item;
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.pop(item));
+            CHECK_EQUAL(i, item);
+        }
+        CHECK(!queue.pop(item));
+        CHECK(queue.empty());
+
+        // The slots are reused on the next lap
+        CHECK(queue.push(5));
+        CHECK(queue.pop(item));
+        CHECK_EQUAL(5, item);
+    }
+
+    TEST(CapacityOfOne)
+    {
+        MpscQueue<int> queue(1);
+        CHECK_EQUAL(2u, queue.capacity());
+
+        CHECK(queue.push(1));
+        CHECK(queue.push(2));
+        CHECK(!queue.push(3));
+
+        int item;
+        CHECK(queue.pop(item));
+        CHECK_EQUAL(1, item);
+        CHECK(queue.pop(item));
+        CHECK_EQUAL(2, item);
+        CHECK(!queue.pop(item));
+    }
+
+    TEST(BatchPushAndPop)
+    {
+        MpscQueue<std::string> queue(4);
+
+        std::string items[] = { "a", "b", "c", "d", "e" };
+        CHECK_EQUAL(4u, queue.push(items, 5));
+
+        // Only the pushed items are moved from
+        CHECK_EQUAL("e", items[4]);
+
+        std::string poppedItems[5];
+        CHECK_EQUAL(4u, queue.pop(poppedItems, 5));
+        CHECK_EQUAL("a", poppedItems[0]);
+        CHECK_EQUAL("d", poppedItems[3]);
+    }
+
+    TEST(Stress)
+    {
+        const size_t producerCount = 4;
+        const size_t itemCount = 50000;
+
+        MpscQueue<size_t> queue(128);
+
+        std::vector<std::thread> producers;
+        for (size_t producerIndex = 0; producerIndex < producerCount; ++producerIndex)
+        {
+            producers.push_back(std::thread([&queue, producerIndex, itemCount]
+            {
+                // Encode the producer in the item so the order can be checked
+                for (size_t i = 0; i < itemCount; ++i)
+                {
+                    while (!queue.push(i * producerCount + producerIndex))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }));
+        }
+
+        // The items of each producer are popped once in the order pushed
+        bool inOrder = true;
+        std::vector<size_t> nextItems(producerCount, 0);
+        size_t poppedCount = 0;
+        size_t batch[16];
+        while (poppedCount < producerCount * itemCount)
+        {
+            size_t count = queue.pop(batch, 16);
+            if (count == 0)
+            {
+                std::this_thread::yield();
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t producerIndex = batch[i] % producerCount;
+                inOrder = inOrder && batch[i] / producerCount == nextItems[producerIndex];
+                ++nextItems[producerIndex];
+            }
+            poppedCount += count;
+        }
+
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+
+        CHECK(inOrder);
+        CHECK(queue.empty());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+void writePack(const PackFileWriter& writer, const Path& path)
+{
+    FileSystem fileSystem;
+    fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+
+    FileWriteStream stream = fileSystem.openFileForWrite(path);
+    writer.save(stream);
+}
+
+void removePack(const Path& path)
+{
+    FileSystem fileSystem;
+    fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+    fileSystem.remove(path);
+}
+
+// Overwrites a 64-bit value in a pack to simulate corruption
+void corruptPack(const Path& path, size_t offset, uint64_t value)
+{
+    FileSystem fileSystem;
+    fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+    fileSystem.addDataSource(fileSystem.workingDirectory());
+
+    std::vector<uint8_t> data;
+    {
+        FileReadStream stream = fileSystem.openFileForRead(path);
+        data.resize(stream.length());
+        stream.readBytes(&data[0], data.size());
+    }
+
+    std::memcpy(&data[offset], &value, sizeof(value));
+
+    FileWriteStream stream = fileSystem.openFileForWrite(path);
+    stream.writeBytes(&data[0], data.size());
+}
+
+std::vector<uint8_t> readFile(FileSystem& fileSystem, const Path& path)
+{
+    FileReadStream stream = fileSystem.openFileForRead(path);
+
+    std::vector<uint8_t> data(stream.length());
+    if (!data.empty())
+    {
+        stream.readBytes(&data[0], data.size());
+    }
+    CHECK(stream.endOfStream());
+
+    return data;
+}
+
+SUITE(PackFile)
+{
+    TEST(ReadFiles)
+    {
+        std::vector<uint8_t> a(5, 'a');
+        std::vector<uint8_t> b;
+        for (unsigned i = 0; i < 200; ++i)
+        {
+            b.push_back((uint8_t)i);
+        }
+
+        PackFileWriter writer;
+        writer.addFile("A.txt", a);
+        writer.addFile("Directory/B.bin", b);
+        writer.addFile("Empty.txt", std::vector<uint8_t>());
+        writePack(writer, "Test.pack");
+
+        {
+            FileSystem fileSystem;
+            fileSystem.addDataSource(fileSystem.workingDirectory() + "Test.pack");
+
+            CHECK(fileSystem.exists("A.txt"));
+            CHECK(fileSystem.exists("Directory/B.bin"));
+            CHECK(fileSystem.exists("Empty.txt"));
+            CHECK(!fileSystem.exists("B.bin"));
+
+            CHECK(a == readFile(fileSystem, "A.txt"));
+            CHECK(b == readFile(fileSystem, "Directory/B.bin"));
+            CHECK(readFile(fileSystem, "Empty.txt").empty());
+        }
+
+        removePack("Test.pack");
+    }
+
+    TEST(ContentsAreAligned)
+    {
+        PackFileWriter writer;
+        writer.addFile("A.txt", std::vector<uint8_t>(3, 'a'));
+        writer.addFile("B.txt", std::vector<uint8_t>(100, 'b'));
+        writer.addFile("C.txt", std::vector<uint8_t>(1, 'c'));
+        writePack(writer, "Test.pack");
+
+        {
+            FileSystem fileSystem;
+            fileSystem.addDataSource(fileSystem.workingDirectory() + "Test.pack");
+
+            const char* paths[] = { "A.txt", "B.txt", "C.txt" };
+            const char firstBytes[] = { 'a', 'b', 'c' };
+            for (unsigned i = 0; i < 3; ++i)
+            {
+                FileReadStream stream = fileSystem.openFileForRead(paths[i]);
+                CHECK(stream.contents() != nullptr);
+                CHECK_EQUAL(0u, (size_t)stream.contents() % 64);
+                CHECK_EQUAL(firstBytes[i], (char)stream.contents()[0]);
+            }
+        }
+
+        removePack("Test.pack");
+    }
+
+    TEST(ReadCompressedFile)
+    {
+        std::vector<uint8_t> data(10000, 'a');
+
+        PackFileWriter writer;
+        writer.addFile("A.txt", data, true);
+        writePack(writer, "Test.pack");
+
+        {
+            FileSystem fileSystem;
+            Path packPath = fileSystem.workingDirectory() + "Test.pack";
+            fileSystem.addDataSource(packPath);
+
+            PackFile packFile(packPath);
+            CHECK_EQUAL(1u, packFile.fileCount());
+
+            CHECK(data == readFile(fileSystem, "A.txt"));
+
+            FileReadStream stream = fileSystem.openFileForRead("A.txt");
+            stream.seek(9998);
+            CHECK_EQUAL(9998u, stream.position());
+            CHECK_EQUAL('a', (char)stream.readUnsignedByte());
+        }
+
+        removePack("Test.pack");
+    }
+
+    TEST(AddFileTwice)
+    {
+        PackFileWriter writer;
+        writer.addFile("A.txt", std::vector<uint8_t>(1, 'a'));
+
+        bool errorThrown = false;
+        try
+        {
+            writer.addFile("A.txt", std::vector<uint8_t>(1, 'a'));
+        }
+        catch (Error&)
+        {
+            errorThrown = true;
+        }
+        CHECK(errorThrown);
+    }
+
+    TEST(InvalidPack)
+    {
+        {
+            FileSystem fileSystem;
+            fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+
+            FileWriteStream stream = fileSystem.openFileForWrite("Test.pack");
+            stream.writeString("This is not a pack but it is long enough to have a header......");
+        }
+
+        {
+            FileSystem fileSystem;
+
+            bool errorThrown = false;
+            try
+            {
+                fileSystem.addDataSource(fileSystem.workingDirectory() + "Test.pack");
+            }
+            catch (Error&)
+            {
+                errorThrown = true;
+            }
+            CHECK(errorThrown);
+        }
+
+        removePack("Test.pack");
+    }
+
+    TEST(CorruptTableOffset)
+    {
+        PackFileWriter writer;
+        writer.addFile("A.txt", std::vector<uint8_t>(5, 'a'));
+        writePack(writer, "Test.pack");
+
+        // An offset which wraps around to the start of the pack when the
+        // size of the table is added
+        corruptPack("Test.pack", 16, (uint64_t)0 - 48);
+
+        {
+            FileSystem fileSystem;
+            CHECK_THROW(PackFile(fileSystem.workingDirectory() + "Test.pack"), Error);
+        }
+
+        removePack("Test.pack");
+    }
+
+    TEST(CorruptEntryOffset)
+    {
+        PackFileWriter writer;
+        writer.addFile("A.txt", std::vector<uint8_t>(5, 'a'));
+        writePack(writer, "Test.pack");
+
+        // The first entry follows the aligned contents of the only file; an
+        // offset which wraps around when the stored size is added
+        corruptPack("Test.pack", 128 + 8, (uint64_t)0 - 4);
+
+        {
+            FileSystem fileSystem;
+            PackFile packFile(fileSystem.workingDirectory() + "Test.pack");
+
+            std::vector<uint8_t> buffer;
+            size_t size = 0;
+            CHECK_THROW(packFile.fileContents("A.txt", buffer, size), Error);
+        }
+
+        removePack("Test.pack");
+    }
+
+    TEST(HashPath)
+    {
+        CHECK(PackFile::hashPath("A.txt") == PackFile::hashPath("A.txt"));
+        CHECK(PackFile::hashPath("A.txt") != PackFile::hashPath("B.txt"));
+    }
+}
\ No newline at end of file
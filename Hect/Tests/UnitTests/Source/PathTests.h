@@ -21,8 +21,22 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 ///////////////////////////////////////////////////////////////////////////////
+// Constructed during static initialization (possibly before the statics in
+// the translation unit defining Path)
+const Path staticPath("Static/Path.txt");
+const Path staticEmptyPath;
+
 SUITE(Path)
 {
+    TEST(StaticInitialization)
+    {
+        CHECK_EQUAL("Static/Path.txt", staticPath.toString());
+        CHECK_EQUAL("txt", staticPath.extension());
+        CHECK(staticPath == Path("Static/Path.txt"));
+        CHECK(staticEmptyPath == Path());
+        CHECK(staticEmptyPath + staticPath == staticPath);
+    }
+
     TEST(DefaultConstructor)
     {
         Path path;
@@ -126,4 +140,76 @@ SUITE(Path)
 
         CHECK_EQUAL("Data/Internal/Fail.log", ss.str());
     }
+
+    TEST(Equality)
+    {
+        CHECK(Path("Data/Fail.log") == Path("/Data/Fail.log/"));
+        CHECK(Path("Data/Fail.log") != Path("Data/Pass.log"));
+        CHECK(!(Path("Data") != Path("Data")));
+    }
+
+    TEST(Ordering)
+    {
+        CHECK(Path("Data/A.log") < Path("Data/B.log"));
+        CHECK(!(Path("Data/B.log") < Path("Data/A.log")));
+        CHECK(!(Path("Data/A.log") < Path("Data/A.log")));
+    }
+
+    TEST(Hash)
+    {
+        CHECK_EQUAL(hashString("Data/Fail.log"), Path("/Data/Fail.log/").hash());
+        CHECK_EQUAL((Path("Data") + "Fail.log").hash(), Path("Data/Fail.log").hash());
+        CHECK_EQUAL(emptyHash, Path().hash());
+        CHECK_EQUAL(emptyHash, Path("/").hash());
+    }
+
+    TEST(SharedStorage)
+    {
+        Path a("Data/Fail.log");
+        Path b(std::string("Data/Fail.log"));
+        Path c = Path("Data") + "Fail.log";
+
+        CHECK(&a.toString() == &b.toString());
+        CHECK(&a.toString() == &c.toString());
+    }
+
+    TEST(UnorderedMapKey)
+    {
+        std::unordered_map<Path, int> values;
+        values["Data/A.log"] = 1;
+        values["Data/B.log"] = 2;
+
+        CHECK_EQUAL(1, values[Path("/Data/A.log")]);
+        CHECK_EQUAL(2, values[Path("Data") + "B.log"]);
+        CHECK_EQUAL(2u, values.size());
+    }
+
+    TEST(ConcurrentConstruction)
+    {
+        const size_t threadCount = 4;
+        std::vector<const std::string*> strings(threadCount, nullptr);
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            threads.push_back(std::thread([&strings, i]
+            {
+                for (unsigned j = 0; j < 100; ++j)
+                {
+                    Path(format("Data/Concurrent%d.log", j));
+                }
+                strings[i] = &Path("Data/Concurrent50.log").toString();
+            }));
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            CHECK(strings[0] == strings[i]);
+        }
+    }
 }
\ No newline at end of file
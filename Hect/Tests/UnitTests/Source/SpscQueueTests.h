@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+SUITE(SpscQueue)
+{
+    TEST(PushAndPop)
+    {
+        SpscQueue<int> queue(4);
+        CHECK_EQUAL(4u, queue.capacity());
+        CHECK(queue.empty());
+
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.push(i));
+        }
+        CHECK(!queue.push(4));
+
+        int item;
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.pop(item));
+            CHECK_EQUAL(i, item);
+        }
+        CHECK(!queue.pop(item));
+        CHECK(queue.empty());
+    }
+
+    TEST(CapacityRoundedUp)
+    {
+        SpscQueue<int> queue(5);
+        CHECK_EQUAL(8u, queue.capacity());
+    }
+
+    TEST(BatchPushAndPop)
+    {
+        SpscQueue<std::string> queue(4);
+
+        std::string items[] = { "a", "b", "c", "d", "e", "f" };
+        CHECK_EQUAL(4u, queue.push(items, 6));
+
+        // Only the pushed items are moved from
+        CHECK_EQUAL("e", items[4]);
+
+        std::string poppedItems[6];
+        CHECK_EQUAL(3u, queue.pop(poppedItems, 3));
+        CHECK_EQUAL("a", poppedItems[0]);
+        CHECK_EQUAL("c", poppedItems[2]);
+
+        CHECK_EQUAL(2u, queue.push(&items[4], 2));
+        CHECK_EQUAL(3u, queue.pop(poppedItems, 6));
+        CHECK_EQUAL("d", poppedItems[0]);
+        CHECK_EQUAL("e", poppedItems[1]);
+        CHECK_EQUAL("f", poppedItems[2]);
+    }
+
+    TEST(Stress)
+    {
+        const size_t itemCount = 200000;
+
+        SpscQueue<size_t> queue(64);
+
+        std::thread producer([&queue, itemCount]
+        {
+            size_t batch[8];
+            size_t next = 0;
+            while (next < itemCount)
+            {
+                // Alternate between single and batch pushes
+                size_t pushedCount;
+                if (next % 2 == 0)
+                {
+                    pushedCount = queue.push(next) ? 1 : 0;
+                }
+                else
+                {
+                    size_t count = std::min<size_t>(8, itemCount - next);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        batch[i] = next + i;
+                    }
+                    pushedCount = queue.push(batch, count);
+                }
+
+                if (pushedCount == 0)
+                {
+                    std::this_thread::yield();
+                }
+                next += pushedCount;
+            }
+        });
+
+        // Every item is popped once in order
+        bool inOrder = true;
+        size_t expected = 0;
+        size_t batch[16];
+        while (expected < itemCount)
+        {
+            size_t count = queue.pop(batch, 16);
+            if (count == 0)
+            {
+                std::this_thread::yield();
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                inOrder = inOrder && batch[i] == expected;
+                ++expected;
+            }
+        }
+
+        producer.join();
+
+        CHECK(inOrder);
+        CHECK(queue.empty());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+int taskFunctionCallCount = 0;
+
+void countTaskFunctionCall()
+{
+    ++taskFunctionCallCount;
+}
+
+struct MoveOnlyFunction
+{
+    MoveOnlyFunction(int* target, int value) :
+        target(target),
+        value(new int(value))
+    {
+    }
+
+    MoveOnlyFunction(MoveOnlyFunction&& function) :
+        target(function.target),
+        value(std::move(function.value))
+    {
+    }
+
+    void operator()()
+    {
+        *target = *value;
+    }
+
+    int* target;
+    std::unique_ptr<int> value;
+
+private:
+    MoveOnlyFunction(const MoveOnlyFunction&);
+};
+
+SUITE(TaskFunction)
+{
+    TEST(Empty)
+    {
+        TaskFunction function;
+        CHECK(function.isEmpty());
+        CHECK_THROW(function(), Error);
+    }
+
+    TEST(Lambda)
+    {
+        int value = 0;
+        TaskFunction function([&value]
+        {
+            value = 5;
+        });
+
+        CHECK(!function.isEmpty());
+        function();
+        CHECK_EQUAL(5, value);
+    }
+
+    TEST(FunctionPointer)
+    {
+        taskFunctionCallCount = 0;
+
+        TaskFunction function(countTaskFunctionCall);
+        CHECK(!function.isEmpty());
+        function();
+        CHECK_EQUAL(1, taskFunctionCallCount);
+    }
+
+    TEST(LargeCapture)
+    {
+        // Too large to be stored inline
+        double values[32];
+        for (unsigned i = 0; i < 32; ++i)
+        {
+            values[i] = i;
+        }
+
+        double total = 0;
+        TaskFunction function([values, &total]
+        {
+            for (unsigned i = 0; i < 32; ++i)
+            {
+                total += values[i];
+            }
+        });
+
+        TaskFunction movedFunction(std::move(function));
+        CHECK(function.isEmpty());
+
+        movedFunction();
+        CHECK_EQUAL(496.0, total);
+    }
+
+    TEST(MoveOnlyCapture)
+    {
+        int value = 0;
+        TaskFunction function(MoveOnlyFunction(&value, 7));
+
+        TaskFunction movedFunction;
+        movedFunction = std::move(function);
+        CHECK(function.isEmpty());
+
+        movedFunction();
+        CHECK_EQUAL(7, value);
+    }
+
+    TEST(CapturesAreDestroyed)
+    {
+        std::shared_ptr<int> pointer(new int(1));
+        {
+            TaskFunction function([pointer] { });
+            CHECK_EQUAL(2, pointer.use_count());
+
+            function = TaskFunction();
+            CHECK_EQUAL(1, pointer.use_count());
+
+            function = TaskFunction([pointer] { });
+            CHECK_EQUAL(2, pointer.use_count());
+        }
+        CHECK_EQUAL(1, pointer.use_count());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+SUITE(TaskGraph)
+{
+    TEST(Dependencies)
+    {
+        TaskPool taskPool(4);
+
+        std::vector<int> values(4, 0);
+
+        // Build a diamond: 0 -> (1, 2) -> 3
+        TaskGraph graph;
+        size_t first = graph.addTask([&values] { values[0] = 1; });
+        size_t left = graph.addTask([&values] { values[1] = values[0] + 1; });
+        size_t right = graph.addTask([&values] { values[2] = values[0] + 2; });
+        size_t last = graph.addTask([&values] { values[3] = values[1] + values[2]; });
+        graph.addDependency(first, left);
+        graph.addDependency(first, right);
+        graph.addDependency(left, last);
+        graph.addDependency(right, last);
+
+        graph.submit(taskPool);
+        graph.wait();
+
+        CHECK(graph.isDone());
+        CHECK_EQUAL(5, values[3]);
+    }
+
+    TEST(Resubmit)
+    {
+        for (unsigned threadCount = 0; threadCount < 4; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            std::atomic<unsigned> count(0);
+            TaskGraph graph;
+            size_t previous = graph.addTask([&count] { ++count; });
+            for (unsigned i = 0; i < 15; ++i)
+            {
+                size_t task = graph.addTask([&count] { ++count; });
+                graph.addDependency(previous, task);
+                previous = task;
+            }
+
+            for (unsigned frame = 0; frame < 100; ++frame)
+            {
+                graph.submit(taskPool);
+                graph.wait();
+            }
+
+            CHECK_EQUAL(16u * 100u, (unsigned)count);
+        }
+    }
+
+    TEST(SubmitWhileRunning)
+    {
+        TaskPool taskPool(1);
+
+        std::atomic<bool> release(false);
+        TaskGraph graph;
+        graph.addTask([&release]
+        {
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        });
+
+        graph.submit(taskPool);
+        CHECK_THROW(graph.submit(taskPool), Error);
+
+        release = true;
+        graph.wait();
+    }
+
+    TEST(Errors)
+    {
+        TaskPool taskPool(2);
+
+        TaskGraph graph;
+        graph.addTask([] { throw Error("Task error"); });
+
+        graph.submit(taskPool);
+        CHECK_THROW(graph.wait(), Error);
+        CHECK_THROW(graph.addDependency(0, 1), Error);
+    }
+}
\ No newline at end of file
@@ -149,4 +149,743 @@ SUITE(TaskPool)
     {
         TEST_TASKS_WITH_ERRORS(longTask);
     }
+
+    TEST(TasksEnqueuedFromTasks)
+    {
+        TaskPool taskPool(4);
+
+        std::atomic<unsigned> count(0);
+        std::vector<Task> outerTasks;
+        std::vector<Task> innerTasks[8];
+
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            std::vector<Task>* thisInnerTasks = &innerTasks[i];
+            outerTasks.push_back(taskPool.enqueue([&taskPool, &count, thisInnerTasks]
+            {
+                for (unsigned j = 0; j < 64; ++j)
+                {
+                    thisInnerTasks->push_back(taskPool.enqueue([&count]
+                    {
+                        ++count;
+                    }));
+                }
+            }));
+        }
+
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            outerTasks[i].wait();
+            for (Task& task : innerTasks[i])
+            {
+                task.wait();
+            }
+        }
+
+        CHECK_EQUAL(8u * 64u, (unsigned)count);
+    }
+
+    TEST(ManyTinyTasks)
+    {
+        const unsigned taskCount = 1000000;
+
+        TaskPool taskPool(16);
+
+        std::atomic<unsigned> count(0);
+        std::vector<Task> tasks;
+        tasks.reserve(taskCount);
+
+        for (unsigned i = 0; i < taskCount; ++i)
+        {
+            tasks.push_back(taskPool.enqueue([&count]
+            {
+                ++count;
+            }));
+        }
+
+        for (Task& task : tasks)
+        {
+            task.wait();
+        }
+
+        CHECK_EQUAL(taskCount, (unsigned)count);
+    }
+
+    TEST(EnqueueWithPredecessors)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            std::atomic<unsigned> count(0);
+            std::vector<Task> predecessors;
+            for (unsigned i = 0; i < 16; ++i)
+            {
+                predecessors.push_back(taskPool.enqueue([&count]
+                {
+                    longTask();
+                    ++count;
+                }));
+            }
+
+            unsigned countSeen = 0;
+            Task task = taskPool.enqueue([&count, &countSeen]
+            {
+                countSeen = count;
+            }, predecessors);
+
+            task.wait();
+            CHECK_EQUAL(16u, countSeen);
+        }
+    }
+
+    TEST(Then)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            std::vector<int> order;
+            Task task = taskPool.enqueue([&order]
+            {
+                shortTask();
+                order.push_back(1);
+            }).then([&order]
+            {
+                order.push_back(2);
+            }).then([&order]
+            {
+                order.push_back(3);
+            });
+
+            task.wait();
+            CHECK_EQUAL(3u, order.size());
+            CHECK_EQUAL(1, order[0]);
+            CHECK_EQUAL(2, order[1]);
+            CHECK_EQUAL(3, order[2]);
+        }
+    }
+
+    TEST(ThenAfterDone)
+    {
+        TaskPool taskPool(2);
+
+        Task task = taskPool.enqueue(emptyTask);
+        task.wait();
+
+        bool continued = false;
+        task.then([&continued]
+        {
+            continued = true;
+        }).wait();
+        CHECK(continued);
+    }
+
+    TEST(WhenAll)
+    {
+        TaskPool taskPool(4);
+
+        std::atomic<unsigned> count(0);
+        std::vector<Task> tasks;
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            tasks.push_back(taskPool.enqueue([&count]
+            {
+                shortTask();
+                ++count;
+            }));
+        }
+
+        taskPool.whenAll(tasks).wait();
+        CHECK_EQUAL(8u, (unsigned)count);
+
+        // An empty set of tasks is done immediately
+        CHECK(taskPool.whenAll(std::vector<Task>()).isDone());
+    }
+
+    TEST(WhenAny)
+    {
+        TaskPool taskPool(2);
+
+        std::atomic<bool> release(false);
+        std::vector<Task> tasks;
+        tasks.push_back(taskPool.enqueue([&release]
+        {
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        }));
+        tasks.push_back(taskPool.enqueue(emptyTask));
+
+        taskPool.whenAny(tasks).wait();
+        CHECK(tasks[1].isDone());
+
+        release = true;
+        tasks[0].wait();
+    }
+
+    TEST(WaitFromWorkerThread)
+    {
+        // With a single worker thread the inner task can only execute if
+        // the waiting task helps
+        TaskPool taskPool(1);
+
+        bool innerDone = false;
+        Task task = taskPool.enqueue([&taskPool, &innerDone]
+        {
+            Task inner = taskPool.enqueue([&innerDone]
+            {
+                longTask();
+                innerDone = true;
+            });
+            inner.wait();
+        });
+
+        task.wait();
+        CHECK(innerDone);
+    }
+
+    TEST(RecursiveWaits)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            std::function<unsigned(unsigned)> fibonacci;
+            fibonacci = [&taskPool, &fibonacci](unsigned n) -> unsigned
+            {
+                if (n < 2)
+                {
+                    return n;
+                }
+
+                unsigned a = 0;
+                Task task = taskPool.enqueue([&a, &fibonacci, n]
+                {
+                    a = fibonacci(n - 1);
+                });
+                unsigned b = fibonacci(n - 2);
+                task.wait();
+                return a + b;
+            };
+
+            CHECK_EQUAL(610u, fibonacci(15));
+        }
+    }
+
+    TEST(WaitFromManyThreads)
+    {
+        TaskPool taskPool(2);
+
+        Task task = taskPool.enqueue([]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        });
+
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            threads.push_back(std::thread([task]() mutable
+            {
+                task.wait();
+            }));
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        CHECK(task.isDone());
+    }
+
+    TEST(HigherPriorityTasksFirst)
+    {
+        TaskPool taskPool(1);
+
+        // Keep the only worker busy while the tasks are enqueued
+        std::atomic<bool> release(false);
+        Task gate = taskPool.enqueue([&release]
+        {
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        });
+
+        std::vector<TaskPriority> order;
+        std::vector<Task> tasks;
+        TaskPriority priorities[] = { TaskPriority::Low, TaskPriority::Normal, TaskPriority::High, TaskPriority::Critical };
+        for (TaskPriority priority : priorities)
+        {
+            for (unsigned i = 0; i < 3; ++i)
+            {
+                tasks.push_back(taskPool.enqueue([&order, priority]
+                {
+                    order.push_back(priority);
+                }, priority));
+            }
+        }
+
+        release = true;
+        taskPool.whenAll(tasks).wait();
+
+        CHECK_EQUAL(12u, order.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            CHECK((size_t)order[i] == i / 3);
+        }
+    }
+
+    TEST(LowPriorityTasksDoNotStarve)
+    {
+        TaskPool taskPool(1);
+
+        std::atomic<bool> release(false);
+        Task gate = taskPool.enqueue([&release]
+        {
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        });
+
+        std::atomic<unsigned> count(0);
+        unsigned countWhenLowExecuted = 0;
+        Task low = taskPool.enqueue([&count, &countWhenLowExecuted]
+        {
+            countWhenLowExecuted = count;
+        }, TaskPriority::Low);
+
+        std::vector<Task> tasks;
+        for (unsigned i = 0; i < 200; ++i)
+        {
+            tasks.push_back(taskPool.enqueue([&count]
+            {
+                ++count;
+            }, TaskPriority::High));
+        }
+
+        release = true;
+        taskPool.whenAll(tasks).wait();
+        low.wait();
+
+        CHECK(countWhenLowExecuted < 100);
+    }
+
+    TEST(FinishFrame)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            std::atomic<unsigned> count(0);
+            for (unsigned i = 0; i < 100; ++i)
+            {
+                taskPool.enqueue([&count]
+                {
+                    shortTask();
+                    ++count;
+                }, TaskPriority::Critical);
+            }
+
+            TaskGraph graph;
+            graph.addTask([&count] { ++count; });
+            graph.submit(taskPool, TaskPriority::Critical);
+
+            taskPool.finishFrame();
+            CHECK_EQUAL(101u, (unsigned)count);
+        }
+    }
+
+    TEST(ShouldYield)
+    {
+        TaskPool taskPool(1);
+
+        CHECK(!taskPool.shouldYield());
+
+        std::atomic<bool> started(false);
+        bool yielded = false;
+        Task background = taskPool.enqueue([&taskPool, &started, &yielded]
+        {
+            started = true;
+            for (unsigned i = 0; i < 100000 && !yielded; ++i)
+            {
+                yielded = taskPool.shouldYield();
+                std::this_thread::yield();
+            }
+        }, TaskPriority::Low);
+
+        while (!started)
+        {
+            std::this_thread::yield();
+        }
+
+        Task urgent = taskPool.enqueue(emptyTask, TaskPriority::High);
+        background.wait();
+        urgent.wait();
+
+        CHECK(yielded);
+    }
+
+    TEST(Statistics)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+            taskPool.setTimingEnabled(true);
+
+            const unsigned taskCount = 64;
+            std::vector<Task> tasks;
+            for (unsigned i = 0; i < taskCount; ++i)
+            {
+                tasks.push_back(taskPool.enqueue(shortTask));
+            }
+
+            for (Task& task : tasks)
+            {
+                task.wait();
+            }
+
+            TaskPool::Statistics statistics = taskPool.statistics();
+            CHECK_EQUAL((size_t)threadCount + 1, statistics.threads.size());
+
+            uint64_t executedTaskCount = 0;
+            bool timesValid = true;
+            for (TaskPool::ThreadStatistics& threadStatistics : statistics.threads)
+            {
+                executedTaskCount += threadStatistics.executedTaskCount;
+                timesValid = timesValid && threadStatistics.busyTime.microseconds() >= 0;
+                timesValid = timesValid && threadStatistics.totalQueueLatency.microseconds() >= threadStatistics.maximumQueueLatency.microseconds();
+            }
+            CHECK_EQUAL((uint64_t)taskCount, executedTaskCount);
+            CHECK(timesValid);
+
+            uint64_t queuedTaskCount = 0;
+            for (uint64_t count : statistics.queueDepthHistogram)
+            {
+                queuedTaskCount += count;
+            }
+            // Tasks only pass through a queue when the pool has threads
+            CHECK_EQUAL(threadCount > 0 ? (uint64_t)taskCount : 0, queuedTaskCount);
+
+            taskPool.resetStatistics();
+            statistics = taskPool.statistics();
+
+            executedTaskCount = 0;
+            for (TaskPool::ThreadStatistics& threadStatistics : statistics.threads)
+            {
+                executedTaskCount += threadStatistics.executedTaskCount;
+            }
+            CHECK_EQUAL((uint64_t)0, executedTaskCount);
+        }
+    }
+
+    TEST(WriteTrace)
+    {
+        TaskPool taskPool(2);
+        taskPool.startTrace(8);
+
+        std::vector<Task> tasks;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            tasks.push_back(taskPool.enqueue(shortTask));
+        }
+
+        for (Task& task : tasks)
+        {
+            task.wait();
+        }
+
+        taskPool.stopTrace();
+
+        std::vector<uint8_t> data;
+        MemoryWriteStream writeStream(data);
+        taskPool.writeTrace(writeStream);
+
+        DataValue trace;
+        MemoryReadStream readStream(data);
+        DataValueJsonFormat::load(trace, readStream);
+
+        // One thread name for each thread followed by the task events
+        const DataValue& events = trace["traceEvents"];
+        CHECK_EQUAL((size_t)3 + 4, events.size());
+
+        size_t taskEventCount = 0;
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            if (events[i]["ph"].asString() == "X")
+            {
+                ++taskEventCount;
+            }
+        }
+        CHECK_EQUAL((size_t)4, taskEventCount);
+    }
+
+    TEST(ParallelFor)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            std::vector<int> visitCounts(100000, 0);
+            taskPool.parallelFor(0, visitCounts.size(), 64, [&visitCounts](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    ++visitCounts[i];
+                }
+            });
+
+            CHECK(std::count(visitCounts.begin(), visitCounts.end(), 1) == (int)visitCounts.size());
+        }
+    }
+
+    TEST(ParallelForEmptyRange)
+    {
+        TaskPool taskPool(2);
+
+        bool called = false;
+        taskPool.parallelFor(10, 10, 1, [&called](size_t begin, size_t end)
+        {
+            begin;
+            end;
+            called = true;
+        });
+        CHECK(!called);
+    }
+
+    TEST(ParallelForWithErrors)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            CHECK_THROW(taskPool.parallelFor(0, 1000, 1, [](size_t begin, size_t end)
+            {
+                if (begin <= 500 && 500 < end)
+                {
+                    throw Error("Task error");
+                }
+            }), Error);
+        }
+    }
+
+    TEST(NestedParallelFor)
+    {
+        TaskPool taskPool(4);
+
+        std::atomic<unsigned> count(0);
+        taskPool.parallelFor(0, 16, 1, [&taskPool, &count](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                taskPool.parallelFor(0, 1000, 10, [&count](size_t innerBegin, size_t innerEnd)
+                {
+                    count += (unsigned)(innerEnd - innerBegin);
+                });
+            }
+        });
+
+        CHECK_EQUAL(16000u, (unsigned)count);
+    }
+
+    TEST(ParallelReduce)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            uint64_t sum = taskPool.parallelReduce(0, 100001, 100, (uint64_t)0, [](size_t begin, size_t end)
+            {
+                uint64_t sum = 0;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    sum += i;
+                }
+                return sum;
+            }, [](uint64_t a, uint64_t b)
+            {
+                return a + b;
+            });
+
+            CHECK_EQUAL((uint64_t)100000 * 100001 / 2, sum);
+        }
+    }
+
+    TEST(ParallelSort)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            std::vector<int> values;
+            uint32_t state = 12345;
+            for (unsigned i = 0; i < 50000; ++i)
+            {
+                state = state * 1664525 + 1013904223;
+                values.push_back((int)(state >> 8) - (1 << 23));
+            }
+
+            std::vector<int> expected(values);
+            std::sort(expected.begin(), expected.end());
+
+            taskPool.parallelSort(values.begin(), values.end());
+            CHECK(values == expected);
+        }
+    }
+
+    TEST(ParallelSortIsStable)
+    {
+        TaskPool taskPool(4);
+
+        std::vector<std::pair<unsigned, unsigned>> values;
+        for (unsigned i = 0; i < 20000; ++i)
+        {
+            values.push_back(std::make_pair((i * 7919) % 13, i));
+        }
+
+        std::vector<std::pair<unsigned, unsigned>> expected(values);
+        auto compare = [](const std::pair<unsigned, unsigned>& a, const std::pair<unsigned, unsigned>& b)
+        {
+            return a.first < b.first;
+        };
+        std::stable_sort(expected.begin(), expected.end(), compare);
+
+        taskPool.parallelSort(values.begin(), values.end(), compare);
+        CHECK(values == expected);
+    }
+
+    TEST(ParallelSortByKey)
+    {
+        for (unsigned threadCount = 0; threadCount < maxThreadCount; ++threadCount)
+        {
+            TaskPool taskPool(threadCount);
+
+            std::vector<std::pair<uint32_t, unsigned>> values;
+            uint32_t state = 54321;
+            for (unsigned i = 0; i < 100000; ++i)
+            {
+                state = state * 1664525 + 1013904223;
+                values.push_back(std::make_pair(state & 0x00ff00ff, i));
+            }
+
+            std::vector<std::pair<uint32_t, unsigned>> expected(values);
+            std::stable_sort(expected.begin(), expected.end(), [](const std::pair<uint32_t, unsigned>& a, const std::pair<uint32_t, unsigned>& b)
+            {
+                return a.first < b.first;
+            });
+
+            taskPool.parallelSortByKey(values, [](const std::pair<uint32_t, unsigned>& value)
+            {
+                return value.first;
+            });
+            CHECK(values == expected);
+        }
+    }
+}
+
+SUITE(WorkStealingQueue)
+{
+    TEST(PopIsLastInFirstOut)
+    {
+        WorkStealingQueue<int*> queue(2);
+
+        int values[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            queue.push(&values[i]);
+        }
+
+        int* value = nullptr;
+        for (int i = 3; i >= 0; --i)
+        {
+            CHECK(queue.pop(value));
+            CHECK_EQUAL(&values[i], value);
+        }
+
+        CHECK(!queue.pop(value));
+        CHECK(queue.empty());
+    }
+
+    TEST(StealIsFirstInFirstOut)
+    {
+        WorkStealingQueue<int*> queue(2);
+
+        int values[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            queue.push(&values[i]);
+        }
+
+        int* value = nullptr;
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.steal(value));
+            CHECK_EQUAL(&values[i], value);
+        }
+
+        CHECK(!queue.steal(value));
+    }
+
+    TEST(ConcurrentStealing)
+    {
+        const size_t itemCount = 100000;
+
+        WorkStealingQueue<size_t*> queue;
+        std::vector<size_t> items(itemCount);
+        std::vector<std::atomic<unsigned>> takenCounts(itemCount);
+        for (size_t i = 0; i < itemCount; ++i)
+        {
+            items[i] = i;
+            takenCounts[i] = 0;
+        }
+
+        std::atomic<bool> pushing(true);
+        std::vector<std::thread> thieves;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            thieves.push_back(std::thread([&]
+            {
+                size_t* item;
+                while (pushing || !queue.empty())
+                {
+                    if (queue.steal(item))
+                    {
+                        ++takenCounts[*item];
+                    }
+                }
+            }));
+        }
+
+        // Push every item while popping some of them
+        size_t* item;
+        for (size_t i = 0; i < itemCount; ++i)
+        {
+            queue.push(&items[i]);
+            if (i % 3 == 0 && queue.pop(item))
+            {
+                ++takenCounts[*item];
+            }
+        }
+        pushing = false;
+
+        for (std::thread& thief : thieves)
+        {
+            thief.join();
+        }
+
+        while (queue.pop(item))
+        {
+            ++takenCounts[*item];
+        }
+
+        // Every item is taken exactly once
+        bool allTakenOnce = true;
+        for (size_t i = 0; i < itemCount; ++i)
+        {
+            allTakenOnce = allTakenOnce && takenCounts[i] == 1;
+        }
+        CHECK(allTakenOnce);
+    }
 }
\ No newline at end of file
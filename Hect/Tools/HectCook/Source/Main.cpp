@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2014 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect.h"
+
+using namespace hect;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: HectCook <input directory> <output pack> [--compress]" << std::endl;
+        return 1;
+    }
+
+    Path inputDirectory(argv[1]);
+    Path outputPath(argv[2]);
+    bool compress = argc > 3 && std::string(argv[3]) == "--compress";
+
+    try
+    {
+        FileSystem fileSystem;
+        fileSystem.addDataSource(inputDirectory);
+        fileSystem.setWriteDirectory(fileSystem.workingDirectory());
+
+        PackFileWriter writer;
+        AssetCooker::Result result;
+
+        {
+            // Reuse what is still valid from the previous cook if there is one
+            std::unique_ptr<PackFile> previousPack;
+            try
+            {
+                previousPack.reset(new PackFile(fileSystem.workingDirectory() + outputPath));
+            }
+            catch (Error&)
+            {
+            }
+
+            TaskPool taskPool;
+            AssetCooker cooker(fileSystem, taskPool);
+            result = cooker.cook(Path(), writer, previousPack.get(), compress);
+        }
+
+        for (const std::string& error : result.errors)
+        {
+            std::cerr << error << std::endl;
+        }
+
+        {
+            FileWriteStream stream = fileSystem.openFileForWrite(outputPath);
+            writer.save(stream);
+        }
+
+        std::cout << format("Cooked %d, copied %d, and reused %d files into '%s'", (int)result.cookedCount, (int)result.copiedCount, (int)result.reusedCount, outputPath.toString().c_str()) << std::endl;
+
+        if (!result.errors.empty())
+        {
+            return 1;
+        }
+    }
+    catch (Error& error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "PointCloud.h"
 
-PointCloud::PointCloud(unsigned seed, unsigned pointCount, const AxisAlignedBox<>& area, const DensitySampler& sampler, unsigned channel)
+PointCloud::PointCloud(TaskPool& taskPool, unsigned seed, unsigned pointCount, const AxisAlignedBox<>& area, const DensitySampler& sampler, unsigned channel)
 {
     VertexAttribute::Array attributes;
     attributes.reserve(4);
@@ -12,34 +12,58 @@ PointCloud::PointCloud(unsigned seed, unsigned pointCount, const AxisAlignedBox<
 
     _mesh = Mesh::Ref(new Mesh(vertexLayout, Mesh::Points, Mesh::UnsignedInt));
 
-    MeshBuilder builder(*_mesh);
-
-    Random random(seed);
-
     const Vector3<>& minimum = area.minimum();
     const Vector3<>& maximum = area.maximum();
 
-    unsigned index = 0;
-    for (unsigned i = 0; i < pointCount; ++i)
+    // Sample the candidate points in fixed-size blocks, each with its own
+    // generator, so the cloud is the same regardless of the thread count
+    const unsigned blockSize = 4096;
+    unsigned blockCount = (pointCount + blockSize - 1) / blockSize;
+    std::vector<std::vector<Point>> blocks(blockCount);
+
+    taskPool.parallelFor(0, blockCount, 1, [&](size_t blockBegin, size_t blockEnd)
     {
-        Vector3<> position;
-        position.x = random.nextDouble(minimum.x, maximum.x);
-        position.y = random.nextDouble(minimum.y, maximum.y);
-        position.z = random.nextDouble(minimum.z, maximum.z);
-
-        double d = sampler.density(position, channel);
-        double p = random.nextDouble(0, 1);
-        if (p > d)
+        for (size_t block = blockBegin; block < blockEnd; ++block)
         {
-            continue;
+            Random random(seed + (unsigned)block * 7919);
+
+            unsigned candidateCount = std::min(blockSize, pointCount - (unsigned)block * blockSize);
+            for (unsigned i = 0; i < candidateCount; ++i)
+            {
+                Point point;
+                point.position.x = random.nextDouble(minimum.x, maximum.x);
+                point.position.y = random.nextDouble(minimum.y, maximum.y);
+                point.position.z = random.nextDouble(minimum.z, maximum.z);
+
+                double d = sampler.density(point.position, channel);
+                double p = random.nextDouble(0, 1);
+                if (p > d)
+                {
+                    continue;
+                }
+
+                point.weight0 = random.nextFloat(0, 1);
+                point.weight1 = random.nextFloat(0, 1);
+                point.weight2 = random.nextFloat(0, 1);
+                blocks[block].push_back(point);
+            }
         }
+    });
+
+    MeshBuilder builder(*_mesh);
 
-        builder.addVertex();
-        builder.setAttributeData(VertexAttribute::Position, position);
-        builder.setAttributeData(VertexAttribute::Weight0, random.nextFloat(0, 1));
-        builder.setAttributeData(VertexAttribute::Weight1, random.nextFloat(0, 1));
-        builder.setAttributeData(VertexAttribute::Weight2, random.nextFloat(0, 1));
-        builder.addIndex(index++);
+    unsigned index = 0;
+    for (const std::vector<Point>& points : blocks)
+    {
+        for (const Point& point : points)
+        {
+            builder.addVertex();
+            builder.setAttributeData(VertexAttribute::Position, point.position);
+            builder.setAttributeData(VertexAttribute::Weight0, point.weight0);
+            builder.setAttributeData(VertexAttribute::Weight1, point.weight1);
+            builder.setAttributeData(VertexAttribute::Weight2, point.weight2);
+            builder.addIndex(index++);
+        }
     }
 }
 
@@ -8,10 +8,18 @@ using namespace hect;
 class PointCloud
 {
 public:
-    PointCloud(unsigned seed, unsigned pointCount, const AxisAlignedBox<>& area, const DensitySampler& sampler, unsigned channel);
+    PointCloud(TaskPool& taskPool, unsigned seed, unsigned pointCount, const AxisAlignedBox<>& area, const DensitySampler& sampler, unsigned channel);
 
     const Mesh::Ref& mesh() const;
 
 private:
+    struct Point
+    {
+        Vector3<> position;
+        float weight0;
+        float weight1;
+        float weight2;
+    };
+
     Mesh::Ref _mesh;
 };
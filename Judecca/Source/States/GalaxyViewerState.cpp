@@ -51,6 +51,9 @@ void GalaxyViewerState::_createGalaxy()
     Image::Ref cloudDensitySide = assetCache().get<Image>("Textures/CloudDensitySide.png");
     DensitySampler sampler(area, cloudDensityTop, cloudDensitySide);
 
+    // Generate the point clouds on all available cores
+    TaskPool taskPool;
+
     // Dust
     {
         Material::Ref material = assetCache().get<Material>("Materials/Dust.material");
@@ -59,7 +62,7 @@ void GalaxyViewerState::_createGalaxy()
         Transform& transform = dust.addComponent<Transform>();
         Geometry& geometry = dust.addComponent<Geometry>(transform);
 
-        PointCloud pointCloud(123, 800000, area, sampler, 0);
+        PointCloud pointCloud(taskPool, 123, 800000, area, sampler, 0);
         geometry.addMesh(pointCloud.mesh(), material);
 
         dust.activate();
@@ -73,7 +76,7 @@ void GalaxyViewerState::_createGalaxy()
         Transform& transform = dark.addComponent<Transform>();
         Geometry& geometry = dark.addComponent<Geometry>(transform);
 
-        PointCloud pointCloud(321, 300000, area, sampler, 1);
+        PointCloud pointCloud(taskPool, 321, 300000, area, sampler, 1);
         geometry.addMesh(pointCloud.mesh(), material);
 
         dark.activate();
@@ -87,7 +90,7 @@ void GalaxyViewerState::_createGalaxy()
         Transform& transform = center.addComponent<Transform>();
         Geometry& geometry = center.addComponent<Geometry>(transform);
 
-        PointCloud pointCloud(123, 24000, area, sampler, 2);
+        PointCloud pointCloud(taskPool, 123, 24000, area, sampler, 2);
         geometry.addMesh(pointCloud.mesh(), material);
 
         center.activate();
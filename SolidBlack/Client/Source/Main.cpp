@@ -52,8 +52,40 @@ int main()
         // Create input system
         InputSystem inputSystem(axes);
 
-        // Create asset cache
-        AssetCache assetCache(fileSystem);
+        // Create asset cache which loads assets asynchronously in a task pool
+        TaskPool taskPool;
+        AssetCache assetCache(fileSystem, taskPool);
+        assetCache.registerAssetType<Mesh>("Mesh");
+        assetCache.registerAssetType<Material>("Material");
+        assetCache.registerAssetType<Shader>("Shader");
+        assetCache.registerAssetType<ShaderModule>("ShaderModule");
+        assetCache.registerAssetType<Texture>("Texture");
+        assetCache.registerAssetType<Image>("Image");
+
+        // Reload the assets changed on disk if enabled in the settings
+        bool hotReloadAssets = settings["hotReloadAssets"].asBool();
+        assetCache.setHotReloadEnabled(hotReloadAssets);
+        Timer hotReloadTimer;
+
+        // Prefetch the assets recorded during the last run
+        const Path manifestPath("StartupManifest.json");
+        if (fileSystem.exists(manifestPath))
+        {
+            AssetManifest manifest;
+            FileReadStream stream = fileSystem.openFileForRead(manifestPath);
+            manifest.load(stream);
+            assetCache.prefetch(manifest);
+        }
+
+        // Record the assets loaded during this run
+        assetCache.startRecording();
+
+        // Profile the asset loads if enabled in the settings
+        bool profileAssetLoads = settings["profileAssetLoads"].asBool();
+        if (profileAssetLoads)
+        {
+            assetCache.startProfiling();
+        }
 
         // Server logic flow
         LogicFlow serverLogicFlow(TimeSpan::fromSeconds(1.0 / 60.0));
@@ -76,6 +108,37 @@ int main()
             {
                 break;
             }
+
+            // Finish loading assets which were loaded asynchronously
+            assetCache.finalizeLoads(TimeSpan::fromMilliseconds(2));
+
+            // Check for changed assets about once a second
+            if (hotReloadAssets && hotReloadTimer.elapsed().seconds() >= 1.0)
+            {
+                assetCache.reloadChanged();
+                hotReloadTimer.reset();
+            }
+        }
+
+        // Save the recorded assets to prefetch on the next run
+        {
+            AssetManifest manifest = assetCache.stopRecording();
+            FileWriteStream stream = fileSystem.openFileForWrite(manifestPath);
+            manifest.save(stream);
+        }
+
+        // Save the report of the asset loads and the stacks for a flame graph
+        if (profileAssetLoads)
+        {
+            AssetLoadProfile profile = assetCache.stopProfiling();
+            {
+                FileWriteStream stream = fileSystem.openFileForWrite("AssetLoadProfile.json");
+                profile.save(stream);
+            }
+            {
+                FileWriteStream stream = fileSystem.openFileForWrite("AssetLoadProfile.folded");
+                profile.saveFoldedStacks(stream);
+            }
         }
     }
     catch (Error& error)
@@ -62,6 +62,8 @@ void ClientLogicLayer::fixedUpdate(double timeStep)
         }
     }
 
+    _handlePendingPackets();
+
     _cameraSystem.update();
     _debugCameraSystem.update(timeStep);
     _physicsSystem.update(timeStep, 1);
@@ -89,10 +91,46 @@ void ClientLogicLayer::frameUpdate(double delta)
 
 void ClientLogicLayer::_receivePacketEvent(SocketEvent& event)
 {
+    PendingPacket pendingPacket;
+    pendingPacket.packet = event.packet;
+
     PacketReadStream stream = event.packet.readStream();
+    pendingPacket.type = (PacketType)stream.readByte();
+    if (pendingPacket.type == PacketType::CreateEntity)
+    {
+        // Begin loading the entity data while the packets before it are
+        // handled
+        stream.readUnsignedInt();
+        std::string entityPath = stream.readString();
+        pendingPacket.entityValue = _assetCache->loadAsync<DataValue>(entityPath);
+    }
+
+    _pendingPackets.push(pendingPacket);
+}
+
+void ClientLogicLayer::_handlePendingPackets()
+{
+    // Handle the packets in the order they were received, so a packet
+    // referring to an entity is never handled before the entity is created
+    while (!_pendingPackets.empty())
+    {
+        const PendingPacket& pendingPacket = _pendingPackets.front();
+        if (pendingPacket.type == PacketType::CreateEntity && !pendingPacket.entityValue.isReady())
+        {
+            break;
+        }
 
-    uint8_t packetType = stream.readByte();
-    switch (packetType)
+        _handlePacket(pendingPacket);
+        _pendingPackets.pop();
+    }
+}
+
+void ClientLogicLayer::_handlePacket(const PendingPacket& pendingPacket)
+{
+    PacketReadStream stream = pendingPacket.packet.readStream();
+    stream.readByte();
+
+    switch (pendingPacket.type)
     {
     case PacketType::AuthorizationRequest:
         _sendAuthorization();
@@ -102,11 +140,8 @@ void ClientLogicLayer::_receivePacketEvent(SocketEvent& event)
             Entity::Id id = (Entity::Id)stream.readUnsignedInt();
             LOG_TRACE(format("Client: Creating entity with id '%d'", id));
 
-            std::string entityPath = stream.readString();
-            DataValue::Ref entityValue = _assetCache->get<DataValue>(entityPath);
-
             Entity entity = _scene.createEntity();
-            entity.load(*entityValue, *_assetCache);
+            entity.load(pendingPacket.entityValue.get(), *_assetCache);
             entity.activate();
         } break;
     }
@@ -15,7 +15,22 @@ public:
     void receiveEvent(const KeyboardEvent& event);
 
 private:
+
+    // A received packet waiting for the packets received before it to be
+    // handled
+    struct PendingPacket
+    {
+        PacketType type;
+        Packet packet;
+
+        // The data of the entity to create (if the packet creates an
+        // entity)
+        AssetHandle<DataValue> entityValue;
+    };
+
     void _receivePacketEvent(SocketEvent& event);
+    void _handlePendingPackets();
+    void _handlePacket(const PendingPacket& pendingPacket);
     void _sendAuthorization();
 
     Socket _socket;
@@ -31,4 +46,6 @@ private:
     PhysicsSystem _physicsSystem;
 
     Scene _scene;
+
+    std::queue<PendingPacket> _pendingPackets;
 };
\ No newline at end of file